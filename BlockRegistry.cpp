@@ -0,0 +1,93 @@
+// Includes the corresponding header file to access the BlockRegistry class declaration
+#include "BlockRegistry.h"
+
+// Includes standard I/O for printing error messages to the console
+#include <iostream>
+
+/** The number of distinct BlockID values, which the lookup tables cover */
+static const size_t BLOCK_ID_COUNT = size_t(1) << (sizeof(BlockID) * 8);
+
+/** Every face uses the same texture */
+BlockTextures BlockTextures::single(uint16_t layer) {
+    BlockTextures textures = {};
+    for (int face = 0; face < FACE_COUNT; ++face) {
+        textures.layers[face] = layer;
+    }
+    return textures;
+}
+
+/** The top and bottom have their own textures; the four sides share one */
+BlockTextures BlockTextures::topSide(uint16_t top, uint16_t side, uint16_t bottom) {
+    BlockTextures textures = single(side);
+    textures.layers[FACE_POS_Y] = top;
+    textures.layers[FACE_NEG_Y] = bottom;
+    return textures;
+}
+
+/** Every face has its own texture, in `BlockFace` order */
+BlockTextures BlockTextures::perFace(const uint16_t (&faceLayers)[FACE_COUNT]) {
+    BlockTextures textures = {};
+    for (int face = 0; face < FACE_COUNT; ++face) {
+        textures.layers[face] = faceLayers[face];
+    }
+    return textures;
+}
+
+/** Returns a copy with every face's texture turned by `quarterTurns` */
+BlockTextures BlockTextures::rotated(int quarterTurns) const {
+    BlockTextures textures = *this;
+    for (int face = 0; face < FACE_COUNT; ++face) {
+        textures.rotations[face] = uint8_t((rotations[face] + quarterTurns % 4 + 4) % 4);
+    }
+    return textures;
+}
+
+/**
+ * Constructor: Creates a registry holding only air (ID 0).
+ */
+BlockRegistry::BlockRegistry()
+    : faceTextures(BLOCK_ID_COUNT * FACE_COUNT, 0), opaque(BLOCK_ID_COUNT, 1) {
+    names.push_back("air");
+    ids["air"] = BLOCK_AIR;
+    opaque[BLOCK_AIR] = 0;
+}
+
+/**
+ * Adds a block type.
+ *
+ * @param name     A unique name, such as "stone".
+ * @param textures The texture layer and rotation of each face.
+ * @param opaque   False for blocks that faces behind them show through (glass, leaves).
+ * @return The new block's ID, or BLOCK_AIR if the name is taken or the registry is full.
+ */
+BlockID BlockRegistry::registerBlock(const std::string& name, const BlockTextures& textures, bool opaque) {
+    if (ids.count(name) > 0 || names.size() >= BLOCK_ID_COUNT) {
+        std::cout << "ERROR::BLOCK_REGISTRY::CANNOT_REGISTER " << name << std::endl;
+        return BLOCK_AIR;
+    }
+
+    BlockID id = BlockID(names.size());
+    names.push_back(name);
+    ids[name] = id;
+    this->opaque[id] = opaque ? 1 : 0;
+
+    // Pack each face's layer and rotation into the mesher's lookup table
+    for (int face = 0; face < FACE_COUNT; ++face) {
+        uint16_t layer = textures.layers[face];
+        if (layer > MAX_TEXTURE_LAYER) {
+            std::cout << "ERROR::BLOCK_REGISTRY::TEXTURE_LAYER_OUT_OF_RANGE " << name << " " << layer << std::endl;
+            layer = 0;
+        }
+        faceTextures[size_t(id) * FACE_COUNT + face] = uint16_t(layer | (textures.rotations[face] & 3) << LAYER_BITS);
+    }
+
+    return id;
+}
+
+/**
+ * Returns the ID of a block type by name, or BLOCK_AIR if there is none.
+ */
+BlockID BlockRegistry::find(const std::string& name) const {
+    auto found = ids.find(name);
+    return found != ids.end() ? found->second : BLOCK_AIR;
+}
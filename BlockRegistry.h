@@ -0,0 +1,120 @@
+// Prevents multiple inclusions of this header file, which can cause redefinition errors
+#ifndef BLOCK_REGISTRY_H
+#define BLOCK_REGISTRY_H
+
+// Includes fixed-width integer types such as uint16_t
+#include <cstdint>
+
+// Includes the C++ Standard Library string class, used for block names
+#include <string>
+
+// Includes the hash map used to look up blocks by name
+#include <unordered_map>
+
+// Includes the vector container used for the lookup tables
+#include <vector>
+
+#include "Chunk.h" // The BlockID type
+
+/** The six faces of a block, in the order used by every per-face table */
+enum BlockFace {
+    FACE_POS_X,
+    FACE_NEG_X,
+    FACE_POS_Y,
+    FACE_NEG_Y,
+    FACE_POS_Z,
+    FACE_NEG_Z,
+    FACE_COUNT
+};
+
+/**
+ * The `BlockTextures` struct describes how a block type is textured: one
+ * texture array layer and one quarter-turn rotation per face.
+ * The static helpers build the common texture types.
+ */
+struct BlockTextures {
+    /** The texture array layer of each face */
+    uint16_t layers[FACE_COUNT];
+
+    /** The number of 90 degree turns applied to each face's texture (0-3) */
+    uint8_t rotations[FACE_COUNT];
+
+    /** Every face uses the same texture */
+    static BlockTextures single(uint16_t layer);
+
+    /** The top and bottom have their own textures; the four sides share one */
+    static BlockTextures topSide(uint16_t top, uint16_t side, uint16_t bottom);
+
+    /** Every face has its own texture, in `BlockFace` order */
+    static BlockTextures perFace(const uint16_t (&faceLayers)[FACE_COUNT]);
+
+    /** Returns a copy with every face's texture turned by `quarterTurns` */
+    BlockTextures rotated(int quarterTurns) const;
+};
+
+/**
+ * The `BlockRegistry` class defines the block types of the game.
+ *
+ * Properties the mesher needs per face are flattened into lookup tables that
+ * cover every possible BlockID, so meshing does one array read per face with
+ * no bounds checks or branches on texture type. IDs that were never registered
+ * are opaque and use texture layer 0.
+ */
+class BlockRegistry {
+public:
+    /** The number of bits of a packed texture state holding the texture layer */
+    static constexpr int LAYER_BITS = 10;
+
+    /** The highest texture layer a face can use */
+    static constexpr uint16_t MAX_TEXTURE_LAYER = (1 << LAYER_BITS) - 1;
+
+    /**
+     * Constructor: Creates a registry holding only air (ID 0).
+     */
+    BlockRegistry();
+
+    /**
+     * Adds a block type.
+     *
+     * @param name     A unique name, such as "stone".
+     * @param textures The texture layer and rotation of each face.
+     * @param opaque   False for blocks that faces behind them show through (glass, leaves).
+     * @return The new block's ID, or BLOCK_AIR if the name is taken or the registry is full.
+     */
+    BlockID registerBlock(const std::string& name, const BlockTextures& textures, bool opaque = true);
+
+    /**
+     * Returns the ID of a block type by name, or BLOCK_AIR if there is none.
+     */
+    BlockID find(const std::string& name) const;
+
+    /** Returns the name of a registered block type */
+    const std::string& getName(BlockID block) const { return names[block]; }
+
+    /** Returns the number of registered block types, including air */
+    size_t getCount() const { return names.size(); }
+
+    /**
+     * Returns the packed texture state of a face: the layer in the low
+     * LAYER_BITS bits, the rotation in the two bits above.
+     */
+    uint16_t getFaceTexture(BlockID block, int face) const { return faceTextures[size_t(block) * FACE_COUNT + face]; }
+
+    /** Returns true if a block hides the faces of blocks behind it */
+    bool isOpaque(BlockID block) const { return opaque[block] != 0; }
+
+private:
+    /** The name of each registered block, indexed by ID */
+    std::vector<std::string> names;
+
+    /** Registered names mapped to block IDs */
+    std::unordered_map<std::string, BlockID> ids;
+
+    /** The packed texture state of every face of every possible BlockID */
+    std::vector<uint16_t> faceTextures;
+
+    /** 1 for every possible BlockID that is opaque */
+    std::vector<uint8_t> opaque;
+};
+
+#endif  // Ends the conditional inclusion directive
@@ -0,0 +1,306 @@
+// Includes the corresponding header file to access the BlockVolume class declaration
+#include "BlockVolume.h"
+
+// Includes std::reverse and std::swap_ranges, used for scalar tails and whole-row swaps
+#include <algorithm>
+
+// Includes std::memcpy, used to copy whole rows
+#include <cstring>
+
+// SSE2 is part of every x86-64 CPU, so the vector kernels need no build option
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BLOCK_VOLUME_USE_SSE2 1
+#endif
+
+#ifdef BLOCK_VOLUME_USE_SSE2
+/**
+ * Reverses the order of the eight 16-bit lanes of a vector.
+ */
+static inline __m128i reverseLanes(__m128i v) {
+    v = _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+    v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+    return _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+}
+
+/**
+ * Transposes one 8x8 tile of 16-bit blocks in registers.
+ */
+static inline void transposeTile(const BlockID* src, size_t srcStride, BlockID* dst, size_t dstStride) {
+    __m128i r[8];
+    for (int i = 0; i < 8; ++i) {
+        r[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * srcStride));
+    }
+
+    // Interleave 16-bit, then 32-bit, then 64-bit lanes of row pairs
+    __m128i a0 = _mm_unpacklo_epi16(r[0], r[1]), a1 = _mm_unpackhi_epi16(r[0], r[1]);
+    __m128i a2 = _mm_unpacklo_epi16(r[2], r[3]), a3 = _mm_unpackhi_epi16(r[2], r[3]);
+    __m128i a4 = _mm_unpacklo_epi16(r[4], r[5]), a5 = _mm_unpackhi_epi16(r[4], r[5]);
+    __m128i a6 = _mm_unpacklo_epi16(r[6], r[7]), a7 = _mm_unpackhi_epi16(r[6], r[7]);
+
+    __m128i b0 = _mm_unpacklo_epi32(a0, a2), b1 = _mm_unpackhi_epi32(a0, a2);
+    __m128i b2 = _mm_unpacklo_epi32(a1, a3), b3 = _mm_unpackhi_epi32(a1, a3);
+    __m128i b4 = _mm_unpacklo_epi32(a4, a6), b5 = _mm_unpackhi_epi32(a4, a6);
+    __m128i b6 = _mm_unpacklo_epi32(a5, a7), b7 = _mm_unpackhi_epi32(a5, a7);
+
+    __m128i out[8] = {
+        _mm_unpacklo_epi64(b0, b4), _mm_unpackhi_epi64(b0, b4),
+        _mm_unpacklo_epi64(b1, b5), _mm_unpackhi_epi64(b1, b5),
+        _mm_unpacklo_epi64(b2, b6), _mm_unpackhi_epi64(b2, b6),
+        _mm_unpacklo_epi64(b3, b7), _mm_unpackhi_epi64(b3, b7)
+    };
+    for (int i = 0; i < 8; ++i) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * dstStride), out[i]);
+    }
+}
+#endif
+
+/**
+ * Transposes a rows x cols matrix of blocks: dst[c][r] = src[r][c].
+ */
+static void transpose2D(const BlockID* src, size_t srcStride, BlockID* dst, size_t dstStride, int rows, int cols) {
+    int r = 0;
+#ifdef BLOCK_VOLUME_USE_SSE2
+    // Whole 8x8 tiles in registers
+    for (; r + 8 <= rows; r += 8) {
+        int c = 0;
+        for (; c + 8 <= cols; c += 8) {
+            transposeTile(src + r * srcStride + c, srcStride, dst + c * dstStride + r, dstStride);
+        }
+        for (; c < cols; ++c) {
+            for (int i = 0; i < 8; ++i) {
+                dst[c * dstStride + r + i] = src[(r + i) * srcStride + c];
+            }
+        }
+    }
+#endif
+    // Leftover rows (or everything, without SSE2)
+    for (; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            dst[c * dstStride + r] = src[r * srcStride + c];
+        }
+    }
+}
+
+/**
+ * Reverses a row of blocks in place.
+ */
+static void reverseRow(BlockID* row, int length) {
+    int left = 0;
+    int right = length;
+#ifdef BLOCK_VOLUME_USE_SSE2
+    // Swap reversed 8-block groups from both ends until they meet
+    while (right - left >= 16) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + left));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + right - 8));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(row + left), reverseLanes(b));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(row + right - 8), reverseLanes(a));
+        left += 8;
+        right -= 8;
+    }
+#endif
+    std::reverse(row + left, row + right);
+}
+
+/**
+ * Constructor: Creates an empty 0x0x0 volume.
+ */
+BlockVolume::BlockVolume() : size(0) {}
+
+/**
+ * Constructor: Creates a volume filled with a single block.
+ *
+ * @param size The size of the volume, in blocks.
+ * @param fill The block every position starts as.
+ */
+BlockVolume::BlockVolume(const glm::ivec3& size, BlockID fill)
+    : size(glm::max(size, glm::ivec3(0))), blocks(size_t(this->size.x) * this->size.y * this->size.z, fill) {}
+
+/**
+ * Mirrors the volume in place along an axis.
+ *
+ * @param axis The axis whose coordinates are reversed.
+ */
+void BlockVolume::mirror(Axis axis) {
+    size_t row = size_t(size.x);
+    size_t layer = row * size.z;
+
+    switch (axis) {
+    case AXIS_X:
+        // Reverse every row
+        for (size_t offset = 0; offset < blocks.size(); offset += row) {
+            reverseRow(&blocks[offset], size.x);
+        }
+        break;
+    case AXIS_Y:
+        // Swap whole layers from the top and bottom
+        for (int y = 0; y < size.y / 2; ++y) {
+            BlockID* low = &blocks[y * layer];
+            std::swap_ranges(low, low + layer, &blocks[(size.y - 1 - y) * layer]);
+        }
+        break;
+    case AXIS_Z:
+        // Swap rows from the front and back of each layer
+        for (int y = 0; y < size.y; ++y) {
+            for (int z = 0; z < size.z / 2; ++z) {
+                BlockID* front = &blocks[index(0, y, z)];
+                std::swap_ranges(front, front + row, &blocks[index(0, y, size.z - 1 - z)]);
+            }
+        }
+        break;
+    }
+}
+
+/**
+ * Returns a copy of the volume rotated around an axis.
+ *
+ * @param axis         The axis to rotate around.
+ * @param quarterTurns The number of 90 degree turns (any integer, including negative).
+ */
+BlockVolume BlockVolume::rotated(Axis axis, int quarterTurns) const {
+    BlockVolume result;
+    rotate(axis, quarterTurns, result);
+    return result;
+}
+
+/**
+ * Writes a rotated copy of the volume into `result`, reusing its storage.
+ *
+ * @param axis         The axis to rotate around.
+ * @param quarterTurns The number of 90 degree turns (any integer, including negative).
+ * @param result       Receives the rotated volume; must not be this volume.
+ */
+void BlockVolume::rotate(Axis axis, int quarterTurns, BlockVolume& result) const {
+    int turns = ((quarterTurns % 4) + 4) % 4;
+
+    // The two axes in the plane of rotation
+    Axis first = axis == AXIS_X ? AXIS_Y : AXIS_X;
+    Axis second = axis == AXIS_Z ? AXIS_Y : AXIS_Z;
+
+    if (turns == 0 || turns == 2) {
+        result.size = size;
+        result.blocks.assign(blocks.begin(), blocks.end());
+
+        // Half a turn negates both in-plane axes
+        if (turns == 2) {
+            result.mirror(first);
+            result.mirror(second);
+        }
+        return;
+    }
+
+    // A quarter turn is a transpose of the plane followed by one mirror:
+    // Y maps (x, z) -> (z, -x), X maps (y, z) -> (-z, y), Z maps (x, y) -> (-y, x)
+    swapAxes(first, second, result);
+    bool mirrorFirst = (axis == AXIS_Y) != (turns == 1);
+    result.mirror(mirrorFirst ? first : second);
+}
+
+/**
+ * Replaces every block ID through a lookup table. IDs past the end of the table are left unchanged.
+ *
+ * @param lut     The new ID for each old ID.
+ * @param lutSize The number of entries in `lut`.
+ */
+void BlockVolume::remap(const BlockID* lut, size_t lutSize) {
+    BlockID* data = blocks.data();
+    size_t count = blocks.size();
+    size_t i = 0;
+
+#ifdef BLOCK_VOLUME_USE_SSE2
+    // Builds are mostly long runs of one block, so groups of 8 identical IDs
+    // are remapped with a single lookup and one store
+    for (; i + 8 <= count; i += 8) {
+        __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        BlockID first = data[i];
+        __m128i same = _mm_cmpeq_epi16(group, _mm_set1_epi16(short(first)));
+        if (_mm_movemask_epi8(same) == 0xffff) {
+            if (first < lutSize) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i), _mm_set1_epi16(short(lut[first])));
+            }
+            continue;
+        }
+
+        for (size_t j = i; j < i + 8; ++j) {
+            if (data[j] < lutSize) {
+                data[j] = lut[data[j]];
+            }
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        if (data[i] < lutSize) {
+            data[i] = lut[data[i]];
+        }
+    }
+}
+
+/**
+ * Copies a box of blocks between two arrays with the `Chunk` layout.
+ *
+ * @param src     The source block array.
+ * @param srcSize The size of the source array, in blocks.
+ * @param srcMin  The first corner of the box in the source.
+ * @param dst     The destination block array.
+ * @param dstSize The size of the destination array, in blocks.
+ * @param dstMin  The first corner of the box in the destination.
+ * @param extent  The size of the box, in blocks.
+ */
+void BlockVolume::copyRegion(const BlockID* src, const glm::ivec3& srcSize, const glm::ivec3& srcMin,
+                             BlockID* dst, const glm::ivec3& dstSize, const glm::ivec3& dstMin,
+                             const glm::ivec3& extent) {
+    if (extent.x <= 0 || extent.y <= 0 || extent.z <= 0) {
+        return;
+    }
+
+    // X is contiguous in both arrays, so the box is copied one row at a time
+    size_t rowBytes = size_t(extent.x) * sizeof(BlockID);
+    for (int y = 0; y < extent.y; ++y) {
+        for (int z = 0; z < extent.z; ++z) {
+            size_t from = (size_t(srcMin.y + y) * srcSize.z + srcMin.z + z) * srcSize.x + srcMin.x;
+            size_t to = (size_t(dstMin.y + y) * dstSize.z + dstMin.z + z) * dstSize.x + dstMin.x;
+            std::memcpy(dst + to, src + from, rowBytes);
+        }
+    }
+}
+
+/**
+ * Changes the size of the volume, keeping its storage when it is large enough.
+ */
+void BlockVolume::resize(const glm::ivec3& newSize) {
+    size = glm::max(newSize, glm::ivec3(0));
+    blocks.resize(size_t(size.x) * size.y * size.z);
+}
+
+/**
+ * Writes a copy with two axes swapped (a transpose) into `result`.
+ */
+void BlockVolume::swapAxes(Axis first, Axis second, BlockVolume& result) const {
+    glm::ivec3 swappedSize = size;
+    std::swap(swappedSize[first], swappedSize[second]);
+    result.resize(swappedSize);
+
+    const BlockID* src = blocks.data();
+    BlockID* dst = result.blocks.data();
+    size_t layer = size_t(size.x) * size.z;
+
+    if (first == AXIS_X && second == AXIS_Z) {
+        // Transpose each horizontal layer
+        for (int y = 0; y < size.y; ++y) {
+            transpose2D(src + y * layer, size.x, dst + y * layer, size.z, size.z, size.x);
+        }
+    } else if (first == AXIS_X && second == AXIS_Y) {
+        // Transpose each vertical X/Y slice
+        for (int z = 0; z < size.z; ++z) {
+            transpose2D(src + size_t(z) * size.x, layer, dst + size_t(z) * size.y,
+                        size_t(size.y) * size.z, size.y, size.x);
+        }
+    } else {
+        // Swapping Y and Z keeps rows intact, so they are moved whole
+        for (int y = 0; y < size.y; ++y) {
+            for (int z = 0; z < size.z; ++z) {
+                std::memcpy(dst + result.index(0, z, y), src + index(0, y, z), size.x * sizeof(BlockID));
+            }
+        }
+    }
+}
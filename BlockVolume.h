@@ -0,0 +1,140 @@
+// Prevents multiple inclusions of this header file, which can cause redefinition errors
+#ifndef BLOCK_VOLUME_H
+#define BLOCK_VOLUME_H
+
+// Includes size_t
+#include <cstddef>
+
+// Includes the vector container used for block storage
+#include <vector>
+
+#include <glm/glm.hpp> // GLM for integer vector types (glm::ivec3)
+
+#include "Chunk.h" // The BlockID type and chunk block layout
+
+/**
+ * The `BlockVolume` class stores an arbitrary box of blocks, such as a region
+ * copied to the clipboard or loaded from a schematic.
+ *
+ * Blocks use the same layout as `Chunk` (X fastest, then Z, then Y), so whole
+ * rows can be copied between volumes and chunks with `copyRegion`.
+ *
+ * Rotation and mirroring are built from two kernels: a tiled 2D transpose and
+ * an in-place row reversal. Both process 8 blocks per instruction with SSE2
+ * where available and fall back to scalar loops elsewhere.
+ */
+class BlockVolume {
+public:
+    /** The axes a volume can be mirrored along or rotated around */
+    enum Axis {
+        AXIS_X,
+        AXIS_Y,
+        AXIS_Z
+    };
+
+    /**
+     * Constructor: Creates an empty 0x0x0 volume.
+     */
+    BlockVolume();
+
+    /**
+     * Constructor: Creates a volume filled with a single block.
+     *
+     * @param size The size of the volume, in blocks.
+     * @param fill The block every position starts as.
+     */
+    BlockVolume(const glm::ivec3& size, BlockID fill = BLOCK_AIR);
+
+    /** Returns the size of the volume, in blocks */
+    const glm::ivec3& getSize() const { return size; }
+
+    /** Returns the block array, laid out like `Chunk::blocks` */
+    BlockID* getData() { return blocks.data(); }
+
+    /** Returns the block array, laid out like `Chunk::blocks` */
+    const BlockID* getData() const { return blocks.data(); }
+
+    /** Returns the number of blocks in the volume */
+    size_t getVolume() const { return blocks.size(); }
+
+    /** Converts a coordinate inside the volume to an index into the block array */
+    size_t index(int x, int y, int z) const { return (size_t(y) * size.z + z) * size.x + x; }
+
+    /** Returns the block at a coordinate inside the volume */
+    BlockID get(int x, int y, int z) const { return blocks[index(x, y, z)]; }
+
+    /** Replaces the block at a coordinate inside the volume */
+    void set(int x, int y, int z, BlockID block) { blocks[index(x, y, z)] = block; }
+
+    /**
+     * Mirrors the volume in place along an axis.
+     *
+     * @param axis The axis whose coordinates are reversed.
+     */
+    void mirror(Axis axis);
+
+    /**
+     * Returns a copy of the volume rotated around an axis. Positive turns are
+     * counterclockwise when looking down the axis towards the origin.
+     *
+     * @param axis         The axis to rotate around.
+     * @param quarterTurns The number of 90 degree turns (any integer, including negative).
+     */
+    BlockVolume rotated(Axis axis, int quarterTurns) const;
+
+    /**
+     * Writes a rotated copy of the volume into `result`, reusing its storage.
+     * Repeated rotations (such as turning a paste preview) then allocate nothing.
+     *
+     * @param axis         The axis to rotate around.
+     * @param quarterTurns The number of 90 degree turns (any integer, including negative).
+     * @param result       Receives the rotated volume; must not be this volume.
+     */
+    void rotate(Axis axis, int quarterTurns, BlockVolume& result) const;
+
+    /**
+     * Replaces every block ID through a lookup table, for example to convert a
+     * schematic's palette into the world's block IDs. IDs past the end of the
+     * table are left unchanged.
+     *
+     * @param lut     The new ID for each old ID.
+     * @param lutSize The number of entries in `lut`.
+     */
+    void remap(const BlockID* lut, size_t lutSize);
+
+    /**
+     * Copies a box of blocks between two arrays with the `Chunk` layout
+     * (for example from a volume into a chunk). The box must fit in both arrays.
+     *
+     * @param src     The source block array.
+     * @param srcSize The size of the source array, in blocks.
+     * @param srcMin  The first corner of the box in the source.
+     * @param dst     The destination block array.
+     * @param dstSize The size of the destination array, in blocks.
+     * @param dstMin  The first corner of the box in the destination.
+     * @param extent  The size of the box, in blocks.
+     */
+    static void copyRegion(const BlockID* src, const glm::ivec3& srcSize, const glm::ivec3& srcMin,
+                           BlockID* dst, const glm::ivec3& dstSize, const glm::ivec3& dstMin,
+                           const glm::ivec3& extent);
+
+private:
+    /**
+     * Changes the size of the volume, keeping its storage when it is large enough.
+     * The block contents are left unspecified.
+     */
+    void resize(const glm::ivec3& newSize);
+
+    /**
+     * Writes a copy with two axes swapped (a transpose) into `result`; `rotate` follows this with a mirror.
+     */
+    void swapAxes(Axis first, Axis second, BlockVolume& result) const;
+
+    /** The size of the volume, in blocks */
+    glm::ivec3 size;
+
+    /** The block IDs, indexed with `index` */
+    std::vector<BlockID> blocks;
+};
+
+#endif  // Ends the conditional inclusion directive
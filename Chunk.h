@@ -0,0 +1,50 @@
+// Prevents multiple inclusions of this header file, which can cause redefinition errors
+#ifndef CHUNK_H
+#define CHUNK_H
+
+// Includes fixed-width integer types such as uint16_t
+#include <cstdint>
+
+// Includes CHUNK_SIZE, the edge length of a chunk
+#include "WorldPosition.h"
+
+/** Identifies the type of a block; 0 is always air */
+using BlockID = uint16_t;
+
+/** The block ID reserved for empty space */
+constexpr BlockID BLOCK_AIR = 0;
+
+/** The number of blocks stored in a single chunk */
+constexpr int CHUNK_VOLUME = CHUNK_SIZE * CHUNK_SIZE * CHUNK_SIZE;
+
+/**
+ * The `Chunk` struct stores the blocks of one CHUNK_SIZE^3 cube of the world.
+ *
+ * Blocks are stored in a flat array with X varying fastest, then Z, then Y,
+ * so each horizontal layer is contiguous. Chunks are plain data with a fixed
+ * size, which lets `ChunkPool` recycle them and lets codecs decode straight
+ * into `blocks` without an intermediate buffer.
+ */
+struct Chunk {
+    /** The block IDs of the chunk, indexed with `Chunk::index` */
+    BlockID blocks[CHUNK_VOLUME];
+
+    /**
+     * Converts a block coordinate inside the chunk to an index into `blocks`.
+     *
+     * @param x The X coordinate, in [0, CHUNK_SIZE).
+     * @param y The Y coordinate, in [0, CHUNK_SIZE).
+     * @param z The Z coordinate, in [0, CHUNK_SIZE).
+     */
+    static int index(int x, int y, int z) {
+        return (y * CHUNK_SIZE + z) * CHUNK_SIZE + x;
+    }
+
+    /** Returns the block at a coordinate inside the chunk */
+    BlockID get(int x, int y, int z) const { return blocks[index(x, y, z)]; }
+
+    /** Replaces the block at a coordinate inside the chunk */
+    void set(int x, int y, int z, BlockID block) { blocks[index(x, y, z)] = block; }
+};
+
+#endif  // Ends the conditional inclusion directive
@@ -0,0 +1,144 @@
+// Includes the corresponding header file to access the ChunkCodec class declaration
+#include "ChunkCodec.h"
+
+// Includes standard I/O for printing error messages to the console
+#include <iostream>
+
+// Includes the LZ compressor used by FORMAT_LZ
+#include "LZCodec.h"
+
+/**
+ * Encodes a chunk, appending the payload to `out`.
+ *
+ * @param chunk      The chunk to encode.
+ * @param out        Receives the encoded payload.
+ * @param dictionary The world's dictionary; if given, FORMAT_LZ is used.
+ */
+void ChunkCodec::encode(const Chunk& chunk, std::vector<uint8_t>& out, const ChunkDictionary* dictionary) {
+    out.clear();
+
+    // --- Dictionary LZ over the raw block array ---
+    if (dictionary && !dictionary->empty()) {
+        out.push_back(FORMAT_LZ);
+        for (int shift = 0; shift < 32; shift += 8) {
+            out.push_back(uint8_t(dictionary->id >> shift));
+        }
+
+        LZCodec::compress(reinterpret_cast<const uint8_t*>(chunk.blocks), sizeof(chunk.blocks),
+                          dictionary->content.data(), dictionary->content.size(), out);
+        return;
+    }
+
+    // --- Run-length encoding ---
+    out.push_back(FORMAT_RLE);
+
+    // Walk the blocks in storage order, emitting one pair per run of identical IDs
+    int i = 0;
+    while (i < CHUNK_VOLUME) {
+        BlockID block = chunk.blocks[i];
+        int run = 1;
+        while (i + run < CHUNK_VOLUME && chunk.blocks[i + run] == block) {
+            ++run;
+        }
+
+        out.push_back(uint8_t(run));
+        out.push_back(uint8_t(run >> 8));
+        out.push_back(uint8_t(block));
+        out.push_back(uint8_t(block >> 8));
+
+        i += run;
+    }
+}
+
+/**
+ * Decodes a payload directly into caller-provided block storage.
+ *
+ * @param data       The encoded payload.
+ * @param size       The payload length, in bytes.
+ * @param blocks     Receives exactly CHUNK_VOLUME block IDs.
+ * @param dictionary The world's dictionary, needed for FORMAT_LZ payloads that use one.
+ * @return True if the payload was valid and filled every block.
+ */
+bool ChunkCodec::decode(const uint8_t* data, size_t size, BlockID* blocks, const ChunkDictionary* dictionary) {
+    if (size == 0) {
+        std::cout << "ERROR::CHUNK_CODEC::EMPTY_PAYLOAD" << std::endl;
+        return false;
+    }
+
+    // Dispatch on the format tag
+    switch (data[0]) {
+    case FORMAT_RLE:
+        return decodeRLE(data + 1, size - 1, blocks);
+    case FORMAT_LZ:
+        return decodeLZ(data + 1, size - 1, blocks, dictionary);
+    default:
+        std::cout << "ERROR::CHUNK_CODEC::UNKNOWN_FORMAT " << int(data[0]) << std::endl;
+        return false;
+    }
+}
+
+/**
+ * Decodes the run-length encoded body of a payload (after the format tag).
+ */
+bool ChunkCodec::decodeRLE(const uint8_t* data, size_t size, BlockID* blocks) {
+    if (size % 4 != 0) {
+        std::cout << "ERROR::CHUNK_CODEC::TRUNCATED_RLE" << std::endl;
+        return false;
+    }
+
+    int filled = 0;
+    for (size_t offset = 0; offset < size; offset += 4) {
+        int run = data[offset] | (data[offset + 1] << 8);
+        BlockID block = BlockID(data[offset + 2] | (data[offset + 3] << 8));
+
+        // Reject runs that would overflow the chunk rather than writing past it
+        if (run == 0 || filled + run > CHUNK_VOLUME) {
+            std::cout << "ERROR::CHUNK_CODEC::INVALID_RUN" << std::endl;
+            return false;
+        }
+
+        for (int i = 0; i < run; ++i) {
+            blocks[filled + i] = block;
+        }
+        filled += run;
+    }
+
+    if (filled != CHUNK_VOLUME) {
+        std::cout << "ERROR::CHUNK_CODEC::INCOMPLETE_CHUNK" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Decodes the LZ body of a payload (after the format tag) straight into `blocks`.
+ */
+bool ChunkCodec::decodeLZ(const uint8_t* data, size_t size, BlockID* blocks, const ChunkDictionary* dictionary) {
+    if (size < 4) {
+        std::cout << "ERROR::CHUNK_CODEC::TRUNCATED_LZ" << std::endl;
+        return false;
+    }
+
+    uint32_t dictionaryID = uint32_t(data[0]) | uint32_t(data[1]) << 8 | uint32_t(data[2]) << 16 | uint32_t(data[3]) << 24;
+
+    // The payload must be decoded with exactly the dictionary it was encoded with
+    const uint8_t* dictionaryBytes = nullptr;
+    size_t dictionarySize = 0;
+    if (dictionaryID != 0) {
+        if (!dictionary || dictionary->id != dictionaryID) {
+            std::cout << "ERROR::CHUNK_CODEC::DICTIONARY_MISMATCH " << dictionaryID << std::endl;
+            return false;
+        }
+        dictionaryBytes = dictionary->content.data();
+        dictionarySize = dictionary->content.size();
+    }
+
+    if (!LZCodec::decompress(data + 4, size - 4, dictionaryBytes, dictionarySize,
+                             reinterpret_cast<uint8_t*>(blocks), CHUNK_VOLUME * sizeof(BlockID))) {
+        std::cout << "ERROR::CHUNK_CODEC::INVALID_LZ" << std::endl;
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,73 @@
+// Prevents multiple inclusions of this header file, which can cause redefinition errors
+#ifndef CHUNK_CODEC_H
+#define CHUNK_CODEC_H
+
+// Includes fixed-width integer types such as uint8_t
+#include <cstdint>
+
+// Includes the vector container used for encoded payloads
+#include <vector>
+
+// Includes the Chunk struct and BlockID type
+#include "Chunk.h"
+
+// Includes the trained dictionary used by FORMAT_LZ
+#include "ChunkDictionary.h"
+
+/**
+ * The `ChunkCodec` class converts chunks to and from the compact payloads
+ * stored in region files.
+ *
+ * Every payload begins with a one-byte format tag so new encodings can be added
+ * without breaking old worlds:
+ * - FORMAT_RLE: a sequence of (run length, block ID) pairs, both 16-bit little endian
+ * - FORMAT_LZ: the ID of the dictionary used (32-bit little endian, 0 for none),
+ *   then the raw block array compressed with `LZCodec`
+ *
+ * Without a dictionary chunks are encoded as RLE; with one, as dictionary LZ.
+ *
+ * Decoding writes straight into caller-provided block storage (usually a chunk
+ * from `ChunkPool`), so loading a chunk never goes through a temporary array.
+ */
+class ChunkCodec {
+public:
+    /** The format tags a payload can start with */
+    enum Format : uint8_t {
+        FORMAT_RLE = 1,
+        FORMAT_LZ = 2
+    };
+
+    /**
+     * Encodes a chunk, appending the payload to `out`.
+     * `out` is cleared first but keeps its capacity, so it can be reused across calls.
+     *
+     * @param chunk      The chunk to encode.
+     * @param out        Receives the encoded payload.
+     * @param dictionary The world's dictionary; if given, FORMAT_LZ is used.
+     */
+    static void encode(const Chunk& chunk, std::vector<uint8_t>& out, const ChunkDictionary* dictionary = nullptr);
+
+    /**
+     * Decodes a payload directly into caller-provided block storage.
+     *
+     * @param data       The encoded payload.
+     * @param size       The payload length, in bytes.
+     * @param blocks     Receives exactly CHUNK_VOLUME block IDs.
+     * @param dictionary The world's dictionary, needed for FORMAT_LZ payloads that use one.
+     * @return True if the payload was valid and filled every block.
+     */
+    static bool decode(const uint8_t* data, size_t size, BlockID* blocks, const ChunkDictionary* dictionary = nullptr);
+
+private:
+    /**
+     * Decodes the run-length encoded body of a payload (after the format tag).
+     */
+    static bool decodeRLE(const uint8_t* data, size_t size, BlockID* blocks);
+
+    /**
+     * Decodes the LZ body of a payload (after the format tag) straight into `blocks`.
+     */
+    static bool decodeLZ(const uint8_t* data, size_t size, BlockID* blocks, const ChunkDictionary* dictionary);
+};
+
+#endif  // Ends the conditional inclusion directive
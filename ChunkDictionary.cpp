@@ -0,0 +1,117 @@
+// Includes the corresponding header file to access the ChunkDictionary declaration
+#include "ChunkDictionary.h"
+
+// Includes std::memcpy, used to read 8-byte substrings
+#include <cstring>
+
+// Includes std::priority_queue, used to pick the best segments
+#include <queue>
+
+// Includes the hash map used to count substrings
+#include <unordered_map>
+
+// The length of the segments a dictionary is assembled from, in bytes
+static const size_t SEGMENT_BYTES = 64;
+
+// The length of the substrings used to score segments, in bytes
+static const size_t DMER_BYTES = 8;
+
+/**
+ * Reads the 8-byte substring starting at `p`.
+ */
+static uint64_t readDmer(const uint8_t* p) {
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+/**
+ * Scores a segment: the summed frequency of every substring starting inside it.
+ */
+static uint64_t scoreSegment(const uint8_t* segment, const std::unordered_map<uint64_t, uint32_t>& counts) {
+    uint64_t score = 0;
+    for (size_t i = 0; i + DMER_BYTES <= SEGMENT_BYTES; ++i) {
+        auto found = counts.find(readDmer(segment + i));
+        if (found != counts.end()) {
+            score += found->second;
+        }
+    }
+    return score;
+}
+
+/**
+ * Trains a dictionary from sample chunks.
+ *
+ * @param samples  Chunks representative of the world.
+ * @param maxBytes The dictionary size to aim for.
+ * @return The trained dictionary (empty if there were no samples).
+ */
+ChunkDictionary ChunkDictionary::train(const std::vector<const Chunk*>& samples, size_t maxBytes) {
+    ChunkDictionary dictionary;
+    const size_t chunkBytes = sizeof(Chunk::blocks);
+
+    // --- Count how often each substring occurs across all samples ---
+    std::unordered_map<uint64_t, uint32_t> counts;
+    for (const Chunk* sample : samples) {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(sample->blocks);
+        for (size_t i = 0; i + DMER_BYTES <= chunkBytes; ++i) {
+            counts[readDmer(bytes + i)]++;
+        }
+    }
+
+    // --- Score every segment of every sample ---
+    struct Candidate {
+        uint64_t score;
+        const uint8_t* segment;
+        bool operator<(const Candidate& other) const { return score < other.score; }
+    };
+
+    std::priority_queue<Candidate> queue;
+    for (const Chunk* sample : samples) {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(sample->blocks);
+        for (size_t offset = 0; offset + SEGMENT_BYTES <= chunkBytes; offset += SEGMENT_BYTES) {
+            queue.push(Candidate{ scoreSegment(bytes + offset, counts), bytes + offset });
+        }
+    }
+
+    // --- Greedily take the best segment, re-scoring lazily as substrings get used up ---
+    std::vector<const uint8_t*> chosen;
+    while (!queue.empty() && chosen.size() * SEGMENT_BYTES < maxBytes) {
+        Candidate best = queue.top();
+        queue.pop();
+
+        // Scores only ever drop, so a stale score is an upper bound; re-check it
+        uint64_t current = scoreSegment(best.segment, counts);
+        if (current == 0) {
+            continue;
+        }
+        if (!queue.empty() && current < queue.top().score) {
+            queue.push(Candidate{ current, best.segment });
+            continue;
+        }
+
+        chosen.push_back(best.segment);
+
+        // Substrings this segment covers no longer make other segments valuable
+        for (size_t i = 0; i + DMER_BYTES <= SEGMENT_BYTES; ++i) {
+            counts[readDmer(best.segment + i)] = 0;
+        }
+    }
+
+    // --- Assemble: the best segments go last, where match offsets are shortest ---
+    dictionary.content.reserve(chosen.size() * SEGMENT_BYTES);
+    for (auto it = chosen.rbegin(); it != chosen.rend(); ++it) {
+        dictionary.content.insert(dictionary.content.end(), *it, *it + SEGMENT_BYTES);
+    }
+
+    // The ID is a hash of the content, so identical training gives an identical dictionary
+    if (!dictionary.content.empty()) {
+        uint32_t hash = 2166136261u;
+        for (uint8_t byte : dictionary.content) {
+            hash = (hash ^ byte) * 16777619u;
+        }
+        dictionary.id = hash ? hash : 1;
+    }
+
+    return dictionary;
+}
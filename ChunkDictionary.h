@@ -0,0 +1,47 @@
+// Prevents multiple inclusions of this header file, which can cause redefinition errors
+#ifndef CHUNK_DICTIONARY_H
+#define CHUNK_DICTIONARY_H
+
+// Includes fixed-width integer types such as uint32_t
+#include <cstdint>
+
+// Includes the vector container used for the dictionary bytes and samples
+#include <vector>
+
+// Includes the Chunk struct that dictionaries are trained on
+#include "Chunk.h"
+
+/**
+ * The `ChunkDictionary` struct holds a compression dictionary for chunk payloads.
+ *
+ * A dictionary is a block of bytes that commonly appear in chunks (runs of
+ * stone, layers of dirt over stone, air above terrain...). `LZCodec` treats it
+ * as data preceding every chunk, so those patterns cost only a short match
+ * reference each. One dictionary is trained per world and stored in its header.
+ */
+struct ChunkDictionary {
+    /** Identifies the dictionary; payloads record it so a mismatch is detected. 0 means none. */
+    uint32_t id = 0;
+
+    /** The dictionary content, most useful segments last (closest to the data) */
+    std::vector<uint8_t> content;
+
+    /** Returns true if the dictionary holds no content */
+    bool empty() const { return content.empty(); }
+
+    /**
+     * Trains a dictionary from sample chunks.
+     *
+     * Samples are cut into fixed-size segments. Each segment is scored by how
+     * many of its 8-byte substrings occur across all samples; the best segments
+     * are taken greedily, and substrings already covered stop counting, so the
+     * dictionary doesn't fill up with copies of the same pattern.
+     *
+     * @param samples  Chunks representative of the world (a few hundred is plenty).
+     * @param maxBytes The dictionary size to aim for.
+     * @return The trained dictionary (empty if there were no samples).
+     */
+    static ChunkDictionary train(const std::vector<const Chunk*>& samples, size_t maxBytes = 16 * 1024);
+};
+
+#endif  // Ends the conditional inclusion directive
@@ -0,0 +1,154 @@
+// Prevents multiple inclusions of this header file, which can cause redefinition errors
+#ifndef CHUNK_KEY_H
+#define CHUNK_KEY_H
+
+// Includes fixed-width integer types such as uint64_t
+#include <cstdint>
+
+// Includes the hash map container used for chunk lookups
+#include <unordered_map>
+
+#include <glm/glm.hpp>                      // GLM for vector types
+#include <glm/ext/vector_int3_sized.hpp>    // GLM 64-bit integer vectors (glm::i64vec3)
+
+// BMI2 provides single-instruction bit interleaving (pdep/pext) on modern x86 CPUs
+#if defined(__BMI2__) || (defined(_MSC_VER) && defined(__AVX2__))
+#include <immintrin.h>
+#define CHUNK_KEY_USE_BMI2 1
+#endif
+
+/**
+ * The `ChunkKey` struct packs a 3D chunk coordinate into a single 64-bit value.
+ *
+ * The bits of X, Y and Z are interleaved (Morton or "Z-order"), so sorting keys
+ * numerically visits chunks in a space-filling curve: chunks that are close in
+ * the world are usually close in the sorted order too. That makes the key useful
+ * beyond hashing - it orders chunks inside region files and orders jobs so that
+ * neighbouring chunks are processed together and share cache.
+ *
+ * Each axis gets 21 bits, covering chunk coordinates in [-2^20, 2^20), i.e.
+ * roughly +/-16.7 million blocks with 16-block chunks.
+ */
+struct ChunkKey {
+    /** The interleaved coordinate bits: bit 3n is X, 3n+1 is Y, 3n+2 is Z */
+    uint64_t value;
+
+    /** The number of bits stored per axis */
+    static constexpr int BITS_PER_AXIS = 21;
+
+    /** Added to signed coordinates so they fit in unsigned bit fields */
+    static constexpr int64_t AXIS_BIAS = int64_t(1) << (BITS_PER_AXIS - 1);
+
+    /** Mask selecting the bits belonging to the X axis */
+    static constexpr uint64_t X_MASK = 0x1249249249249249ull;
+
+    /**
+     * Constructor: Creates the key for chunk (0, 0, 0).
+     */
+    ChunkKey() : value(encode(0, 0, 0)) {}
+
+    /**
+     * Constructor: Creates the key for a chunk coordinate.
+     *
+     * @param x The chunk's X coordinate.
+     * @param y The chunk's Y coordinate.
+     * @param z The chunk's Z coordinate.
+     */
+    ChunkKey(int64_t x, int64_t y, int64_t z) : value(encode(x, y, z)) {}
+
+    /**
+     * Constructor: Creates the key for a chunk coordinate.
+     *
+     * @param chunk The chunk coordinate (for example `WorldPosition::chunk`).
+     */
+    explicit ChunkKey(const glm::i64vec3& chunk) : value(encode(chunk.x, chunk.y, chunk.z)) {}
+
+    /**
+     * Recreates a key from its raw packed value (for example, one read from disk).
+     */
+    static ChunkKey fromValue(uint64_t value) {
+        ChunkKey key;
+        key.value = value;
+        return key;
+    }
+
+    /**
+     * Unpacks the key back into a chunk coordinate.
+     */
+    glm::i64vec3 toCoord() const {
+        return glm::i64vec3(
+            int64_t(compact(value)) - AXIS_BIAS,
+            int64_t(compact(value >> 1)) - AXIS_BIAS,
+            int64_t(compact(value >> 2)) - AXIS_BIAS
+        );
+    }
+
+    /** Keys compare in Morton order */
+    bool operator==(const ChunkKey& other) const { return value == other.value; }
+    bool operator!=(const ChunkKey& other) const { return value != other.value; }
+    bool operator<(const ChunkKey& other) const { return value < other.value; }
+
+    /**
+     * Spreads the low 21 bits of a value out so there are two zero bits between each.
+     */
+    static uint64_t spread(uint64_t bits) {
+#ifdef CHUNK_KEY_USE_BMI2
+        return _pdep_u64(bits, X_MASK);
+#else
+        // Portable fallback: the classic "magic bits" sequence
+        bits &= 0x1fffff;
+        bits = (bits | bits << 32) & 0x001f00000000ffffull;
+        bits = (bits | bits << 16) & 0x001f0000ff0000ffull;
+        bits = (bits | bits << 8)  & 0x100f00f00f00f00full;
+        bits = (bits | bits << 4)  & 0x10c30c30c30c30c3ull;
+        bits = (bits | bits << 2)  & 0x1249249249249249ull;
+        return bits;
+#endif
+    }
+
+    /**
+     * Gathers every third bit back together (the inverse of `spread`).
+     */
+    static uint64_t compact(uint64_t bits) {
+#ifdef CHUNK_KEY_USE_BMI2
+        return _pext_u64(bits, X_MASK);
+#else
+        bits &= 0x1249249249249249ull;
+        bits = (bits ^ (bits >> 2))  & 0x10c30c30c30c30c3ull;
+        bits = (bits ^ (bits >> 4))  & 0x100f00f00f00f00full;
+        bits = (bits ^ (bits >> 8))  & 0x001f0000ff0000ffull;
+        bits = (bits ^ (bits >> 16)) & 0x001f00000000ffffull;
+        bits = (bits ^ (bits >> 32)) & 0x00000000001fffffull;
+        return bits;
+#endif
+    }
+
+    /**
+     * Interleaves three signed chunk coordinates into a Morton code.
+     */
+    static uint64_t encode(int64_t x, int64_t y, int64_t z) {
+        return spread(uint64_t(x + AXIS_BIAS))
+             | spread(uint64_t(y + AXIS_BIAS)) << 1
+             | spread(uint64_t(z + AXIS_BIAS)) << 2;
+    }
+};
+
+/**
+ * Hash function for `ChunkKey`.
+ * Morton codes of neighbouring chunks differ only in their low bits, so the value
+ * is mixed (a 64-bit multiply-xorshift) before the hash map reduces it to a bucket.
+ */
+struct ChunkKeyHash {
+    size_t operator()(const ChunkKey& key) const {
+        uint64_t h = key.value * 0x9e3779b97f4a7c15ull;
+        return size_t(h ^ (h >> 32));
+    }
+};
+
+/**
+ * A hash map from chunk coordinates to any per-chunk value.
+ */
+template <typename T>
+using ChunkMap = std::unordered_map<ChunkKey, T, ChunkKeyHash>;
+
+#endif  // Ends the conditional inclusion directive
@@ -0,0 +1,288 @@
+// Includes the corresponding header file to access the ChunkLifecycle class declaration
+#include "ChunkLifecycle.h"
+
+// Includes std::max and std::push_heap/pop_heap
+#include <algorithm>
+
+// Includes the vector container, used to batch uploads
+#include <vector>
+
+/**
+ * What one stage needs before it can run, and what it touches while it runs.
+ */
+struct StageRule {
+    /** The stage all 26 neighbors must have completed */
+    ChunkStage neighborsAtLeast;
+
+    /** True if the stage touches its neighbors, not just its own chunk */
+    bool neighbors;
+
+    /** True if it writes what it touches (an exclusive lock), false if it only reads (shared) */
+    bool exclusive;
+};
+
+// Indexed by the state each stage produces (see the table in ChunkLifecycle.h)
+static const StageRule STAGE_RULES[CHUNK_STAGE_COUNT] = {
+    { CHUNK_STAGE_NONE, false, false },      // None: never runs
+    { CHUNK_STAGE_NONE, false, true },       // Generate
+    { CHUNK_STAGE_GENERATED, true, true },   // Features
+    { CHUNK_STAGE_FEATURED, true, true },    // Light
+    { CHUNK_STAGE_LIT, true, false },        // Mesh
+    { CHUNK_STAGE_NONE, false, false }       // Upload
+};
+
+/**
+ * Returns true if `test` holds for every chunk in the cube of chunks up to `reach` from `center`.
+ */
+template <typename Test>
+static bool allInCube(const glm::i64vec3& center, int reach, Test test) {
+    for (int y = -reach; y <= reach; ++y) {
+        for (int z = -reach; z <= reach; ++z) {
+            for (int x = -reach; x <= reach; ++x) {
+                if (!test(center + glm::i64vec3(x, y, z))) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * Constructor: Creates a lifecycle with no chunks, whose stages do nothing until set.
+ *
+ * @param pool The workers stages run on.
+ */
+ChunkLifecycle::ChunkLifecycle(ThreadPool& pool)
+    : pool(pool), runningJobs(0), nextOrder(0), stageCounts(), stopping(false) {}
+
+/**
+ * Destructor: Stops starting stages and waits for running ones to return.
+ */
+ChunkLifecycle::~ChunkLifecycle() {
+    std::unique_lock<std::mutex> lock(mutex);
+    stopping = true;
+    allReturned.wait(lock, [this] { return runningJobs == 0; });
+}
+
+/**
+ * Sets the work of a stage.
+ *
+ * @param stage The stage, named after the state it produces.
+ * @param work  The work.
+ */
+void ChunkLifecycle::setStageWork(ChunkStage stage, StageWork work) {
+    this->work[stage] = work;
+}
+
+/**
+ * Asks for a chunk to reach a stage, along with what its neighbors need for that.
+ *
+ * @param chunk  The chunk coordinate.
+ * @param target The stage to reach.
+ */
+void ChunkLifecycle::request(const glm::i64vec3& chunk, ChunkStage target) {
+    std::lock_guard<std::mutex> lock(mutex);
+    raiseTarget(chunk, target);
+}
+
+/**
+ * Runs queued uploads on this thread.
+ *
+ * @param uploadBudget The most uploads to run.
+ * @return The number run.
+ */
+size_t ChunkLifecycle::update(size_t uploadBudget) {
+    std::vector<glm::i64vec3> due;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        while (due.size() < uploadBudget && !uploads.empty()) {
+            due.push_back(uploads.front());
+            uploads.pop_front();
+        }
+    }
+
+    // Run the uploads outside the lock, so workers finishing meanwhile aren't held up
+    for (const glm::i64vec3& chunk : due) {
+        if (work[CHUNK_STAGE_UPLOADED]) {
+            work[CHUNK_STAGE_UPLOADED](chunk);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const glm::i64vec3& chunk : due) {
+        finish(chunk);
+    }
+    return due.size();
+}
+
+/**
+ * Sleeps until an upload is queued or the timeout passes.
+ *
+ * @return True if an upload is queued.
+ */
+bool ChunkLifecycle::waitForUploads(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(mutex);
+    return uploadQueued.wait_for(lock, timeout, [this] { return !uploads.empty(); });
+}
+
+/**
+ * Returns the stage a chunk has completed; `CHUNK_STAGE_NONE` if it isn't tracked.
+ */
+ChunkStage ChunkLifecycle::getStage(const glm::i64vec3& chunk) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto found = chunks.find(ChunkKey(chunk));
+    return found != chunks.end() ? found->second.stage : CHUNK_STAGE_NONE;
+}
+
+/**
+ * Returns the number of chunks a stage has run on so far.
+ */
+uint64_t ChunkLifecycle::getStageCount(ChunkStage stage) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stageCounts[stage];
+}
+
+/**
+ * Raises a chunk's target, and its neighbors' targets to what that needs. Called with `mutex` held.
+ */
+void ChunkLifecycle::raiseTarget(const glm::i64vec3& chunk, ChunkStage target) {
+    auto inserted = chunks.emplace(ChunkKey(chunk), ChunkEntry());
+    ChunkEntry& entry = inserted.first->second;
+    if (inserted.second) {
+        entry.order = nextOrder++;
+    }
+    if (entry.target >= target) {
+        return; // Raised this far before, neighbors included
+    }
+    entry.target = target;
+
+    ChunkStage needed = CHUNK_STAGE_NONE;
+    for (int stage = CHUNK_STAGE_GENERATED; stage <= target; ++stage) {
+        needed = std::max(needed, STAGE_RULES[stage].neighborsAtLeast);
+    }
+    if (needed != CHUNK_STAGE_NONE) {
+        allInCube(chunk, 1, [&](const glm::i64vec3& neighbor) {
+            if (neighbor != chunk) {
+                raiseTarget(neighbor, needed);
+            }
+            return true;
+        });
+    }
+    tryStart(chunk);
+}
+
+/**
+ * Starts a chunk's next stage if it is wanted, its neighbors are far enough along and its
+ * locks are free. Called with `mutex` held.
+ */
+void ChunkLifecycle::tryStart(const glm::i64vec3& chunk) {
+    auto found = chunks.find(ChunkKey(chunk));
+    if (found == chunks.end()) {
+        return;
+    }
+    ChunkEntry& entry = found->second;
+    if (stopping || entry.running || entry.stage >= entry.target) {
+        return;
+    }
+
+    ChunkStage next = ChunkStage(entry.stage + 1);
+    const StageRule& rule = STAGE_RULES[next];
+
+    // --- Dependencies ---
+    if (rule.neighborsAtLeast != CHUNK_STAGE_NONE) {
+        bool ready = allInCube(chunk, 1, [&](const glm::i64vec3& neighbor) {
+            auto other = chunks.find(ChunkKey(neighbor));
+            return other != chunks.end() && other->second.stage >= rule.neighborsAtLeast;
+        });
+        if (!ready) {
+            return;
+        }
+    }
+
+    // --- Locks ---
+    // Every chunk a stage touches is tracked: either it is the chunk itself, or the
+    // dependencies above found it
+    bool free = allInCube(chunk, rule.neighbors ? 1 : 0, [&](const glm::i64vec3& touched) {
+        const ChunkEntry& other = chunks.find(ChunkKey(touched))->second;
+        return !other.writeLocked && (!rule.exclusive || other.readLocks == 0);
+    });
+    if (!free) {
+        return;
+    }
+    setLocks(chunk, next, true);
+    entry.running = true;
+
+    if (next == CHUNK_STAGE_UPLOADED) {
+        uploads.push_back(chunk);
+        uploadQueued.notify_all();
+        return;
+    }
+
+    ready.push_back({ chunk, next, entry.order });
+    std::push_heap(ready.begin(), ready.end());
+    dispatch();
+}
+
+/**
+ * Submits ready stages to the pool while it has idle threads. Called with `mutex` held.
+ */
+void ChunkLifecycle::dispatch() {
+    while (!stopping && !ready.empty() && runningJobs < pool.getThreadCount()) {
+        std::pop_heap(ready.begin(), ready.end());
+        ReadyStage stage = ready.back();
+        ready.pop_back();
+
+        ++runningJobs;
+        pool.submit([this, stage]() {
+            if (work[stage.stage]) {
+                work[stage.stage](stage.chunk);
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            --runningJobs;
+            finish(stage.chunk);
+            dispatch();
+            if (runningJobs == 0) {
+                allReturned.notify_all();
+            }
+        });
+    }
+}
+
+/**
+ * Takes or releases the locks a stage holds on a chunk and, if it touches them, its
+ * neighbors. Called with `mutex` held.
+ */
+void ChunkLifecycle::setLocks(const glm::i64vec3& chunk, ChunkStage stage, bool locked) {
+    const StageRule& rule = STAGE_RULES[stage];
+    allInCube(chunk, rule.neighbors ? 1 : 0, [&](const glm::i64vec3& touched) {
+        ChunkEntry& other = chunks.find(ChunkKey(touched))->second;
+        if (rule.exclusive) {
+            other.writeLocked = locked;
+        } else {
+            other.readLocks += locked ? 1 : -1;
+        }
+        return true;
+    });
+}
+
+/**
+ * Records a finished stage, releases its locks and starts what it unblocked. Called with
+ * `mutex` held.
+ */
+void ChunkLifecycle::finish(const glm::i64vec3& chunk) {
+    ChunkEntry& entry = chunks.find(ChunkKey(chunk))->second;
+    ChunkStage done = ChunkStage(entry.stage + 1);
+    entry.stage = done;
+    entry.running = false;
+    ++stageCounts[done];
+    setLocks(chunk, done, false);
+
+    // The new stage can unblock the neighbors depending on it, and the released locks any
+    // chunk whose stage touches them: up to two chunks out for a stage that locked its neighbors
+    allInCube(chunk, STAGE_RULES[done].neighbors ? 2 : 1, [&](const glm::i64vec3& other) {
+        tryStart(other);
+        return true;
+    });
+}
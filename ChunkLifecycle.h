@@ -0,0 +1,230 @@
+// Prevents multiple inclusions of this header file, which can cause redefinition errors
+#ifndef CHUNK_LIFECYCLE_H
+#define CHUNK_LIFECYCLE_H
+
+// Includes std::chrono::milliseconds, the timeout of `waitForUploads`
+#include <chrono>
+
+// Includes std::condition_variable, used to wait for uploads and running stages
+#include <condition_variable>
+
+// Includes fixed-width integer types such as uint64_t
+#include <cstdint>
+
+// Includes the deque container, used for the upload queue
+#include <deque>
+
+// Includes std::function, the type of the stage callbacks
+#include <functional>
+
+// Includes std::mutex, which guards every chunk's state
+#include <mutex>
+
+// Includes the vector container, the heap of ready stages
+#include <vector>
+
+#include <glm/glm.hpp>                      // GLM for vector types
+#include <glm/ext/vector_int3_sized.hpp>    // GLM 64-bit integer vectors (glm::i64vec3)
+
+#include "ChunkKey.h"   // The map of chunk states
+#include "ThreadPool.h" // Workers that run the stages
+
+/**
+ * The stages of a chunk's life, each named after the state it leaves the
+ * chunk in. A chunk has completed every stage up to its current one.
+ */
+enum ChunkStage {
+    CHUNK_STAGE_NONE,      // Tracked, nothing done
+    CHUNK_STAGE_GENERATED, // Terrain blocks filled in
+    CHUNK_STAGE_FEATURED,  // Trees, ores and structures placed, possibly reaching into neighbors
+    CHUNK_STAGE_LIT,       // Light propagated, possibly across the border
+    CHUNK_STAGE_MESHED,    // Mesh built, reading neighbors' blocks and light at the border
+    CHUNK_STAGE_UPLOADED,  // Mesh on the GPU; the chunk is ready to draw
+    CHUNK_STAGE_COUNT
+};
+
+/**
+ * The `ChunkLifecycle` class drives chunks through their stages, running each
+ * stage as soon as what it depends on is done.
+ *
+ * A stage needs the chunk's 26 neighbors to have reached some stage first:
+ *
+ *   stage       neighbors at least   touches neighbors
+ *   generate    -                    no
+ *   features    generated            writes
+ *   light       featured             writes
+ *   mesh        lit                  reads
+ *   upload      -                    no (main thread)
+ *
+ * Requesting a chunk therefore also requests its neighbors up to lit, theirs
+ * up to featured and theirs up to generated, and those run first.
+ *
+ * Stages that touch neighbors also lock them for as long as they run: a
+ * writing stage exclusively, a reading stage shared, so features placed in a
+ * neighbor never race the neighbor's own features or a mesh reading it. A
+ * stage starts only once it can take every lock at once, so nothing ever
+ * holds some locks while waiting for others.
+ *
+ * Nothing polls. Whenever a stage finishes, the chunks it could have
+ * unblocked (its neighbors' neighbors) are checked, and those now ready join
+ * a heap the finishing worker hands the next stage from. Only as many stages
+ * as the pool has threads are submitted at once, so the heap, not the pool's
+ * FIFO queue, decides what runs next: later stages first, which finishes
+ * chunks rather than starting more, then chunks in the order they were first
+ * requested (so request the nearest first). Uploads need the GL context, so
+ * they are queued for the main thread, which runs them in `update` within a
+ * budget, or sleeps on `waitForUploads` on a loading screen.
+ */
+class ChunkLifecycle {
+public:
+    /** The work of one stage on one chunk */
+    typedef std::function<void(const glm::i64vec3& chunk)> StageWork;
+
+    /**
+     * Constructor: Creates a lifecycle with no chunks, whose stages do nothing until set.
+     *
+     * @param pool The workers stages run on.
+     */
+    explicit ChunkLifecycle(ThreadPool& pool);
+
+    /**
+     * Destructor: Stops starting stages and waits for running ones to return.
+     */
+    ~ChunkLifecycle();
+
+    /**
+     * Sets the work of a stage. Must be called before any chunk is requested.
+     *
+     * @param stage The stage, named after the state it produces (not `CHUNK_STAGE_NONE`).
+     * @param work  The work; runs on a worker, or in `update` for `CHUNK_STAGE_UPLOADED`.
+     */
+    void setStageWork(ChunkStage stage, StageWork work);
+
+    /**
+     * Asks for a chunk to reach a stage, along with what its neighbors need for that.
+     *
+     * @param chunk  The chunk coordinate.
+     * @param target The stage to reach (uploaded to draw it).
+     */
+    void request(const glm::i64vec3& chunk, ChunkStage target = CHUNK_STAGE_UPLOADED);
+
+    /**
+     * Runs queued uploads on this (the GL) thread.
+     *
+     * @param uploadBudget The most uploads to run.
+     * @return The number run.
+     */
+    size_t update(size_t uploadBudget);
+
+    /**
+     * Sleeps until an upload is queued or the timeout passes.
+     *
+     * @return True if an upload is queued.
+     */
+    bool waitForUploads(std::chrono::milliseconds timeout);
+
+    /** Returns the stage a chunk has completed; `CHUNK_STAGE_NONE` if it isn't tracked */
+    ChunkStage getStage(const glm::i64vec3& chunk);
+
+    /** Returns the number of chunks a stage has run on so far */
+    uint64_t getStageCount(ChunkStage stage);
+
+private:
+    /**
+     * The `ChunkEntry` struct is the state of one tracked chunk.
+     */
+    struct ChunkEntry {
+        /** The last stage completed, and the one asked for */
+        ChunkStage stage = CHUNK_STAGE_NONE;
+        ChunkStage target = CHUNK_STAGE_NONE;
+
+        /** True while the next stage is ready, queued or running */
+        bool running = false;
+
+        /** When the chunk was first tracked; earlier chunks' stages run first */
+        uint64_t order = 0;
+
+        /** Stages holding this chunk: one writer, or any number of readers */
+        bool writeLocked = false;
+        int readLocks = 0;
+    };
+
+    /**
+     * The `ReadyStage` struct is a stage whose dependencies are met and locks taken,
+     * waiting for a worker.
+     */
+    struct ReadyStage {
+        glm::i64vec3 chunk;
+        ChunkStage stage;
+        uint64_t order;
+
+        /** Heap order: the stage to run next compares greatest */
+        bool operator<(const ReadyStage& other) const {
+            return stage != other.stage ? stage < other.stage : order > other.order;
+        }
+    };
+
+    /**
+     * Raises a chunk's target, and its neighbors' targets to what that needs.
+     */
+    void raiseTarget(const glm::i64vec3& chunk, ChunkStage target);
+
+    /**
+     * Starts a chunk's next stage if it is wanted, its neighbors are far enough
+     * along and its locks are free.
+     */
+    void tryStart(const glm::i64vec3& chunk);
+
+    /**
+     * Takes or releases the locks a chunk's next stage holds while it runs.
+     */
+    void setLocks(const glm::i64vec3& chunk, ChunkStage stage, bool locked);
+
+    /**
+     * Records a finished stage, releases its locks and starts what it unblocked.
+     */
+    void finish(const glm::i64vec3& chunk);
+
+    /**
+     * Submits ready stages to the pool while it has idle threads.
+     */
+    void dispatch();
+
+    /** The workers stages run on */
+    ThreadPool& pool;
+
+    /** The work of each stage, indexed by the state it produces */
+    StageWork work[CHUNK_STAGE_COUNT];
+
+    /** Every tracked chunk */
+    ChunkMap<ChunkEntry> chunks;
+
+    /** Stages waiting for a worker, a heap ordered by `ReadyStage::operator<` */
+    std::vector<ReadyStage> ready;
+
+    /** Chunks whose upload is due, oldest first, run by `update` */
+    std::deque<glm::i64vec3> uploads;
+
+    /** Stages submitted to the pool that have not returned */
+    size_t runningJobs;
+
+    /** The order the next newly tracked chunk gets */
+    uint64_t nextOrder;
+
+    /** The number of chunks each stage ran on */
+    uint64_t stageCounts[CHUNK_STAGE_COUNT];
+
+    /** Set by the destructor: finishing stages start no more */
+    bool stopping;
+
+    /** Guards everything above but `pool` and `work` */
+    std::mutex mutex;
+
+    /** Signalled when an upload is queued */
+    std::condition_variable uploadQueued;
+
+    /** Signalled when the last running stage returns */
+    std::condition_variable allReturned;
+};
+
+#endif  // Ends the conditional inclusion directive
@@ -0,0 +1,272 @@
+// Includes the corresponding header file to access the ChunkLoader class declaration
+#include "ChunkLoader.h"
+
+// Includes std::sort and std::find
+#include <algorithm>
+
+// Includes std::filesystem, used to create the world directory and look for region files
+#include <filesystem>
+
+// Includes std::to_string for building region file names
+#include <string>
+
+// Includes the codec that turns payloads into blocks and back
+#include "ChunkCodec.h"
+
+/**
+ * Constructor: Creates a loader for a world directory (created if missing).
+ *
+ * @param worldDirectory The directory holding the world's region files.
+ * @param pool           The pool to take chunk buffers from.
+ */
+ChunkLoader::ChunkLoader(const std::string& worldDirectory, ChunkPool& pool)
+    : directory(worldDirectory), pool(pool), dictionary(nullptr) {
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+}
+
+/**
+ * Loads a chunk.
+ *
+ * @param chunk  The chunk coordinate.
+ * @param status Receives whether the chunk loaded, isn't stored, or failed.
+ * @return A pooled chunk holding the stored blocks, or nullptr unless `status` is `CHUNK_LOAD_OK`.
+ */
+Chunk* ChunkLoader::load(const glm::i64vec3& chunk, ChunkLoadStatus& status) {
+    status = CHUNK_LOAD_FAILED;
+
+    // A region file that exists but won't open (a bad header) may still hold the chunk
+    RegionFile* region = getRegion(chunk);
+    if (!region) {
+        if (!std::filesystem::exists(regionPath(RegionFile::regionCoord(chunk)))) {
+            status = CHUNK_LOAD_NOT_STORED;
+        }
+        return nullptr;
+    }
+
+    int index = RegionFile::entryIndex(chunk);
+    RegionFile::Entry entry = region->getEntry(index);
+    if (entry.sectorOffset == 0) {
+        status = CHUNK_LOAD_NOT_STORED;
+        return nullptr;
+    }
+
+    // --- Read the payload into the reusable buffer ---
+
+    // The buffer only ever grows, so after warm-up no load allocates here
+    if (payload.size() < entry.byteLength) {
+        payload.resize(entry.byteLength);
+        stats.allocations++;
+    }
+
+    if (!region->readChunk(index, payload.data())) {
+        return nullptr;
+    }
+
+    // --- Decode directly into a pooled chunk ---
+    size_t allocatedBefore = pool.getAllocationCount();
+    Chunk* result = pool.acquire();
+    stats.allocations += pool.getAllocationCount() - allocatedBefore;
+
+    if (!ChunkCodec::decode(payload.data(), entry.byteLength, result->blocks, dictionary)) {
+        pool.release(result);
+        return nullptr;
+    }
+
+    stats.chunksLoaded++;
+    stats.payloadBytes += entry.byteLength;
+    status = CHUNK_LOAD_OK;
+    return result;
+}
+
+/**
+ * Loads many chunks at once through the I/O backend.
+ *
+ * @param coords The chunk coordinates to load.
+ * @param chunks Receives one pooled chunk per coordinate, in the same order as `coords`.
+ * @return The number of chunks loaded.
+ */
+size_t ChunkLoader::loadBatch(const std::vector<glm::i64vec3>& coords, std::vector<Chunk*>& chunks) {
+    chunks.assign(coords.size(), nullptr);
+
+    if (!io) {
+        io = RegionIOBackend::create();
+    }
+
+    // --- Visit chunks in Morton order, so each region's reads are grouped ---
+    std::vector<size_t> order(coords.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&coords](size_t a, size_t b) {
+        return ChunkKey(coords[a]) < ChunkKey(coords[b]);
+    });
+
+    // --- Build the read requests, laying the payloads out back to back ---
+    requests.clear();
+    batchFiles.clear();
+    size_t totalBytes = 0;
+    for (size_t i : order) {
+        RegionFile* region = getRegion(coords[i]);
+        if (!region) {
+            continue;
+        }
+
+        // Hold on to the file, so a compaction swapping it out can't close it mid-batch
+        RegionFile::Entry entry;
+        std::shared_ptr<const File> file;
+        region->locate(RegionFile::entryIndex(coords[i]), entry, file);
+        if (entry.sectorOffset == 0) {
+            continue;
+        }
+        if (batchFiles.empty() || batchFiles.back() != file) {
+            batchFiles.push_back(file);
+        }
+
+        ChunkReadRequest request;
+        request.file = file.get();
+        request.offset = uint64_t(entry.sectorOffset) * RegionFile::SECTOR_SIZE;
+        request.buffer = nullptr;
+        request.size = entry.byteLength;
+        request.success = false;
+        request.tag = i;
+        requests.push_back(request);
+
+        totalBytes += entry.byteLength;
+    }
+
+    // The batch buffer only grows, like the single-load payload buffer
+    if (batchPayload.size() < totalBytes) {
+        batchPayload.resize(totalBytes);
+        stats.allocations++;
+    }
+
+    size_t offset = 0;
+    for (ChunkReadRequest& request : requests) {
+        request.buffer = batchPayload.data() + offset;
+        offset += request.size;
+    }
+
+    // --- Read everything, then decode each payload straight into a pooled chunk ---
+    io->readBatch(requests);
+
+    size_t loaded = 0;
+    for (const ChunkReadRequest& request : requests) {
+        if (!request.success) {
+            continue;
+        }
+
+        size_t allocatedBefore = pool.getAllocationCount();
+        Chunk* chunk = pool.acquire();
+        stats.allocations += pool.getAllocationCount() - allocatedBefore;
+
+        if (!ChunkCodec::decode(request.buffer, request.size, chunk->blocks, dictionary)) {
+            pool.release(chunk);
+            continue;
+        }
+
+        chunks[request.tag] = chunk;
+        stats.chunksLoaded++;
+        stats.payloadBytes += request.size;
+        loaded++;
+    }
+
+    batchFiles.clear();
+    return loaded;
+}
+
+/**
+ * Returns a loaded chunk's buffer to the pool.
+ *
+ * @param chunk A chunk previously returned by `load`.
+ */
+void ChunkLoader::unload(Chunk* chunk) {
+    pool.release(chunk);
+}
+
+/**
+ * Encodes and stores a chunk.
+ *
+ * @param coord The chunk coordinate.
+ * @param chunk The blocks to store.
+ * @return True on success.
+ */
+bool ChunkLoader::save(const glm::i64vec3& coord, const Chunk& chunk) {
+    RegionFile* region = getRegion(coord, true);
+    if (!region) {
+        return false;
+    }
+
+    // Written chunks aren't durable until the region is synced
+    if (std::find(unsynced.begin(), unsynced.end(), region) == unsynced.end()) {
+        unsynced.push_back(region);
+    }
+
+    ChunkCodec::encode(chunk, encoded, dictionary);
+    return region->writeChunk(RegionFile::entryIndex(coord), encoded.data(), encoded.size());
+}
+
+/**
+ * Flushes every region file `save` has written to since the last call to the disk,
+ * then queues them for compaction.
+ *
+ * @return True if every saved chunk is now durable.
+ */
+bool ChunkLoader::syncSaved() {
+    if (!compactor) {
+        compactor = std::make_unique<RegionCompactor>();
+    }
+
+    // Every rewrite appends a new copy and leaves a hole, so written regions are the ones to compact
+    std::vector<RegionFile*> failed;
+    for (RegionFile* region : unsynced) {
+        if (region->sync()) {
+            compactor->enqueue(region);
+        } else {
+            failed.push_back(region);
+        }
+    }
+
+    unsynced.swap(failed);
+    return unsynced.empty();
+}
+
+/**
+ * Returns the region file containing a chunk, opening it on first use.
+ *
+ * @param chunk  The chunk coordinate.
+ * @param create If true, a missing region file is created.
+ * @return The region, or nullptr if it doesn't exist or couldn't be opened.
+ */
+RegionFile* ChunkLoader::getRegion(const glm::i64vec3& chunk, bool create) {
+    glm::i64vec3 regionCoord = RegionFile::regionCoord(chunk);
+    ChunkKey key(regionCoord);
+
+    auto found = regions.find(key);
+    if (found != regions.end()) {
+        return found->second.get();
+    }
+
+    // Loading never creates files; only saving does
+    std::string path = regionPath(regionCoord);
+    if (!create && !std::filesystem::exists(path)) {
+        return nullptr;
+    }
+
+    auto region = std::make_unique<RegionFile>();
+    if (!region->open(path)) {
+        return nullptr;
+    }
+
+    RegionFile* result = region.get();
+    regions.emplace(key, std::move(region));
+    return result;
+}
+
+/**
+ * Returns the path of the region file for a region coordinate.
+ */
+std::string ChunkLoader::regionPath(const glm::i64vec3& region) const {
+    return directory + "/r." + std::to_string(region.x) + "." + std::to_string(region.y) + "."
+         + std::to_string(region.z) + ".kyr";
+}
@@ -0,0 +1,195 @@
+// Prevents multiple inclusions of this header file, which can cause redefinition errors
+#ifndef CHUNK_LOADER_H
+#define CHUNK_LOADER_H
+
+// Includes fixed-width integer types such as uint64_t
+#include <cstdint>
+
+// Includes std::unique_ptr, which owns the open region files
+#include <memory>
+
+// Includes the C++ Standard Library string class, used for the world directory
+#include <string>
+
+// Includes the vector container used for the reusable payload buffers
+#include <vector>
+
+#include <glm/glm.hpp>                      // GLM for vector types
+#include <glm/ext/vector_int3_sized.hpp>    // GLM 64-bit integer vectors (glm::i64vec3)
+
+#include "Chunk.h"          // The chunk storage being loaded
+#include "ChunkDictionary.h" // The world's compression dictionary
+#include "ChunkKey.h"       // Keys for the map of open regions
+#include "ChunkPool.h"      // The pool that chunk buffers come from and return to
+#include "RegionCompactor.h" // Rewrites fragmented region files in the background
+#include "RegionFile.h"     // The files chunk payloads are stored in
+#include "RegionIO.h"       // Backends for reading many payloads at once
+
+/**
+ * Counters describing the cost of loading chunks.
+ * Divide by `chunksLoaded` for per-chunk figures.
+ */
+struct ChunkLoadStats {
+    /** The number of chunks successfully loaded */
+    uint64_t chunksLoaded = 0;
+
+    /** Heap allocations made while loading (new pooled chunks and payload buffer growth) */
+    uint64_t allocations = 0;
+
+    /** Encoded payload bytes read from region files */
+    uint64_t payloadBytes = 0;
+};
+
+/**
+ * What `ChunkLoader::load` found for a chunk.
+ */
+enum ChunkLoadStatus {
+    CHUNK_LOAD_OK,         // Loaded
+    CHUNK_LOAD_NOT_STORED, // Never saved: no region file, or no payload in it
+    CHUNK_LOAD_FAILED      // Stored, but the region or payload couldn't be read or decoded
+};
+
+/**
+ * The `ChunkLoader` class reads chunks from, and writes chunks to, the region
+ * files in a world directory.
+ *
+ * Loading avoids every intermediate copy it can:
+ * - The payload is read into one reusable buffer that only grows
+ * - The codec decodes it straight into a chunk taken from `ChunkPool`
+ * - Unloaded chunks go back to the pool for the next load
+ * Once the pool and buffer have warmed up, a load makes no heap allocations.
+ *
+ * The loader is meant to be used from one thread at a time.
+ */
+class ChunkLoader {
+public:
+    /**
+     * Constructor: Creates a loader for a world directory (created if missing).
+     *
+     * @param worldDirectory The directory holding the world's region files.
+     * @param pool           The pool to take chunk buffers from.
+     */
+    ChunkLoader(const std::string& worldDirectory, ChunkPool& pool);
+
+    /**
+     * Loads a chunk.
+     *
+     * A chunk that failed to load must not be replaced by a new one: saving it
+     * would overwrite data that may still be recoverable (for example, with the
+     * right dictionary).
+     *
+     * @param chunk  The chunk coordinate.
+     * @param status Receives whether the chunk loaded, isn't stored, or failed.
+     * @return A pooled chunk holding the stored blocks, or nullptr unless `status` is `CHUNK_LOAD_OK`.
+     */
+    Chunk* load(const glm::i64vec3& chunk, ChunkLoadStatus& status);
+
+    /**
+     * Loads many chunks at once through the I/O backend.
+     *
+     * Requests are sorted by `ChunkKey` (Morton order), so reads from the same
+     * region are issued together and roughly in file order, then the whole batch
+     * is handed to the backend in one go.
+     *
+     * @param coords The chunk coordinates to load.
+     * @param chunks Receives one pooled chunk per coordinate (nullptr where the
+     *               chunk isn't stored or is invalid), in the same order as `coords`.
+     * @return The number of chunks loaded.
+     */
+    size_t loadBatch(const std::vector<glm::i64vec3>& coords, std::vector<Chunk*>& chunks);
+
+    /**
+     * Returns a loaded chunk's buffer to the pool.
+     *
+     * @param chunk A chunk previously returned by `load`.
+     */
+    void unload(Chunk* chunk);
+
+    /**
+     * Encodes and stores a chunk.
+     *
+     * @param coord The chunk coordinate.
+     * @param chunk The blocks to store.
+     * @return True on success.
+     */
+    bool save(const glm::i64vec3& coord, const Chunk& chunk);
+
+    /**
+     * Flushes every region file `save` has written to since the last call to the disk.
+     * Regions that fail to sync are retried by the next call; the others are queued
+     * for compaction, which rewrites them once rewrites have left enough holes.
+     *
+     * @return True if every saved chunk is now durable.
+     */
+    bool syncSaved();
+
+    /**
+     * Returns the region file containing a chunk, opening it on first use.
+     *
+     * @param chunk  The chunk coordinate.
+     * @param create If true, a missing region file is created.
+     * @return The region, or nullptr if it doesn't exist or couldn't be opened.
+     */
+    RegionFile* getRegion(const glm::i64vec3& chunk, bool create = false);
+
+    /**
+     * Returns the path of the region file for a region coordinate.
+     */
+    std::string regionPath(const glm::i64vec3& region) const;
+
+    /**
+     * Sets the dictionary used to encode saved chunks and decode dictionary payloads.
+     * The dictionary must outlive the loader (the world header owns it).
+     *
+     * @param dictionary The world's dictionary, or nullptr to save chunks without one.
+     */
+    void setDictionary(const ChunkDictionary* dictionary) { this->dictionary = dictionary; }
+
+    /** Returns the load counters gathered so far */
+    const ChunkLoadStats& getStats() const { return stats; }
+
+    /** Returns the pool chunk buffers come from */
+    ChunkPool& getPool() { return pool; }
+
+private:
+    /** The directory holding the world's region files */
+    std::string directory;
+
+    /** The pool chunk buffers come from and return to */
+    ChunkPool& pool;
+
+    /** The world's compression dictionary, or nullptr */
+    const ChunkDictionary* dictionary;
+
+    /** The region files opened so far, keyed by region coordinate */
+    ChunkMap<std::unique_ptr<RegionFile>> regions;
+
+    /** Reusable buffer that encoded payloads are read into */
+    std::vector<uint8_t> payload;
+
+    /** The backend used by `loadBatch`, created on first use */
+    std::unique_ptr<RegionIOBackend> io;
+
+    /** Reusable list of reads for `loadBatch` */
+    std::vector<ChunkReadRequest> requests;
+
+    /** The region files a batch is reading from, kept alive until it completes */
+    std::vector<std::shared_ptr<const File>> batchFiles;
+
+    /** Reusable buffer holding every payload of a batch back to back */
+    std::vector<uint8_t> batchPayload;
+
+    /** Reusable buffer that chunks are encoded into before saving */
+    std::vector<uint8_t> encoded;
+
+    /** Regions written by `save` since the last `syncSaved` */
+    std::vector<RegionFile*> unsynced;
+
+    /** Compacts synced regions, created on first use; declared after `regions`, so it stops first */
+    std::unique_ptr<RegionCompactor> compactor;
+
+    /** Counters describing the cost of loading */
+    ChunkLoadStats stats;
+};
+
+#endif  // Ends the conditional inclusion directive
@@ -0,0 +1,261 @@
+// Includes the corresponding header file to access the ChunkMesher class declaration
+#include "ChunkMesher.h"
+
+// Includes std::abs, std::max and std::min
+#include <algorithm>
+#include <cstdlib>
+
+// The most blocks in one cell, at the coarsest level of detail
+static const int MAX_CELL_VOLUME = 1 << (3 * (CHUNK_LOD_COUNT - 1));
+
+/**
+ * Constructor: Creates a mesher that reads block properties from a registry.
+ *
+ * @param registry The block types; must outlive the mesher.
+ */
+ChunkMesher::ChunkMesher(const BlockRegistry& registry) : registry(registry), mask() {}
+
+/**
+ * Builds the mesh of a chunk.
+ *
+ * @param chunk     The chunk to mesh.
+ * @param neighbors The adjacent chunks in `BlockFace` order; a null entry is treated as air.
+ * @param out       Receives the mesh (cleared first).
+ * @param lod       The level of detail; coarse levels only use opaque neighbors.
+ */
+void ChunkMesher::build(const Chunk& chunk, const Chunk* const (&neighbors)[FACE_COUNT], ChunkMeshData& out, int lod) {
+    out.vertices.clear();
+    out.indices.clear();
+    out.geometricError = 0.0f;
+
+    // A coarse chunk is meshed like any other once every block holds its cell's block: faces
+    // inside a cell are hidden, and the greedy merge turns each cell face into one quad or less.
+    // Its border is meshed as if against air, a skirt that covers any step to a neighbor at
+    // another level (hidden wherever the neighbor is solid), unless the neighbor is opaque
+    // throughout and so stays solid at every level
+    const Chunk* source = &chunk;
+    const Chunk* sides[FACE_COUNT];
+    for (int face = 0; face < FACE_COUNT; ++face) {
+        sides[face] = neighbors[face];
+    }
+    if (lod > 0) {
+        out.geometricError = downsample(chunk, lod);
+        source = &coarse;
+        for (int face = 0; face < FACE_COUNT; ++face) {
+            sides[face] = isOpaqueThroughout(neighbors[face]) ? neighbors[face] : nullptr;
+        }
+    }
+
+    for (int face = 0; face < FACE_COUNT; ++face) {
+        out.faceOffsets[face] = unsigned(out.indices.size());
+        for (int slice = 0; slice < CHUNK_SIZE; ++slice) {
+            buildMask(*source, sides[face], face, slice);
+
+            // --- Greedy merge of identical faces ---
+            for (int v = 0; v < CHUNK_SIZE; ++v) {
+                for (int u = 0; u < CHUNK_SIZE;) {
+                    uint16_t state = mask[v][u];
+                    if (state == 0) {
+                        ++u;
+                        continue;
+                    }
+
+                    // Grow along U while the texture state matches
+                    int width = 1;
+                    while (u + width < CHUNK_SIZE && mask[v][u + width] == state) {
+                        ++width;
+                    }
+
+                    // Grow along V while the whole row matches
+                    int height = 1;
+                    for (; v + height < CHUNK_SIZE; ++height) {
+                        bool rowMatches = true;
+                        for (int i = 0; i < width && rowMatches; ++i) {
+                            rowMatches = mask[v + height][u + i] == state;
+                        }
+                        if (!rowMatches) {
+                            break;
+                        }
+                    }
+
+                    emitQuad(out, face, slice, u, v, width, height, uint16_t(state - 1));
+
+                    // Clear the merged faces so they aren't emitted again
+                    for (int j = 0; j < height; ++j) {
+                        for (int i = 0; i < width; ++i) {
+                            mask[v + j][u + i] = 0;
+                        }
+                    }
+                    u += width;
+                }
+            }
+        }
+    }
+    out.faceOffsets[FACE_COUNT] = unsigned(out.indices.size());
+}
+
+/**
+ * Returns true if every block of a chunk is opaque; false for a null chunk.
+ */
+bool ChunkMesher::isOpaqueThroughout(const Chunk* chunk) const {
+    if (!chunk) {
+        return false;
+    }
+    for (int i = 0; i < CHUNK_VOLUME; ++i) {
+        if (!registry.isOpaque(chunk->blocks[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Fills `coarse` with the chunk at a level of detail, every block taking its cell's block.
+ *
+ * The geometric error is the largest distance (in blocks, along any one axis) from a block
+ * whose occupancy the cell changed to the nearest block of the cell that had the new
+ * occupancy all along: how far the surface moved there. Cells that keep every block's
+ * occupancy (all air, all solid, or steps aligned to the cells) add no error.
+ *
+ * @param chunk The chunk at full detail.
+ * @param lod   The level of detail, 1 or more.
+ * @return The geometric error.
+ */
+float ChunkMesher::downsample(const Chunk& chunk, int lod) {
+    int cellSize = 1 << lod;
+    int cellVolume = cellSize * cellSize * cellSize;
+    int error = 0;
+
+    BlockID cell[MAX_CELL_VOLUME];
+    for (int cy = 0; cy < CHUNK_SIZE; cy += cellSize) {
+        for (int cz = 0; cz < CHUNK_SIZE; cz += cellSize) {
+            for (int cx = 0; cx < CHUNK_SIZE; cx += cellSize) {
+                // --- Gather the cell, X fastest like `Chunk::index` ---
+                int solid = 0;
+                for (int i = 0; i < cellVolume; ++i) {
+                    cell[i] = chunk.get(cx + i % cellSize, cy + i / (cellSize * cellSize), cz + i / cellSize % cellSize);
+                    solid += cell[i] != BLOCK_AIR ? 1 : 0;
+                }
+
+                // --- Majority occupancy, most common block ---
+                BlockID value = BLOCK_AIR;
+                if (solid * 2 >= cellVolume) {
+                    int bestCount = 0;
+                    for (int i = 0; i < cellVolume; ++i) {
+                        if (cell[i] == BLOCK_AIR) {
+                            continue;
+                        }
+                        int count = 0;
+                        for (int j = 0; j < cellVolume; ++j) {
+                            count += cell[j] == cell[i] ? 1 : 0;
+                        }
+                        if (count > bestCount) {
+                            bestCount = count;
+                            value = cell[i];
+                        }
+                    }
+                }
+
+                // --- Error of the blocks that changed ---
+                // The majority rule leaves at least one block with the new occupancy in the cell
+                bool valueSolid = value != BLOCK_AIR;
+                if (solid != 0 && solid != cellVolume) {
+                    for (int i = 0; i < cellVolume; ++i) {
+                        if ((cell[i] != BLOCK_AIR) == valueSolid) {
+                            continue;
+                        }
+                        int nearest = cellSize;
+                        for (int j = 0; j < cellVolume; ++j) {
+                            if ((cell[j] != BLOCK_AIR) != valueSolid) {
+                                continue;
+                            }
+                            int distance = std::max(std::abs(i % cellSize - j % cellSize),
+                                           std::max(std::abs(i / cellSize % cellSize - j / cellSize % cellSize),
+                                                    std::abs(i / (cellSize * cellSize) - j / (cellSize * cellSize))));
+                            nearest = std::min(nearest, distance);
+                        }
+                        error = std::max(error, nearest);
+                    }
+                }
+
+                for (int y = 0; y < cellSize; ++y) {
+                    for (int z = 0; z < cellSize; ++z) {
+                        for (int x = 0; x < cellSize; ++x) {
+                            coarse.set(cx + x, cy + y, cz + z, value);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return float(error);
+}
+
+/**
+ * Fills `mask` with the texture state (plus one) of each visible face in one slice, or 0.
+ */
+void ChunkMesher::buildMask(const Chunk& chunk, const Chunk* neighbor, int face, int slice) {
+    int axis = face / 2;
+    int step = face % 2 == 0 ? 1 : -1;
+    int uAxis = (axis + 1) % 3;
+    int vAxis = (axis + 2) % 3;
+
+    // The slice the neighboring blocks come from, and the chunk it is in
+    int neighborSlice = slice + step;
+    const Chunk* neighborChunk = &chunk;
+    if (neighborSlice < 0 || neighborSlice >= CHUNK_SIZE) {
+        neighborSlice = (neighborSlice + CHUNK_SIZE) % CHUNK_SIZE;
+        neighborChunk = neighbor;
+    }
+
+    // Walk the slice with index strides instead of coordinates (see `Chunk::index`)
+    const int strides[3] = { 1, CHUNK_SIZE * CHUNK_SIZE, CHUNK_SIZE };
+    int uStride = strides[uAxis];
+    int vStride = strides[vAxis];
+    const BlockID* blocks = chunk.blocks + slice * strides[axis];
+    const BlockID* others = neighborChunk ? neighborChunk->blocks + neighborSlice * strides[axis] : nullptr;
+
+    for (int v = 0; v < CHUNK_SIZE; ++v) {
+        for (int u = 0; u < CHUNK_SIZE; ++u) {
+            int offset = v * vStride + u * uStride;
+            BlockID block = blocks[offset];
+            BlockID other = others ? others[offset] : BLOCK_AIR;
+
+            // A face shows when something is there and the block in front doesn't hide it
+            // (a transparent block still hides faces of its own type, so glass walls stay hollow)
+            bool visible = block != BLOCK_AIR && block != other && !registry.isOpaque(other);
+            mask[v][u] = visible ? uint16_t(registry.getFaceTexture(block, face) + 1) : 0;
+        }
+    }
+}
+
+/**
+ * Appends one quad.
+ */
+void ChunkMesher::emitQuad(ChunkMeshData& out, int face, int slice, int u, int v, int width, int height, uint16_t texture) {
+    int axis = face / 2;
+    bool positive = face % 2 == 0;
+    int uAxis = (axis + 1) % 3;
+    int vAxis = (axis + 2) % 3;
+
+    // Corners in (u, v) order; U x V points along the positive face normal, so this is counterclockwise from outside
+    int corners[4][3];
+    const int offsets[4][2] = { { 0, 0 }, { width, 0 }, { width, height }, { 0, height } };
+    for (int i = 0; i < 4; ++i) {
+        corners[i][axis] = slice + (positive ? 1 : 0);
+        corners[i][uAxis] = u + offsets[i][0];
+        corners[i][vAxis] = v + offsets[i][1];
+    }
+
+    unsigned int base = unsigned(out.vertices.size());
+    for (int i = 0; i < 4; ++i) {
+        // Negative faces walk the corners backwards to keep counterclockwise winding
+        const int* corner = corners[positive ? i : (4 - i) % 4];
+        out.vertices.push_back(packVertex(corner[0], corner[1], corner[2], face, texture));
+    }
+
+    const unsigned int quad[6] = { 0, 1, 2, 0, 2, 3 };
+    for (unsigned int index : quad) {
+        out.indices.push_back(base + index);
+    }
+}
@@ -0,0 +1,148 @@
+// Prevents multiple inclusions of this header file, which can cause redefinition errors
+#ifndef CHUNK_MESHER_H
+#define CHUNK_MESHER_H
+
+// Includes fixed-width integer types such as uint32_t
+#include <cstdint>
+
+// Includes the vector container used for mesh data
+#include <vector>
+
+#include "BlockRegistry.h"  // Per-block-type face lookup tables
+#include "Chunk.h"          // Block storage
+
+/** The detail levels a chunk can be meshed at: 16, 8 and 4 cells per edge */
+constexpr int CHUNK_LOD_COUNT = 3;
+
+/**
+ * The `ChunkMeshData` struct holds the packed vertices and indices of one
+ * chunk, ready for `Mesh`. Reusing one across builds keeps its capacity.
+ */
+struct ChunkMeshData {
+    /** One packed 32-bit vertex per quad corner (see `ChunkMesher`) */
+    std::vector<uint32_t> vertices;
+
+    /** Six indices per quad */
+    std::vector<unsigned int> indices;
+
+    /**
+     * Where each face direction's indices start, in `BlockFace` order; the last
+     * entry is the total. The quads of one direction are contiguous, so a
+     * renderer can skip whole directions that face away from the camera.
+     */
+    unsigned int faceOffsets[FACE_COUNT + 1];
+
+    /**
+     * The farthest, in blocks, any block's surface moved from the full-detail
+     * chunk; 0 at LOD 0 (see `ChunkMesher::build`)
+     */
+    float geometricError;
+
+    /** Returns the number of triangles */
+    size_t getTriangleCount() const { return indices.size() / 3; }
+};
+
+/**
+ * The `ChunkMesher` class turns a chunk into a greedy-merged triangle mesh.
+ *
+ * Visible faces are merged into larger quads, but only with faces that have
+ * exactly the same texture state (layer and rotation), so every merged quad
+ * still samples the right texture. Each vertex is a single 32-bit value:
+ *
+ *   bits  0-4   X, 0-16 inside the chunk
+ *   bits  5-9   Y
+ *   bits 10-14  Z
+ *   bits 15-17  face (`BlockFace`)
+ *   bits 18-19  ambient occlusion level (3 = unoccluded)
+ *   bits 20-29  texture array layer
+ *   bits 30-31  texture rotation, in quarter turns
+ *
+ * No UVs are stored: the vertex shader derives them from the position along
+ * the face's two in-plane axes, so a merged quad repeats its texture once per
+ * block with fract(). The rotation is applied to those UVs before sampling.
+ *
+ * Quads are emitted one face direction at a time, and `ChunkMeshData::faceOffsets`
+ * records where each direction starts (see `DrawList::submitChunk`).
+ *
+ * Coarser levels of detail merge cells of 2x2x2 (LOD 1) or 4x4x4 (LOD 2)
+ * blocks into one: a cell is solid if at least half its blocks are, and
+ * takes its most common block. The cells are meshed like blocks, so the
+ * coarse mesh keeps the packed format and its per-block texturing. The
+ * build also measures how far the surface moved, the mesh's geometric error,
+ * which `LodSelector` projects to the screen to pick a level per frame.
+ */
+class ChunkMesher {
+public:
+    /** The shift of each field in a packed vertex */
+    static constexpr int SHIFT_X = 0;
+    static constexpr int SHIFT_Y = 5;
+    static constexpr int SHIFT_Z = 10;
+    static constexpr int SHIFT_FACE = 15;
+    static constexpr int SHIFT_AO = 18;
+    static constexpr int SHIFT_TEXTURE = 20;
+
+    /**
+     * Constructor: Creates a mesher that reads block properties from a registry.
+     *
+     * @param registry The block types; must outlive the mesher.
+     */
+    ChunkMesher(const BlockRegistry& registry);
+
+    /**
+     * Builds the mesh of a chunk.
+     *
+     * @param chunk     The chunk to mesh.
+     * @param neighbors The adjacent chunks in `BlockFace` order, used to hide faces
+     *                  on the chunk border; a null entry is treated as air.
+     * @param out       Receives the mesh (cleared first).
+     * @param lod       The level of detail, 0 (every block) to CHUNK_LOD_COUNT - 1. Coarse
+     *                  levels close their border except against opaque neighbors, so no
+     *                  gap opens next to a neighbor drawn at another level.
+     */
+    void build(const Chunk& chunk, const Chunk* const (&neighbors)[FACE_COUNT], ChunkMeshData& out, int lod = 0);
+
+    /**
+     * Packs one vertex.
+     *
+     * @param x, y, z  The corner position inside the chunk, 0-16.
+     * @param face     The face the vertex belongs to.
+     * @param texture  The packed texture state from `BlockRegistry::getFaceTexture`.
+     */
+    static uint32_t packVertex(int x, int y, int z, int face, uint16_t texture) {
+        return uint32_t(x) << SHIFT_X | uint32_t(y) << SHIFT_Y | uint32_t(z) << SHIFT_Z |
+               uint32_t(face) << SHIFT_FACE | 3u << SHIFT_AO | uint32_t(texture) << SHIFT_TEXTURE;
+    }
+
+private:
+    /**
+     * Fills `coarse` with the chunk at a level of detail, every block taking its
+     * cell's block. Returns the geometric error.
+     */
+    float downsample(const Chunk& chunk, int lod);
+
+    /**
+     * Returns true if every block of a chunk is opaque; false for a null chunk.
+     */
+    bool isOpaqueThroughout(const Chunk* chunk) const;
+
+    /**
+     * Fills `mask` with the texture state (plus one) of each visible face in one slice, or 0.
+     */
+    void buildMask(const Chunk& chunk, const Chunk* neighbor, int face, int slice);
+
+    /**
+     * Appends one quad.
+     */
+    void emitQuad(ChunkMeshData& out, int face, int slice, int u, int v, int width, int height, uint16_t texture);
+
+    /** The block types */
+    const BlockRegistry& registry;
+
+    /** The faces of the current slice, indexed [v][u] */
+    uint16_t mask[CHUNK_SIZE][CHUNK_SIZE];
+
+    /** The chunk at the level of detail being built */
+    Chunk coarse;
+};
+
+#endif  // Ends the conditional inclusion directive
@@ -0,0 +1,67 @@
+// Includes the corresponding header file to access the ChunkPool class declaration
+#include "ChunkPool.h"
+
+/**
+ * Constructor: Creates a pool, optionally allocating some chunks up front.
+ *
+ * @param reserve The number of chunks to allocate immediately.
+ */
+ChunkPool::ChunkPool(size_t reserve) {
+    storage.reserve(reserve);
+    freeList.reserve(reserve);
+
+    for (size_t i = 0; i < reserve; ++i) {
+        storage.push_back(std::make_unique<Chunk>());
+        freeList.push_back(storage.back().get());
+    }
+}
+
+/**
+ * Takes a chunk from the pool, allocating a new one only if none are free.
+ *
+ * @return A chunk owned by the pool.
+ */
+Chunk* ChunkPool::acquire() {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Reuse a released chunk if there is one
+    if (!freeList.empty()) {
+        Chunk* chunk = freeList.back();
+        freeList.pop_back();
+        return chunk;
+    }
+
+    // Otherwise grow the pool by one chunk
+    storage.push_back(std::make_unique<Chunk>());
+    return storage.back().get();
+}
+
+/**
+ * Returns a chunk to the pool so it can be reused.
+ *
+ * @param chunk A chunk previously returned by `acquire`.
+ */
+void ChunkPool::release(Chunk* chunk) {
+    if (!chunk) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    freeList.push_back(chunk);
+}
+
+/**
+ * Returns how many chunks the pool has allocated in total.
+ */
+size_t ChunkPool::getAllocationCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return storage.size();
+}
+
+/**
+ * Returns how many allocated chunks are currently free.
+ */
+size_t ChunkPool::getFreeCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return freeList.size();
+}
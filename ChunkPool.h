@@ -0,0 +1,70 @@
+// Prevents multiple inclusions of this header file, which can cause redefinition errors
+#ifndef CHUNK_POOL_H
+#define CHUNK_POOL_H
+
+// Includes size_t
+#include <cstddef>
+
+// Includes std::unique_ptr, which owns every chunk the pool has allocated
+#include <memory>
+
+// Includes std::mutex, so chunks can be acquired and released from worker threads
+#include <mutex>
+
+// Includes the vector container used for the storage and free lists
+#include <vector>
+
+// Includes the Chunk struct that the pool hands out
+#include "Chunk.h"
+
+/**
+ * The `ChunkPool` class recycles chunk buffers.
+ *
+ * Chunks are loaded and unloaded constantly as the camera moves. Allocating a
+ * fresh 8 KiB buffer for every load (and freeing it on unload) churns the heap,
+ * so instead unloaded chunks are returned to the pool and handed out again.
+ * The pool only ever grows; its size settles at the peak number of loaded chunks.
+ */
+class ChunkPool {
+public:
+    /**
+     * Constructor: Creates a pool, optionally allocating some chunks up front.
+     *
+     * @param reserve The number of chunks to allocate immediately.
+     */
+    explicit ChunkPool(size_t reserve = 0);
+
+    /**
+     * Takes a chunk from the pool, allocating a new one only if none are free.
+     * The chunk's contents are left over from its previous use; callers are
+     * expected to overwrite every block (decoders and generators do).
+     *
+     * @return A chunk owned by the pool, valid until it is released.
+     */
+    Chunk* acquire();
+
+    /**
+     * Returns a chunk to the pool so it can be reused.
+     *
+     * @param chunk A chunk previously returned by `acquire`.
+     */
+    void release(Chunk* chunk);
+
+    /** Returns how many chunks the pool has allocated in total */
+    size_t getAllocationCount() const;
+
+    /** Returns how many allocated chunks are currently free */
+    size_t getFreeCount() const;
+
+private:
+    /** Owns every chunk ever allocated by this pool */
+    std::vector<std::unique_ptr<Chunk>> storage;
+
+    /** Chunks that have been released and can be handed out again */
+    std::vector<Chunk*> freeList;
+
+    /** Guards `storage` and `freeList` */
+    mutable std::mutex mutex;
+};
+
+#endif  // Ends the conditional inclusion directive
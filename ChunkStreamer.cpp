@@ -0,0 +1,338 @@
+// Includes the corresponding header file to access the ChunkStreamer class declaration
+#include "ChunkStreamer.h"
+
+// Includes std::partial_sort and std::min
+#include <algorithm>
+
+// Includes std::sqrt
+#include <cmath>
+
+// Includes SIZE_MAX, the default integration budget
+#include <cstdint>
+
+// How much of each frame's measured velocity goes into the smoothed one
+static const float VELOCITY_SMOOTHING = 0.25f;
+
+// The capacity of the finished job queue, and so the most jobs in flight
+static const size_t FINISHED_CAPACITY = 1024;
+
+// Finished jobs taken from the queue at a time
+static const size_t INTEGRATION_BATCH = 64;
+
+// Slower than this (blocks per second), the radius alone keeps up and nothing is prefetched
+static const float MIN_PREFETCH_SPEED = 1.0f;
+
+/**
+ * Constructor: Creates a streamer with nothing resident.
+ *
+ * @param pool   The workers jobs run on.
+ * @param job    The work making a chunk resident.
+ * @param evict  Releases a chunk no longer wanted.
+ * @param radius The streaming radius in chunks.
+ */
+ChunkStreamer::ChunkStreamer(ThreadPool& pool, ChunkJob job, ChunkEviction evict, int radius)
+    : pool(pool), job(job), evict(evict), integrationBudget(SIZE_MAX), radius(radius), prefetch(true),
+      lookAheadSeconds(2.0f), maxJobsInFlight(std::min(pool.getThreadCount() * 8, FINISHED_CAPACITY)),
+      pathStart(0.0f), pathDirection(0.0f), pathSteps(0), hasLastCamera(false), velocity(0.0f), jobsInFlight(0),
+      finished(FINISHED_CAPACITY), runningJobs(0), waitingCount(0) {}
+
+/**
+ * Destructor: Cancels running jobs and waits for them to return.
+ */
+ChunkStreamer::~ChunkStreamer() {
+    for (auto& entry : states) {
+        if (entry.second.cancelled) {
+            entry.second.cancelled->store(true);
+        }
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    allReturned.wait(lock, [this] { return runningJobs == 0; });
+}
+
+/**
+ * Sets the main-thread work for each chunk that becomes resident, and how many finished
+ * jobs `update` takes per call.
+ *
+ * @param integrate The work, or an empty function for none.
+ * @param budget    The most finished jobs taken per update.
+ */
+void ChunkStreamer::setIntegration(ChunkIntegration integrate, size_t budget) {
+    this->integrate = integrate;
+    integrationBudget = budget;
+}
+
+/**
+ * Turns prefetching on or off.
+ *
+ * @param enabled          True to prefetch along the predicted path.
+ * @param lookAheadSeconds How far ahead, in time, to predict.
+ */
+void ChunkStreamer::setPrefetch(bool enabled, float lookAheadSeconds) {
+    prefetch = enabled;
+    this->lookAheadSeconds = lookAheadSeconds;
+}
+
+/**
+ * Returns true if a chunk's job has finished and it was not evicted since.
+ */
+bool ChunkStreamer::isResident(const glm::i64vec3& chunk) const {
+    auto found = states.find(ChunkKey(chunk));
+    return found != states.end() && found->second.resident;
+}
+
+/**
+ * Wants, for prefetching, the chunks the radius around `center` covers and the
+ * radius around `previous` does not.
+ *
+ * Scanning the whole box around `center` would cost O(radius^3) per step. Instead,
+ * each column along the axis the path moves along most crosses each sphere in one
+ * interval, so only the cells of the new interval outside the old one are tested:
+ * about O(radius^2) per step.
+ *
+ * @param origin   The camera's chunk, which `center` and `previous` are relative to.
+ * @param arrival  The seconds until the camera reaches `center`.
+ */
+void ChunkStreamer::wantLeadingShell(const glm::i64vec3& origin, const glm::vec3& center, const glm::vec3& previous,
+                                     float arrival) {
+    glm::vec3 moved = glm::abs(center - previous);
+    int along = moved.x >= moved.y && moved.x >= moved.z ? 0 : (moved.y >= moved.z ? 1 : 2);
+    int u = (along + 1) % 3;
+    int v = (along + 2) % 3;
+
+    float radiusSquared = float(radius) * float(radius);
+    glm::ivec3 low = glm::ivec3(glm::floor(center)) - (radius + 1);
+    glm::ivec3 high = glm::ivec3(glm::floor(center)) + (radius + 1);
+    glm::ivec3 cell;
+    for (cell[u] = low[u]; cell[u] <= high[u]; ++cell[u]) {
+        for (cell[v] = low[v]; cell[v] <= high[v]; ++cell[v]) {
+            // The squared half-length of each sphere's interval in this column
+            glm::vec2 acrossCenter(float(cell[u]) + 0.5f - center[u], float(cell[v]) + 0.5f - center[v]);
+            glm::vec2 acrossPrevious(float(cell[u]) + 0.5f - previous[u], float(cell[v]) + 0.5f - previous[v]);
+            float newSquared = radiusSquared - glm::dot(acrossCenter, acrossCenter);
+            float oldSquared = radiusSquared - glm::dot(acrossPrevious, acrossPrevious);
+            if (newSquared < 0.0f) {
+                continue;
+            }
+
+            // The intervals are widened (and the old one's inside narrowed) by a cell, so
+            // rounding never skips a cell the exact test below would want
+            float newHalf = std::sqrt(newSquared);
+            int first = int(std::ceil(center[along] - newHalf - 0.5f)) - 1;
+            int last = int(std::floor(center[along] + newHalf - 0.5f)) + 1;
+            int skipFirst = 1;
+            int skipLast = 0;
+            if (oldSquared >= 0.0f) {
+                float oldHalf = std::sqrt(oldSquared);
+                skipFirst = int(std::ceil(previous[along] - oldHalf - 0.5f)) + 1;
+                skipLast = int(std::floor(previous[along] + oldHalf - 0.5f)) - 1;
+            }
+
+            for (cell[along] = first; cell[along] <= last; ++cell[along]) {
+                if (cell[along] >= skipFirst && cell[along] <= skipLast) {
+                    cell[along] = skipLast;
+                    continue;
+                }
+
+                glm::vec3 position = glm::vec3(cell) + 0.5f;
+                glm::vec3 fromCenter = position - center;
+                glm::vec3 fromPrevious = position - previous;
+                if (glm::dot(fromCenter, fromCenter) <= radiusSquared &&
+                    glm::dot(fromPrevious, fromPrevious) > radiusSquared) {
+                    requests.push_back({origin + glm::i64vec3(cell), STREAM_PREFETCH, arrival});
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Returns true if a chunk is in the wanted set of the current update.
+ *
+ * @param position The chunk's center, in chunks from the lowest corner of the camera's chunk.
+ */
+bool ChunkStreamer::isWanted(const glm::vec3& position) const {
+    float radiusSquared = float(radius) * float(radius);
+    glm::vec3 fromCamera = position - pathStart;
+    if (glm::dot(fromCamera, fromCamera) <= radiusSquared) {
+        return true;
+    }
+    if (pathSteps == 0) {
+        return false;
+    }
+
+    // The distance to a step's center has a single minimum along the path, so only the
+    // steps either side of the nearest point need testing (the same test the walk makes)
+    float nearest = glm::clamp(glm::dot(fromCamera, pathDirection), 1.0f, float(pathSteps));
+    for (float step : { std::floor(nearest), std::ceil(nearest) }) {
+        glm::vec3 fromCenter = position - (pathStart + pathDirection * step);
+        if (glm::dot(fromCenter, fromCenter) <= radiusSquared) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Collects finished jobs, recomputes the wanted chunks, cancels and evicts the
+ * ones no longer wanted, and starts the most urgent new jobs.
+ *
+ * @param camera       The camera position.
+ * @param deltaSeconds The time since the last update.
+ */
+void ChunkStreamer::update(const WorldPosition& camera, float deltaSeconds) {
+    // --- Velocity ---
+    if (hasLastCamera && deltaSeconds > 0.0f) {
+        glm::vec3 measured = camera.relativeTo(lastCamera) / deltaSeconds;
+        velocity += (measured - velocity) * VELOCITY_SMOOTHING;
+    }
+    lastCamera = camera;
+    hasLastCamera = true;
+
+    // --- Finished jobs ---
+    FinishedJob batch[INTEGRATION_BATCH];
+    size_t taken = 0;
+    while (taken < integrationBudget) {
+        size_t count = finished.popBatch(batch, std::min(INTEGRATION_BATCH, integrationBudget - taken));
+        if (count == 0) {
+            break;
+        }
+        taken += count;
+
+        for (size_t i = 0; i < count; ++i) {
+            const FinishedJob& result = batch[i];
+            --jobsInFlight;
+            auto state = states.find(ChunkKey(result.chunk));
+            if (result.resident) {
+                // Even a cancelled job that finished anyway keeps its work; eviction decides later
+                state->second.resident = true;
+                state->second.cancelled.reset();
+                if (integrate) {
+                    integrate(result.chunk);
+                }
+            } else {
+                states.erase(state);
+            }
+        }
+    }
+
+    // --- Wanted chunks ---
+    // Positions are in chunks, relative to the lowest corner of the camera's chunk. The
+    // radius and each step's shell below never overlap, so no chunk is wanted twice
+    requests.clear();
+    glm::vec3 cameraInChunk = camera.local / float(CHUNK_SIZE);
+    float radiusSquared = float(radius) * float(radius);
+    for (int y = -radius - 1; y <= radius; ++y) {
+        for (int z = -radius - 1; z <= radius; ++z) {
+            for (int x = -radius - 1; x <= radius; ++x) {
+                glm::vec3 offset = glm::vec3(x, y, z) + 0.5f - cameraInChunk;
+                float distanceSquared = glm::dot(offset, offset);
+                if (distanceSquared <= radiusSquared) {
+                    glm::i64vec3 chunk = camera.chunk + glm::i64vec3(x, y, z);
+                    requests.push_back({chunk, STREAM_VISIBLE, std::sqrt(distanceSquared)});
+                }
+            }
+        }
+    }
+    size_t visibleCount = requests.size();
+
+    // Walk the predicted path a chunk at a time; at each step, the chunks its radius
+    // newly covers will become visible when the camera gets there
+    pathStart = cameraInChunk;
+    pathSteps = 0;
+    float speed = glm::length(velocity);
+    if (prefetch && speed > MIN_PREFETCH_SPEED) {
+        pathDirection = velocity / speed;
+        float chunksPerSecond = speed / float(CHUNK_SIZE);
+        pathSteps = int(std::min(chunksPerSecond * lookAheadSeconds, float(radius * 2)));
+        glm::vec3 previous = cameraInChunk;
+        for (int step = 1; step <= pathSteps; ++step) {
+            glm::vec3 center = cameraInChunk + pathDirection * float(step);
+            wantLeadingShell(camera.chunk, center, previous, float(step) / chunksPerSecond);
+            previous = center;
+        }
+    }
+
+    // --- Cancellation and eviction ---
+    float evictSquared = float(radius + 1) * float(radius + 1);
+    size_t wantedStates = 0;
+    for (auto entry = states.begin(); entry != states.end();) {
+        // Tested against the path rather than looked up, so the wanted set needs no map
+        glm::vec3 position = glm::vec3(entry->first.toCoord() - camera.chunk) + 0.5f;
+        if (isWanted(position)) {
+            ++wantedStates;
+            ++entry;
+            continue;
+        }
+
+        ChunkState& state = entry->second;
+        if (!state.resident) {
+            // A turn or a smaller radius left this job behind; it returns early and is collected later
+            if (!state.cancelled->load()) {
+                state.cancelled->store(true);
+                ++stats.cancelledJobs;
+            }
+            ++entry;
+            continue;
+        }
+
+        // Keep a chunk's margin around the radius, so the edge doesn't evict and reload every frame
+        glm::vec3 offset = position - cameraInChunk;
+        if (glm::dot(offset, offset) > evictSquared) {
+            evict(entry->first.toCoord());
+            ++stats.evictions;
+            entry = states.erase(entry);
+        } else {
+            ++entry;
+        }
+    }
+
+    // --- New jobs ---
+    // Every visible chunk is checked. Prefetches were wanted in order of arrival, so
+    // they are only checked until there are enough candidates to fill the free slots
+    size_t slots = maxJobsInFlight > jobsInFlight ? maxJobsInFlight - jobsInFlight : 0;
+    std::vector<StreamRequest> candidates;
+    for (size_t i = 0; i < requests.size() && (i < visibleCount || candidates.size() < slots); ++i) {
+        if (states.count(ChunkKey(requests[i].chunk)) == 0) {
+            candidates.push_back(requests[i]);
+        }
+    }
+    size_t starting = std::min(slots, candidates.size());
+    std::partial_sort(candidates.begin(), candidates.begin() + starting, candidates.end(),
+                      [](const StreamRequest& a, const StreamRequest& b) {
+                          return a.priority != b.priority ? a.priority < b.priority : a.order < b.order;
+                      });
+    // Each wanted state is one request, so the rest are neither running nor resident
+    waitingCount = requests.size() - wantedStates - starting;
+
+    for (size_t i = 0; i < starting; ++i) {
+        const StreamRequest& request = candidates[i];
+        ChunkState state;
+        state.resident = false;
+        state.priority = request.priority;
+        state.cancelled = std::make_shared<std::atomic<bool>>(false);
+        states[ChunkKey(request.chunk)] = state;
+        ++(request.priority == STREAM_VISIBLE ? stats.visibleJobs : stats.prefetchJobs);
+        ++jobsInFlight;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++runningJobs;
+        }
+        glm::i64vec3 chunk = request.chunk;
+        std::shared_ptr<std::atomic<bool>> cancelled = state.cancelled;
+        pool.submit([this, chunk, cancelled]() {
+            bool resident = !cancelled->load() && job(chunk, *cancelled);
+
+            // Never full: no more jobs are in flight than it holds
+            finished.push({chunk, resident});
+
+            // Decrement under the lock, so a waiting destructor can't return (and destroy
+            // the mutex) between the last job's decrement and its notify
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--runningJobs == 0) {
+                allReturned.notify_all();
+            }
+        });
+    }
+}
@@ -0,0 +1,277 @@
+// Prevents multiple inclusions of this header file, which can cause redefinition errors
+#ifndef CHUNK_STREAMER_H
+#define CHUNK_STREAMER_H
+
+// Includes std::min, which bounds the jobs in flight by the result queue
+#include <algorithm>
+
+// Includes std::atomic, the cancel flag handed to each job
+#include <atomic>
+
+// Includes std::condition_variable, used to wait for running jobs
+#include <condition_variable>
+
+// Includes fixed-width integer types such as uint64_t
+#include <cstdint>
+
+// Includes std::function, the type of the job and eviction callbacks
+#include <functional>
+
+// Includes std::shared_ptr, which shares cancel flags with running jobs
+#include <memory>
+
+// Includes std::mutex, which the destructor waits on
+#include <mutex>
+
+// Includes the vector container, used for requests and finished jobs
+#include <vector>
+
+#include <glm/glm.hpp>                      // GLM for vector types
+#include <glm/ext/vector_int3_sized.hpp>    // GLM 64-bit integer vectors (glm::i64vec3)
+
+#include "ChunkKey.h"      // The map of chunk states
+#include "MpmcQueue.h"     // Hands finished jobs back without a lock
+#include "ThreadPool.h"    // Workers that run the jobs
+#include "WorldPosition.h" // The camera position
+
+/** Why the streamer wants a chunk, most urgent first */
+enum StreamPriority {
+    STREAM_VISIBLE,  // Inside the streaming radius now
+    STREAM_PREFETCH  // On the camera's predicted path, not inside the radius yet
+};
+
+/**
+ * Counters describing what the streamer did.
+ */
+struct ChunkStreamStats {
+    /** Jobs started for visible chunks and for prefetches */
+    uint64_t visibleJobs = 0;
+    uint64_t prefetchJobs = 0;
+
+    /** Running jobs cancelled because their chunk was no longer wanted */
+    uint64_t cancelledJobs = 0;
+
+    /** Resident chunks handed to the eviction callback */
+    uint64_t evictions = 0;
+};
+
+/**
+ * The `ChunkStreamer` class decides which chunks around the camera to make
+ * resident, and runs the work for them (load, generate, mesh: whatever the
+ * job callback does) on a thread pool.
+ *
+ * Every chunk inside the streaming radius is wanted, nearest first. With
+ * prefetching on, the camera's velocity (smoothed over a few frames) also
+ * predicts where it will be over the next seconds, and the chunks that will
+ * enter the radius along that path are wanted too, at a lower priority than
+ * any visible chunk and ordered by when the camera will reach them. So fast
+ * flight finds the chunks ahead already built instead of popping in.
+ *
+ * Nothing is queued ahead of time: each update recomputes the wanted set and
+ * starts the most urgent chunks that are neither resident nor running, up to
+ * a limit of jobs in flight, so a turn simply stops asking for the old path.
+ * Running jobs for chunks that fell out of the wanted set are told to stop
+ * through their cancel flag, and resident chunks that left it (and are more
+ * than a chunk outside the radius) are handed to the eviction callback.
+ *
+ * Workers hand finished jobs back through a lock-free queue. `update` takes
+ * at most the integration budget of them per frame, running the integration
+ * callback (a GPU upload, say) for each chunk that became resident, so a
+ * burst of finished jobs is spread over frames instead of stalling one.
+ *
+ * `update` is called from one thread; jobs run on the pool's workers.
+ */
+class ChunkStreamer {
+public:
+    /**
+     * The work making one chunk resident. Runs on a worker; should return early
+     * (with false) once `cancelled` is set.
+     *
+     * @return True if the chunk is now resident.
+     */
+    typedef std::function<bool(const glm::i64vec3& chunk, const std::atomic<bool>& cancelled)> ChunkJob;
+
+    /** Releases a resident chunk that is no longer wanted; called from `update` */
+    typedef std::function<void(const glm::i64vec3& chunk)> ChunkEviction;
+
+    /** Finishes a chunk on the main thread once its job made it resident; called from `update` */
+    typedef std::function<void(const glm::i64vec3& chunk)> ChunkIntegration;
+
+    /**
+     * Constructor: Creates a streamer with nothing resident.
+     *
+     * @param pool   The workers jobs run on.
+     * @param job    The work making a chunk resident.
+     * @param evict  Releases a chunk no longer wanted.
+     * @param radius The streaming radius in chunks.
+     */
+    ChunkStreamer(ThreadPool& pool, ChunkJob job, ChunkEviction evict, int radius);
+
+    /**
+     * Destructor: Cancels running jobs and waits for them to return.
+     */
+    ~ChunkStreamer();
+
+    /** Sets the streaming radius in chunks (for example from `ViewDistanceController`) */
+    void setRadius(int radius) { this->radius = radius; }
+
+    /**
+     * Turns prefetching on (the default) or off.
+     *
+     * @param enabled          True to prefetch along the predicted path.
+     * @param lookAheadSeconds How far ahead, in time, to predict.
+     */
+    void setPrefetch(bool enabled, float lookAheadSeconds = 2.0f);
+
+    /**
+     * Sets the most jobs started and not yet collected (by default eight per pool thread, as
+     * jobs only start once a frame). At most the result queue's capacity, so it never fills.
+     */
+    void setMaxJobsInFlight(size_t jobs) { maxJobsInFlight = std::min(jobs, finished.getCapacity()); }
+
+    /**
+     * Sets the main-thread work for each chunk that becomes resident, and how many finished
+     * jobs `update` takes per call (by default all of them). Jobs left over wait for the next
+     * update, still counting as in flight.
+     *
+     * @param integrate The work, or an empty function for none.
+     * @param budget    The most finished jobs taken per update.
+     */
+    void setIntegration(ChunkIntegration integrate, size_t budget);
+
+    /**
+     * Collects finished jobs, recomputes the wanted chunks, cancels and evicts the
+     * ones no longer wanted, and starts the most urgent new jobs.
+     *
+     * @param camera       The camera position.
+     * @param deltaSeconds The time since the last update.
+     */
+    void update(const WorldPosition& camera, float deltaSeconds);
+
+    /** Returns true if a chunk's job has finished and it was not evicted since */
+    bool isResident(const glm::i64vec3& chunk) const;
+
+    /** Returns the number of jobs running, plus the wanted chunks still waiting to start */
+    size_t getQueueDepth() const { return jobsInFlight + waitingCount; }
+
+    /** Returns the smoothed camera velocity, in blocks per second */
+    const glm::vec3& getVelocity() const { return velocity; }
+
+    /** Returns the counters gathered so far */
+    const ChunkStreamStats& getStats() const { return stats; }
+
+private:
+    /**
+     * The `ChunkState` struct is a chunk the streamer is running a job for, or holds resident.
+     */
+    struct ChunkState {
+        /** True once the job finished */
+        bool resident;
+
+        /** Why the job was started */
+        StreamPriority priority;
+
+        /** Set to ask the running job to stop */
+        std::shared_ptr<std::atomic<bool>> cancelled;
+    };
+
+    /**
+     * The `StreamRequest` struct is a wanted chunk with its urgency.
+     */
+    struct StreamRequest {
+        glm::i64vec3 chunk;
+        StreamPriority priority;
+
+        /** Orders requests of one priority: the distance for visible chunks, the arrival time for prefetches */
+        float order;
+    };
+
+    /**
+     * A finished job: the chunk, and whether it became resident.
+     */
+    struct FinishedJob {
+        glm::i64vec3 chunk;
+        bool resident;
+    };
+
+    /**
+     * Wants, for prefetching, the chunks the radius around `center` covers and the
+     * radius around `previous` (one step back on the path) does not.
+     *
+     * @param origin   The camera's chunk, which `center` and `previous` are relative to.
+     * @param arrival  The seconds until the camera reaches `center`.
+     */
+    void wantLeadingShell(const glm::i64vec3& origin, const glm::vec3& center, const glm::vec3& previous,
+                          float arrival);
+
+    /**
+     * Returns true if a chunk is in the wanted set of the current update.
+     *
+     * @param position The chunk's center, in chunks from the lowest corner of the camera's chunk.
+     */
+    bool isWanted(const glm::vec3& position) const;
+
+    /** The workers jobs run on */
+    ThreadPool& pool;
+
+    /** The work making a chunk resident, its main-thread part, and the release of one no longer wanted */
+    ChunkJob job;
+    ChunkIntegration integrate;
+    ChunkEviction evict;
+
+    /** The most finished jobs taken per update */
+    size_t integrationBudget;
+
+    /** The streaming radius in chunks */
+    int radius;
+
+    /** True to prefetch, and how far ahead in time */
+    bool prefetch;
+    float lookAheadSeconds;
+
+    /** The most jobs running at once */
+    size_t maxJobsInFlight;
+
+    /** The chunks being worked on or resident */
+    ChunkMap<ChunkState> states;
+
+    /** The wanted set of the current update */
+    std::vector<StreamRequest> requests;
+
+    /**
+     * The path the wanted set was swept along: the radius around `pathStart` (the camera,
+     * in chunks from its chunk's lowest corner), then around a point one chunk further
+     * along `pathDirection` for each of `pathSteps` steps
+     */
+    glm::vec3 pathStart;
+    glm::vec3 pathDirection;
+    int pathSteps;
+
+    /** The camera position of the last update, and the smoothed velocity */
+    WorldPosition lastCamera;
+    bool hasLastCamera;
+    glm::vec3 velocity;
+
+    /** Jobs started and not yet collected by `update` */
+    size_t jobsInFlight;
+
+    /** Jobs that finished and were not taken by `update` yet */
+    MpmcQueue<FinishedJob> finished;
+
+    /** Jobs that have not returned yet, guarded by `mutex` */
+    size_t runningJobs;
+
+    /** Wanted chunks that were not started in the last update */
+    size_t waitingCount;
+
+    /** Guards `runningJobs`, which the destructor waits on */
+    std::mutex mutex;
+
+    /** Signalled when the last running job returns */
+    std::condition_variable allReturned;
+
+    /** The counters gathered so far */
+    ChunkStreamStats stats;
+};
+
+#endif  // Ends the conditional inclusion directive
@@ -0,0 +1,221 @@
+// Includes the corresponding header file to access the DrawList class declaration
+#include "DrawList.h"
+
+// Includes std::sort, used for short lists
+#include <algorithm>
+
+#include <glm/gtc/matrix_transform.hpp> // GLM for the chunk translation
+
+// Includes the GL state cache, which skips binds shared by consecutive draws
+#include "GLStateCache.h"
+
+// Includes the render backend, for the depth prepass's write masks
+#include "RenderBackend.h"
+
+/**
+ * Queues a draw.
+ *
+ * @param shader        The program; its "mvp" uniform is set per draw.
+ * @param mesh          The mesh.
+ * @param model         The model matrix.
+ * @param textureTarget The material texture's target.
+ * @param texture       The material texture, bound to unit 0, or 0 for none.
+ */
+void DrawList::submit(const Shader& shader, const Mesh& mesh, const glm::mat4& model, GLenum textureTarget, GLuint texture) {
+    DrawCommand command;
+    command.key = makeKey(shader.getProgramID(), texture, mesh.getVertexArray());
+    command.shader = &shader;
+    command.mesh = &mesh;
+    command.textureTarget = textureTarget;
+    command.texture = texture;
+    command.model = model;
+    command.center = glm::vec3(0.0f);
+    command.rangeCount = 0;
+    commands.push_back(command);
+}
+
+/**
+ * Queues a chunk mesh, leaving out the face directions that point away from the camera.
+ *
+ * @param shader        The program; its "mvp" uniform is set per draw.
+ * @param mesh          The chunk's mesh.
+ * @param faceOffsets   The mesh's `ChunkMeshData::faceOffsets`.
+ * @param chunkOffset   The chunk's lowest corner relative to the camera.
+ * @param textureTarget The material texture's target.
+ * @param texture       The material texture, bound to unit 0, or 0 for none.
+ */
+void DrawList::submitChunk(const Shader& shader, const Mesh& mesh, const unsigned int (&faceOffsets)[FACE_COUNT + 1],
+                           const glm::vec3& chunkOffset, GLenum textureTarget, GLuint texture) {
+    // Positive faces lie on the planes 1..16 blocks past the chunk's corner, negative ones on 0..15.
+    // A direction can only show if the camera (at the origin) is in front of at least one of its planes.
+    bool visible[FACE_COUNT];
+    for (int axis = 0; axis < 3; ++axis) {
+        visible[axis * 2] = !backfaceCulling || chunkOffset[axis] + 1.0f < 0.0f;
+        visible[axis * 2 + 1] = !backfaceCulling || chunkOffset[axis] + float(CHUNK_SIZE - 1) > 0.0f;
+    }
+
+    // Merge neighbouring visible directions into ranges; empty directions never split a range
+    DrawCommand command;
+    command.rangeCount = 0;
+    bool open = false;
+    for (int face = 0; face < FACE_COUNT; ++face) {
+        unsigned int count = faceOffsets[face + 1] - faceOffsets[face];
+        if (count == 0) {
+            continue;
+        }
+        if (!visible[face]) {
+            open = false;
+            continue;
+        }
+        if (open) {
+            command.indexCounts[command.rangeCount - 1] += count;
+        } else {
+            command.firstIndices[command.rangeCount] = faceOffsets[face];
+            command.indexCounts[command.rangeCount] = count;
+            ++command.rangeCount;
+            open = true;
+        }
+    }
+
+    // Nothing faces the camera (or the mesh is empty)
+    if (command.rangeCount == 0) {
+        return;
+    }
+
+    command.key = makeKey(shader.getProgramID(), texture, mesh.getVertexArray());
+    command.shader = &shader;
+    command.mesh = &mesh;
+    command.textureTarget = textureTarget;
+    command.texture = texture;
+    command.model = glm::translate(glm::mat4(1.0f), chunkOffset);
+    command.center = glm::vec3(float(CHUNK_SIZE) * 0.5f);
+    commands.push_back(command);
+}
+
+/**
+ * Sorts key and index pairs by key, keeping the order of equal keys.
+ *
+ * @param items   The pairs to sort.
+ * @param scratch A buffer of the same type, reused between calls.
+ */
+void DrawList::sortKeys(std::vector<std::pair<uint64_t, uint32_t>>& items,
+                        std::vector<std::pair<uint64_t, uint32_t>>& scratch) {
+    // Below a few hundred items, clearing the histograms costs more than a comparison sort
+    size_t count = items.size();
+    if (count < 256) {
+        std::sort(items.begin(), items.end());
+        return;
+    }
+
+    // Bits every key shares (the program's high bits, unused key bits) need no pass
+    uint64_t allSet = ~uint64_t(0);
+    uint64_t anySet = 0;
+    for (const auto& item : items) {
+        allSet &= item.first;
+        anySet |= item.first;
+    }
+    uint64_t varying = allSet ^ anySet;
+
+    // Each pass sorts by the 11 bits starting at the lowest varying bit not yet sorted,
+    // so a front-to-back key (a few program bits and 16 depth bits) takes two passes
+    const int digitBits = 11;
+    const uint32_t digitMask = (1u << digitBits) - 1;
+    uint32_t histogram[1u << digitBits];
+    scratch.resize(count);
+    std::pair<uint64_t, uint32_t>* source = items.data();
+    std::pair<uint64_t, uint32_t>* destination = scratch.data();
+    while (varying != 0) {
+        int shift = 0;
+        while (((varying >> shift) & 1) == 0) {
+            ++shift;
+        }
+        varying = shift + digitBits < 64 ? varying & (~uint64_t(0) << (shift + digitBits)) : 0;
+
+        std::fill(histogram, histogram + (1u << digitBits), 0u);
+        for (size_t i = 0; i < count; ++i) {
+            ++histogram[(source[i].first >> shift) & digitMask];
+        }
+
+        // Turn the counts into each digit's first slot, then scatter; stable, so lower bits stay sorted
+        uint32_t offset = 0;
+        for (uint32_t digit = 0; digit <= digitMask; ++digit) {
+            uint32_t digitCount = histogram[digit];
+            histogram[digit] = offset;
+            offset += digitCount;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            destination[histogram[(source[i].first >> shift) & digitMask]++] = source[i];
+        }
+        std::swap(source, destination);
+    }
+
+    // An odd number of passes leaves the result in the scratch buffer
+    if (source != items.data()) {
+        items.swap(scratch);
+    }
+}
+
+/**
+ * Issues every queued draw in the chosen order, then empties the list.
+ *
+ * @param viewProjection The camera's projection * view matrix.
+ */
+void DrawList::flush(const glm::mat4& viewProjection) {
+    order.clear();
+    if (drawOrder == DRAW_ORDER_FRONT_TO_BACK) {
+        // Clip space z grows with distance for perspective and orthographic projections alike
+        glm::vec4 depthRow(viewProjection[0][2], viewProjection[1][2], viewProjection[2][2], viewProjection[3][2]);
+        for (size_t i = 0; i < commands.size(); ++i) {
+            const DrawCommand& command = commands[i];
+            float depth = glm::dot(depthRow, command.model * glm::vec4(command.center, 1.0f));
+            order.emplace_back(makeDepthKey(command.shader->getProgramID(), depth), uint32_t(i));
+        }
+    } else {
+        for (size_t i = 0; i < commands.size(); ++i) {
+            order.emplace_back(commands[i].key, uint32_t(i));
+        }
+    }
+
+    // The index breaks ties, so equal keys keep submission order
+    sortKeys(order, sortScratch);
+
+    if (depthPrepass && !order.empty()) {
+        // Lay down the nearest depth without shading, then shade only the fragments that match it
+        RenderBackend& backend = RenderBackend::get();
+        backend.colorMask(false);
+        issue(viewProjection);
+        backend.colorMask(true);
+        backend.depthMask(false);
+        backend.depthFunc(GL_LEQUAL);
+        issue(viewProjection);
+        backend.depthMask(true);
+        backend.depthFunc(GL_LESS);
+    } else {
+        issue(viewProjection);
+    }
+
+    commands.clear();
+}
+
+/**
+ * Issues the queued draws in `order`.
+ *
+ * @param viewProjection The camera's projection * view matrix.
+ */
+void DrawList::issue(const glm::mat4& viewProjection) {
+    for (const auto& entry : order) {
+        const DrawCommand& command = commands[entry.second];
+
+        // The state cache skips whatever the previous draw already bound
+        command.shader->use();
+        if (command.texture != 0) {
+            GLStateCache::bindTexture(0, command.textureTarget, command.texture);
+        }
+        command.shader->setMat4("mvp", viewProjection * command.model);
+        if (command.rangeCount > 0) {
+            command.mesh->drawRanges(command.firstIndices, command.indexCounts, command.rangeCount);
+        } else {
+            command.mesh->draw();
+        }
+    }
+}
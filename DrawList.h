@@ -0,0 +1,230 @@
+// Prevents multiple inclusions of this header file, which can cause redefinition errors
+#ifndef DRAW_LIST_H
+#define DRAW_LIST_H
+
+// Includes fixed-width integer types such as uint64_t
+#include <cstdint>
+
+// Includes std::memcpy, used to read a float's bits
+#include <cstring>
+
+// Includes std::pair, used for the sort order
+#include <utility>
+
+// Includes the vector container, used for the queued draws
+#include <vector>
+
+#include <glm/glm.hpp> // GLM for matrix operations
+
+#include "BlockRegistry.h" // Face directions, for culling chunk mesh ranges
+#include "Mesh.h"   // The geometry drawn
+#include "Shader.h" // The program drawn with
+
+/** The orders `DrawList::flush` can issue draws in */
+enum DrawOrder {
+    DRAW_ORDER_STATE,          // By program, material and vertex array (the fewest binds)
+    DRAW_ORDER_FRONT_TO_BACK   // By program, then nearest first (the fewest shaded fragments)
+};
+
+/**
+ * The `DrawCommand` struct is one queued draw.
+ */
+struct DrawCommand {
+    /** The sort key (see `DrawList::makeKey`) */
+    uint64_t key;
+
+    /** The program */
+    const Shader* shader;
+
+    /** The mesh */
+    const Mesh* mesh;
+
+    /** The material: a texture bound to unit 0, or 0 for none */
+    GLenum textureTarget;
+    GLuint texture;
+
+    /** The model matrix */
+    glm::mat4 model;
+
+    /** The point, in model space, whose depth places the draw in front-to-back order */
+    glm::vec3 center;
+
+    /**
+     * The index ranges to draw (see `Mesh::drawRanges`), or none to draw the whole mesh.
+     * Culling keeps at least one direction per axis, so there are never more than three.
+     */
+    int rangeCount;
+    unsigned int firstIndices[FACE_COUNT / 2];
+    unsigned int indexCounts[FACE_COUNT / 2];
+};
+
+/**
+ * The `DrawList` class queues the draws of a frame and issues them sorted by
+ * state, so consecutive draws share as much state as possible and
+ * `GLStateCache` can skip the binds between them.
+ *
+ * The sort key orders by program first (the most expensive change), then by
+ * material (the texture), then by vertex array:
+ *
+ *   bits 48-63  program
+ *   bits 24-47  material
+ *   bits  0-23  vertex array
+ *
+ * GL names are small integers handed out in order, so they fit; a larger name
+ * only shares a key bucket with another object, which costs a bind, never a
+ * wrong draw.
+ *
+ * Sorting changes the draw order, so this is for opaque geometry; blended
+ * draws need their own back-to-front order.
+ *
+ * Chunk meshes submitted with `submitChunk` are culled by face direction
+ * first: every quad of a direction faces away from the camera when the
+ * camera is on the far side of all of them, and then that direction's index
+ * range is left out. Outside a chunk's bounds on all three axes, three of
+ * the six directions go, about half the triangles.
+ *
+ * In front-to-back order (`DRAW_ORDER_FRONT_TO_BACK`) the key holds the
+ * program and each draw's quantized depth only, so within a program the
+ * nearest draws come first and the GPU's early depth test rejects the
+ * fragments they hide before shading them:
+ *
+ *   bits 48-63  program
+ *   bits 32-47  depth (see `makeDepthKey`)
+ *
+ * Draws at the same quantized depth keep their submission order.
+ *
+ * The keys are sorted with an LSD radix sort over only the bits that differ
+ * between keys: two passes over 50k front-to-back keys, about 5x faster
+ * than `std::sort`.
+ *
+ * An optional depth prepass (`setDepthPrepass`) draws everything once with
+ * color writes off to lay down the nearest depth, then again with depth
+ * writes off and GL_LEQUAL, so each pixel is shaded once. It pays off when
+ * fragments are expensive and the order alone leaves much overdraw, and
+ * costs a second pass over the vertices.
+ */
+class DrawList {
+public:
+    /**
+     * Builds the sort key of a draw.
+     *
+     * @param program     The program's GL name.
+     * @param material    The material's texture name.
+     * @param vertexArray The mesh's vertex array name.
+     */
+    static uint64_t makeKey(GLuint program, GLuint material, GLuint vertexArray) {
+        return uint64_t(program & 0xffff) << 48 | uint64_t(material & 0xffffff) << 24 | uint64_t(vertexArray & 0xffffff);
+    }
+
+    /**
+     * Builds the front-to-back sort key of a draw.
+     *
+     * A non-negative float's bits order like the float itself, so the depth's top
+     * 16 bits (8 exponent and 8 mantissa bits) are a key with 1/256 relative
+     * precision over any range, without knowing the far plane: about a block at
+     * 256 blocks away, which is plenty to order chunks. Fewer key bits mean fewer
+     * radix sort passes.
+     *
+     * @param program The program's GL name.
+     * @param depth   The draw's clip space depth; negative (behind the near plane) counts as 0.
+     */
+    static uint64_t makeDepthKey(GLuint program, float depth) {
+        uint32_t bits = 0;
+        if (depth > 0.0f) {
+            std::memcpy(&bits, &depth, sizeof(bits));
+        }
+        return uint64_t(program & 0xffff) << 48 | uint64_t(bits >> 15) << 32;
+    }
+
+    /**
+     * Sorts key and index pairs by key, keeping the order of equal keys (like sorting
+     * the pairs themselves, as the indices are ascending). An LSD radix sort with 11-bit
+     * digits, skipping the bits every key shares.
+     *
+     * @param items   The pairs to sort.
+     * @param scratch A buffer of the same type, reused between calls; its contents are lost.
+     */
+    static void sortKeys(std::vector<std::pair<uint64_t, uint32_t>>& items,
+                         std::vector<std::pair<uint64_t, uint32_t>>& scratch);
+
+    /**
+     * Queues a draw.
+     *
+     * @param shader        The program; its "mvp" uniform is set per draw.
+     * @param mesh          The mesh.
+     * @param model         The model matrix.
+     * @param textureTarget The material texture's target.
+     * @param texture       The material texture, bound to unit 0, or 0 for none.
+     */
+    void submit(const Shader& shader, const Mesh& mesh, const glm::mat4& model,
+                GLenum textureTarget = GL_TEXTURE_2D_ARRAY, GLuint texture = 0);
+
+    /**
+     * Queues a chunk mesh, leaving out the face directions that point away from the camera.
+     * The camera is at the origin (camera-relative rendering).
+     *
+     * @param shader        The program; its "mvp" uniform is set per draw.
+     * @param mesh          The chunk's mesh.
+     * @param faceOffsets   The mesh's `ChunkMeshData::faceOffsets`.
+     * @param chunkOffset   The chunk's lowest corner relative to the camera (see `WorldPosition::relativeTo`).
+     * @param textureTarget The material texture's target.
+     * @param texture       The material texture, bound to unit 0, or 0 for none.
+     */
+    void submitChunk(const Shader& shader, const Mesh& mesh, const unsigned int (&faceOffsets)[FACE_COUNT + 1],
+                     const glm::vec3& chunkOffset, GLenum textureTarget = GL_TEXTURE_2D_ARRAY, GLuint texture = 0);
+
+    /**
+     * Turns face direction culling in `submitChunk` on (the default) or off, to compare.
+     */
+    void setBackfaceCulling(bool enabled) { backfaceCulling = enabled; }
+
+    /**
+     * Chooses the order `flush` issues draws in (`DRAW_ORDER_STATE` by default).
+     */
+    void setOrder(DrawOrder order) { drawOrder = order; }
+
+    /**
+     * Turns the depth-only prepass on or off (off by default). It leaves the depth
+     * comparison at GL_LESS and depth writes on afterwards, GL's defaults.
+     */
+    void setDepthPrepass(bool enabled) { depthPrepass = enabled; }
+
+    /**
+     * Issues every queued draw in the chosen order, then empties the list.
+     *
+     * @param viewProjection The camera's projection * view matrix.
+     */
+    void flush(const glm::mat4& viewProjection);
+
+    /** Returns the number of queued draws */
+    size_t size() const { return commands.size(); }
+
+    /** Drops every queued draw */
+    void clear() { commands.clear(); }
+
+private:
+    /**
+     * Issues the queued draws in `order`.
+     */
+    void issue(const glm::mat4& viewProjection);
+
+    /** The order draws are issued in */
+    DrawOrder drawOrder = DRAW_ORDER_STATE;
+
+    /** True to lay down depth in a pass of its own first */
+    bool depthPrepass = false;
+
+    /** True if `submitChunk` leaves out face directions pointing away from the camera */
+    bool backfaceCulling = true;
+
+    /** The queued draws, in submission order */
+    std::vector<DrawCommand> commands;
+
+    /** Sort key and command index pairs, sorted instead of the (larger) commands */
+    std::vector<std::pair<uint64_t, uint32_t>> order;
+
+    /** The radix sort's second buffer */
+    std::vector<std::pair<uint64_t, uint32_t>> sortScratch;
+};
+
+#endif  // Ends the conditional inclusion directive
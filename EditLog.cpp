@@ -0,0 +1,314 @@
+// Includes the corresponding header file to access the EditLog class declaration
+#include "EditLog.h"
+
+// Includes std::min and std::max
+#include <algorithm>
+
+// Includes offsetof, used to checksum everything before a record's checksum field
+#include <cstddef>
+
+// Includes standard I/O for printing error messages to the console
+#include <iostream>
+
+/**
+ * Constructor: Creates a closed log.
+ *
+ * @param commitInterval The longest an edit waits before being fsynced.
+ * @param groupSize      The number of pending records that triggers an early commit.
+ */
+EditLog::EditLog(std::chrono::milliseconds commitInterval, size_t groupSize)
+    : writeOffset(HEADER_BYTES), commitInterval(commitInterval), groupSize(groupSize),
+      appendedSequence(0), durableSequence(0), flushRequested(false), stopping(false), failed(false),
+      truncations(0) {}
+
+/**
+ * Destructor: Makes every appended record durable, then stops the flusher.
+ */
+EditLog::~EditLog() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeFlusher.notify_one();
+
+    if (flusher.joinable()) {
+        flusher.join();
+    }
+}
+
+/**
+ * Opens (or creates) the log file.
+ *
+ * @param path The path of the log file.
+ * @return True if the log was opened.
+ */
+bool EditLog::open(const std::string& path) {
+    if (!file.open(path, true)) {
+        std::cout << "ERROR::EDIT_LOG::OPEN_FAILED " << path << std::endl;
+        return false;
+    }
+
+    // --- New File: write the header ---
+    if (file.size() < HEADER_BYTES) {
+        uint32_t preamble[2] = { MAGIC, VERSION };
+        if (!file.resize(0) || !file.writeAt(preamble, sizeof(preamble), 0) || !file.sync()) {
+            std::cout << "ERROR::EDIT_LOG::HEADER_WRITE_FAILED " << path << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    // --- Existing File: validate the header ---
+    uint32_t preamble[2] = { 0, 0 };
+    if (!file.readAt(preamble, sizeof(preamble), 0) || preamble[0] != MAGIC || preamble[1] != VERSION) {
+        std::cout << "ERROR::EDIT_LOG::INVALID_HEADER " << path << std::endl;
+        file.close();
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Reads every valid record in the log, in order, and starts the flusher.
+ *
+ * @param apply Called once per recovered edit.
+ * @return The number of edits recovered.
+ */
+size_t EditLog::replay(const std::function<void(const ChunkKey& chunk, int blockIndex, BlockID block)>& apply) {
+    size_t recovered = 0;
+    uint64_t offset = HEADER_BYTES;
+    uint64_t end = file.size();
+
+    // Read in large blocks rather than one syscall per 16-byte record
+    std::vector<Record> records(4096);
+    bool valid = true;
+    while (valid && offset + sizeof(Record) <= end) {
+        size_t count = size_t(std::min<uint64_t>(records.size(), (end - offset) / sizeof(Record)));
+        if (!file.readAt(records.data(), count * sizeof(Record), offset)) {
+            break;
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            // The first bad record marks the point the crash interrupted; nothing after it counts
+            if (records[i].checksum != checksum(records[i]) || records[i].blockIndex >= CHUNK_VOLUME) {
+                valid = false;
+                break;
+            }
+
+            apply(ChunkKey::fromValue(records[i].chunk), records[i].blockIndex, records[i].block);
+            offset += sizeof(Record);
+            recovered++;
+        }
+    }
+
+    // New records overwrite any torn tail
+    writeOffset = offset;
+    if (offset != end) {
+        file.resize(offset);
+    }
+
+    if (!flusher.joinable()) {
+        flusher = std::thread(&EditLog::flusherLoop, this);
+    }
+    return recovered;
+}
+
+/**
+ * Appends an edit. The record becomes durable at the next group commit.
+ *
+ * @param chunk      The chunk containing the edited block.
+ * @param blockIndex The block's index inside the chunk.
+ * @param block      The block's new ID.
+ * @return The edit's sequence number.
+ */
+uint64_t EditLog::append(const ChunkKey& chunk, int blockIndex, BlockID block) {
+    Record record;
+    record.chunk = chunk.value;
+    record.blockIndex = uint16_t(blockIndex);
+    record.block = block;
+    record.checksum = checksum(record);
+
+    uint64_t sequence;
+    bool wake;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.push_back(record);
+        sequence = ++appendedSequence;
+        wake = pending.size() == 1 || pending.size() >= groupSize;
+    }
+
+    // Wake the flusher to start a group's timer, or to commit a full group early
+    if (wake) {
+        wakeFlusher.notify_one();
+    }
+    return sequence;
+}
+
+/**
+ * Blocks until the edit with the given sequence number (and all before it) is durable.
+ *
+ * @return False if a commit failed first.
+ */
+bool EditLog::waitDurable(uint64_t sequence) {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (durableSequence >= sequence || failed) {
+        return durableSequence >= sequence;
+    }
+
+    flushRequested = true;
+    wakeFlusher.notify_one();
+    durableChanged.wait(lock, [this, sequence] {
+        return durableSequence >= sequence || failed || !flusher.joinable();
+    });
+    return durableSequence >= sequence;
+}
+
+/**
+ * Blocks until every edit appended so far is durable.
+ *
+ * @return False if a commit failed.
+ */
+bool EditLog::flush() {
+    uint64_t sequence;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        sequence = appendedSequence;
+    }
+    return waitDurable(sequence);
+}
+
+/**
+ * Empties the log. Both locks are held throughout, so no group can be taken or
+ * written between the resize and the offset reset.
+ *
+ * @return True on success.
+ */
+bool EditLog::truncate() {
+    std::lock_guard<std::mutex> fileLock(fileMutex);
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (failed) {
+        std::cout << "ERROR::EDIT_LOG::TRUNCATE_AFTER_FAILED_COMMIT" << std::endl;
+        return false;
+    }
+
+    // The checkpoint saved every edit appended so far, so records not written yet are
+    // dropped rather than written; that includes a group the flusher has already taken
+    pending.clear();
+    ++truncations;
+    durableSequence = appendedSequence;
+    durableChanged.notify_all();
+
+    if (!file.resize(HEADER_BYTES)) {
+        std::cout << "ERROR::EDIT_LOG::TRUNCATE_FAILED" << std::endl;
+        return false;
+    }
+    writeOffset = HEADER_BYTES;
+
+    // If the truncation may not be durable, old records could reappear after the new ones
+    if (!file.sync()) {
+        std::cout << "ERROR::EDIT_LOG::TRUNCATE_FAILED" << std::endl;
+        failed = true;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Returns true once a group commit has failed.
+ */
+bool EditLog::hasFailed() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return failed;
+}
+
+/**
+ * Returns the number of edits appended since the log was opened.
+ */
+uint64_t EditLog::getAppendedCount() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return appendedSequence;
+}
+
+/**
+ * The loop the flusher thread runs: wait, take the pending group, write, fsync.
+ */
+void EditLog::flusherLoop() {
+    std::vector<Record> group;
+
+    for (;;) {
+        uint64_t groupSequence;
+        uint64_t groupTruncations;
+        bool exiting;
+        bool broken;
+
+        // --- Wait for the commit interval, a full group, or an explicit flush ---
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+
+            // Sleep indefinitely while there is nothing to commit...
+            wakeFlusher.wait(lock, [this] { return stopping || flushRequested || !pending.empty(); });
+
+            // ...then give the group up to one interval to fill
+            wakeFlusher.wait_for(lock, commitInterval, [this] {
+                return stopping || flushRequested || pending.size() >= groupSize;
+            });
+
+            exiting = stopping;
+            broken = failed;
+            flushRequested = false;
+
+            // Take the whole pending group; appends carry on into the (now empty) vector
+            group.swap(pending);
+            groupSequence = appendedSequence;
+            groupTruncations = truncations;
+        }
+
+        // --- Write and fsync the group without holding the main lock ---
+        // After a failed commit, groups are dropped: replay stops at the failed one anyway
+        bool committed = !broken;
+        if (!group.empty() && !broken) {
+            std::lock_guard<std::mutex> fileLock(fileMutex);
+
+            // A truncate since the group was taken dropped it (its edits were checkpointed)
+            if (groupTruncations == truncations) {
+                if (file.writeAt(group.data(), group.size() * sizeof(Record), writeOffset) && file.sync()) {
+                    writeOffset += group.size() * sizeof(Record);
+                } else {
+                    std::cout << "ERROR::EDIT_LOG::COMMIT_FAILED" << std::endl;
+                    committed = false;
+                }
+            }
+        }
+        group.clear();
+
+        // --- Publish the new durable point, or the error ---
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (committed) {
+                // A truncate meanwhile may have moved it past this group already
+                durableSequence = std::max(durableSequence, groupSequence);
+            } else {
+                failed = true;
+            }
+        }
+        durableChanged.notify_all();
+
+        if (exiting) {
+            return;
+        }
+    }
+}
+
+/**
+ * Computes the checksum stored in a record (FNV-1a over its other fields).
+ */
+uint32_t EditLog::checksum(const Record& record) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&record);
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < offsetof(Record, checksum); ++i) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
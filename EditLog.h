@@ -0,0 +1,206 @@
+// Prevents multiple inclusions of this header file, which can cause redefinition errors
+#ifndef EDIT_LOG_H
+#define EDIT_LOG_H
+
+// Includes std::chrono::milliseconds for the group commit interval
+#include <chrono>
+
+// Includes std::condition_variable, used to wake the flusher and wait for durability
+#include <condition_variable>
+
+// Includes fixed-width integer types such as uint64_t
+#include <cstdint>
+
+// Includes std::function, the type of the replay callback
+#include <functional>
+
+// Includes std::mutex, which guards the pending records
+#include <mutex>
+
+// Includes the C++ Standard Library string class, used for the log path
+#include <string>
+
+// Includes std::thread for the background flusher
+#include <thread>
+
+// Includes the vector container used for pending records
+#include <vector>
+
+#include "Chunk.h"      // BlockID
+#include "ChunkKey.h"   // Identifies the chunk an edit belongs to
+#include "File.h"       // Positioned writes and fsync
+
+/**
+ * The `EditLog` class is an append-only write-ahead log of block edits.
+ *
+ * Rewriting a whole chunk payload for every block a player places would be far
+ * too slow, but edits still need to survive a crash. Instead, each edit is
+ * appended to this log as a tiny fixed-size record and the owning chunk is only
+ * marked dirty; dirty chunks are written to region files later, at a checkpoint,
+ * after which the log is truncated.
+ *
+ * Records are made durable in groups: a background thread writes and fsyncs
+ * everything appended since its last pass, either every `commitInterval` or as
+ * soon as `groupSize` records are waiting. Appending never touches the disk.
+ *
+ * Each record carries a checksum, so a record torn by a crash mid-write is
+ * detected on replay and the log is cut there. For the same reason, once a
+ * write or fsync fails, nothing more is written: records after a torn group
+ * would never be replayed. The error is sticky and reported by `waitDurable`,
+ * `flush` and `truncate`.
+ */
+class EditLog {
+public:
+    /**
+     * Constructor: Creates a closed log.
+     *
+     * @param commitInterval The longest an edit waits before being fsynced.
+     * @param groupSize      The number of pending records that triggers an early commit.
+     */
+    explicit EditLog(std::chrono::milliseconds commitInterval = std::chrono::milliseconds(5), size_t groupSize = 4096);
+
+    /**
+     * Destructor: Makes every appended record durable, then stops the flusher.
+     */
+    ~EditLog();
+
+    // The log owns a running thread, so it can't be copied
+    EditLog(const EditLog&) = delete;
+    EditLog& operator=(const EditLog&) = delete;
+
+    /**
+     * Opens (or creates) the log file. Call `replay` next to recover edits
+     * made since the last checkpoint; appends are only accepted after that.
+     *
+     * @param path The path of the log file.
+     * @return True if the log was opened.
+     */
+    bool open(const std::string& path);
+
+    /**
+     * Reads every valid record in the log, in order, and starts the flusher.
+     * A torn or corrupt tail is discarded.
+     *
+     * @param apply Called once per recovered edit.
+     * @return The number of edits recovered.
+     */
+    size_t replay(const std::function<void(const ChunkKey& chunk, int blockIndex, BlockID block)>& apply);
+
+    /**
+     * Appends an edit. The record becomes durable at the next group commit.
+     *
+     * @param chunk      The chunk containing the edited block.
+     * @param blockIndex The block's index inside the chunk (see `Chunk::index`).
+     * @param block      The block's new ID.
+     * @return The edit's sequence number, for use with `waitDurable`.
+     */
+    uint64_t append(const ChunkKey& chunk, int blockIndex, BlockID block);
+
+    /**
+     * Blocks until the edit with the given sequence number (and all before it) is durable.
+     *
+     * @return False if a commit failed first; the edit will never become durable.
+     */
+    bool waitDurable(uint64_t sequence);
+
+    /**
+     * Blocks until every edit appended so far is durable.
+     *
+     * @return False if a commit failed.
+     */
+    bool flush();
+
+    /**
+     * Empties the log. Call only after every dirty chunk has been saved (a
+     * checkpoint), and not concurrently with `append`. Records not written yet
+     * are dropped and count as durable, since the checkpoint saved their edits.
+     *
+     * @return True on success; false if a commit failed (see `hasFailed`).
+     */
+    bool truncate();
+
+    /** Returns true once a group commit has failed; no record is written after that */
+    bool hasFailed();
+
+    /** Returns the number of edits appended since the log was opened */
+    uint64_t getAppendedCount();
+
+private:
+    /** One edit, as stored on disk (native byte order) */
+    struct Record {
+        uint64_t chunk;
+        uint16_t blockIndex;
+        BlockID block;
+        uint32_t checksum;
+    };
+    static_assert(sizeof(Record) == 16, "EditLog records must be 16 bytes");
+
+    /** Identifies an edit log ("KYWL") */
+    static constexpr uint32_t MAGIC = 0x4c57594b;
+
+    /** The current file format version */
+    static constexpr uint32_t VERSION = 1;
+
+    /** The size of the file header (magic and version), in bytes */
+    static constexpr uint64_t HEADER_BYTES = 8;
+
+    /** The log file */
+    File file;
+
+    /** Where the next group of records will be written; guarded by `fileMutex` */
+    uint64_t writeOffset;
+
+    /** The longest an edit waits before being fsynced */
+    std::chrono::milliseconds commitInterval;
+
+    /** The number of pending records that triggers an early commit */
+    size_t groupSize;
+
+    /** Records appended but not yet handed to the flusher */
+    std::vector<Record> pending;
+
+    /** The sequence number of the last appended record */
+    uint64_t appendedSequence;
+
+    /** The sequence number of the last durable record */
+    uint64_t durableSequence;
+
+    /** Set by `flush` to make the flusher commit immediately */
+    bool flushRequested;
+
+    /** Set when the log is shutting down */
+    bool stopping;
+
+    /** Set when a group failed to commit; it stays set, and `durableSequence` stops there */
+    bool failed;
+
+    /** Bumped by every truncate, with both locks held; a group taken before one is dropped */
+    uint64_t truncations;
+
+    /** Guards every member above except `file` and `writeOffset` */
+    std::mutex mutex;
+
+    /** Held while the file is being written or truncated; guards `file` and `writeOffset` */
+    std::mutex fileMutex;
+
+    /** Signalled when the flusher has work */
+    std::condition_variable wakeFlusher;
+
+    /** Signalled when `durableSequence` advances or a commit fails */
+    std::condition_variable durableChanged;
+
+    /** The background thread performing group commits */
+    std::thread flusher;
+
+    /**
+     * The loop the flusher thread runs: wait, take the pending group, write, fsync.
+     */
+    void flusherLoop();
+
+    /**
+     * Computes the checksum stored in a record (FNV-1a over its other fields).
+     */
+    static uint32_t checksum(const Record& record);
+};
+
+#endif  // Ends the conditional inclusion directive
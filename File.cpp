@@ -0,0 +1,262 @@
+// Includes the corresponding header file to access the File class declaration
+#include "File.h"
+
+// Platform file APIs
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Includes std::filesystem::path, used to find a file's directory
+#include <filesystem>
+
+// The value stored in `handle` while no file is open
+static const intptr_t CLOSED_HANDLE = -1;
+
+/**
+ * Constructor: Creates a closed file.
+ */
+File::File() : handle(CLOSED_HANDLE) {}
+
+/**
+ * Destructor: Closes the file if it is open.
+ */
+File::~File() {
+    close();
+}
+
+/**
+ * Move constructor: Takes ownership of another file's handle.
+ */
+File::File(File&& other) noexcept : handle(other.handle) {
+    other.handle = CLOSED_HANDLE;
+}
+
+/**
+ * Move assignment: Closes this file, then takes ownership of another file's handle.
+ */
+File& File::operator=(File&& other) noexcept {
+    if (this != &other) {
+        close();
+        handle = other.handle;
+        other.handle = CLOSED_HANDLE;
+    }
+    return *this;
+}
+
+/**
+ * Opens a file.
+ *
+ * @param path     The path of the file.
+ * @param writable If true, the file is opened for writing and created if missing.
+ * @param truncate If true (and writable), any existing contents are discarded.
+ * @return True if the file was opened.
+ */
+bool File::open(const std::string& path, bool writable, bool truncate) {
+    close();
+
+#ifdef _WIN32
+    DWORD access = writable ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ;
+    DWORD disposition = !writable ? OPEN_EXISTING : (truncate ? CREATE_ALWAYS : OPEN_ALWAYS);
+
+    // FILE_SHARE_DELETE lets region files be replaced (renamed over) while still open for reading
+    HANDLE h = CreateFileA(path.c_str(), access, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                           NULL, disposition, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (h == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    handle = reinterpret_cast<intptr_t>(h);
+#else
+    int flags = writable ? (O_RDWR | O_CREAT) : O_RDONLY;
+    if (writable && truncate) {
+        flags |= O_TRUNC;
+    }
+
+    int fd = ::open(path.c_str(), flags, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    handle = fd;
+#endif
+
+    return true;
+}
+
+/**
+ * Closes the file. Safe to call on a file that isn't open.
+ */
+void File::close() {
+    if (handle == CLOSED_HANDLE) {
+        return;
+    }
+
+#ifdef _WIN32
+    CloseHandle(reinterpret_cast<HANDLE>(handle));
+#else
+    ::close(int(handle));
+#endif
+
+    handle = CLOSED_HANDLE;
+}
+
+/**
+ * Returns true if the file is open.
+ */
+bool File::isOpen() const {
+    return handle != CLOSED_HANDLE;
+}
+
+/**
+ * Reads bytes from a given offset.
+ *
+ * @param buffer Receives the data.
+ * @param size   The number of bytes to read.
+ * @param offset The position in the file to read from.
+ * @return True if exactly `size` bytes were read.
+ */
+bool File::readAt(void* buffer, size_t size, uint64_t offset) const {
+    char* out = static_cast<char*>(buffer);
+
+    // Loop, since the OS may return fewer bytes than requested
+    while (size > 0) {
+#ifdef _WIN32
+        OVERLAPPED overlapped = {};
+        overlapped.Offset = DWORD(offset);
+        overlapped.OffsetHigh = DWORD(offset >> 32);
+
+        DWORD bytesRead = 0;
+        DWORD request = size > 0x40000000 ? 0x40000000 : DWORD(size);
+        if (!ReadFile(reinterpret_cast<HANDLE>(handle), out, request, &bytesRead, &overlapped) || bytesRead == 0) {
+            return false;
+        }
+#else
+        ssize_t bytesRead = ::pread(int(handle), out, size, off_t(offset));
+        if (bytesRead <= 0) {
+            return false;
+        }
+#endif
+        out += bytesRead;
+        size -= size_t(bytesRead);
+        offset += uint64_t(bytesRead);
+    }
+
+    return true;
+}
+
+/**
+ * Writes bytes at a given offset, growing the file if necessary.
+ *
+ * @param buffer The data to write.
+ * @param size   The number of bytes to write.
+ * @param offset The position in the file to write to.
+ * @return True if all bytes were written.
+ */
+bool File::writeAt(const void* buffer, size_t size, uint64_t offset) {
+    const char* in = static_cast<const char*>(buffer);
+
+    while (size > 0) {
+#ifdef _WIN32
+        OVERLAPPED overlapped = {};
+        overlapped.Offset = DWORD(offset);
+        overlapped.OffsetHigh = DWORD(offset >> 32);
+
+        DWORD bytesWritten = 0;
+        DWORD request = size > 0x40000000 ? 0x40000000 : DWORD(size);
+        if (!WriteFile(reinterpret_cast<HANDLE>(handle), in, request, &bytesWritten, &overlapped) || bytesWritten == 0) {
+            return false;
+        }
+#else
+        ssize_t bytesWritten = ::pwrite(int(handle), in, size, off_t(offset));
+        if (bytesWritten <= 0) {
+            return false;
+        }
+#endif
+        in += bytesWritten;
+        size -= size_t(bytesWritten);
+        offset += uint64_t(bytesWritten);
+    }
+
+    return true;
+}
+
+/**
+ * Flushes written data to the storage device.
+ *
+ * @return True if the data is durable.
+ */
+bool File::sync() {
+#ifdef _WIN32
+    return FlushFileBuffers(reinterpret_cast<HANDLE>(handle)) != 0;
+#else
+    return ::fsync(int(handle)) == 0;
+#endif
+}
+
+/**
+ * Returns the current size of the file, in bytes.
+ */
+uint64_t File::size() const {
+    if (handle == CLOSED_HANDLE) {
+        return 0;
+    }
+
+#ifdef _WIN32
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(reinterpret_cast<HANDLE>(handle), &fileSize)) {
+        return 0;
+    }
+    return uint64_t(fileSize.QuadPart);
+#else
+    struct stat info;
+    if (::fstat(int(handle), &info) != 0) {
+        return 0;
+    }
+    return uint64_t(info.st_size);
+#endif
+}
+
+/**
+ * Changes the size of the file, discarding or zero-filling the tail.
+ *
+ * @param newSize The new size, in bytes.
+ * @return True on success.
+ */
+bool File::resize(uint64_t newSize) {
+#ifdef _WIN32
+    FILE_END_OF_FILE_INFO info;
+    info.EndOfFile.QuadPart = LONGLONG(newSize);
+    return SetFileInformationByHandle(reinterpret_cast<HANDLE>(handle), FileEndOfFileInfo, &info, sizeof(info)) != 0;
+#else
+    return ::ftruncate(int(handle), off_t(newSize)) == 0;
+#endif
+}
+
+/**
+ * Flushes the entries of the directory holding a file to the storage device.
+ *
+ * @param path The path of a file in the directory.
+ * @return True if the directory is durable.
+ */
+bool File::syncDirectoryOf(const std::string& path) {
+    std::string directory = std::filesystem::path(path).parent_path().string();
+    if (directory.empty()) {
+        directory = ".";
+    }
+
+#ifdef _WIN32
+    // NTFS journals renames itself, and directories can't be flushed through a plain handle
+    return true;
+#else
+    int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fd < 0) {
+        return false;
+    }
+    bool synced = ::fsync(fd) == 0;
+    ::close(fd);
+    return synced;
+#endif
+}
@@ -0,0 +1,116 @@
+// Prevents multiple inclusions of this header file, which can cause redefinition errors
+#ifndef FILE_H
+#define FILE_H
+
+// Includes size_t
+#include <cstddef>
+
+// Includes fixed-width integer types such as uint64_t
+#include <cstdint>
+
+// Includes the C++ Standard Library string class, used for file paths
+#include <string>
+
+/**
+ * The `File` class is a thin wrapper around the operating system's file handle.
+ *
+ * Unlike `std::fstream`, every read and write takes an explicit offset
+ * (`pread`/`pwrite` on POSIX, overlapped offsets on Windows). There is no shared
+ * file position, so several threads can read from the same region file at once.
+ */
+class File {
+public:
+    /**
+     * Constructor: Creates a closed file.
+     */
+    File();
+
+    /**
+     * Destructor: Closes the file if it is open.
+     */
+    ~File();
+
+    // Files own an OS handle, so they can be moved but not copied
+    File(const File&) = delete;
+    File& operator=(const File&) = delete;
+    File(File&& other) noexcept;
+    File& operator=(File&& other) noexcept;
+
+    /**
+     * Opens a file.
+     *
+     * @param path     The path of the file.
+     * @param writable If true, the file is opened for writing and created if missing.
+     * @param truncate If true (and writable), any existing contents are discarded.
+     * @return True if the file was opened.
+     */
+    bool open(const std::string& path, bool writable, bool truncate = false);
+
+    /**
+     * Closes the file. Safe to call on a file that isn't open.
+     */
+    void close();
+
+    /** Returns true if the file is open */
+    bool isOpen() const;
+
+    /**
+     * Reads bytes from a given offset.
+     *
+     * @param buffer Receives the data.
+     * @param size   The number of bytes to read.
+     * @param offset The position in the file to read from.
+     * @return True if exactly `size` bytes were read.
+     */
+    bool readAt(void* buffer, size_t size, uint64_t offset) const;
+
+    /**
+     * Writes bytes at a given offset, growing the file if necessary.
+     *
+     * @param buffer The data to write.
+     * @param size   The number of bytes to write.
+     * @param offset The position in the file to write to.
+     * @return True if all bytes were written.
+     */
+    bool writeAt(const void* buffer, size_t size, uint64_t offset);
+
+    /**
+     * Flushes written data to the storage device.
+     *
+     * @return True if the data is durable.
+     */
+    bool sync();
+
+    /**
+     * Returns the current size of the file, in bytes (0 if it isn't open).
+     */
+    uint64_t size() const;
+
+    /**
+     * Changes the size of the file, discarding or zero-filling the tail.
+     *
+     * @param newSize The new size, in bytes.
+     * @return True on success.
+     */
+    bool resize(uint64_t newSize);
+
+    /**
+     * Flushes the entries of the directory holding a file (for example, a file just
+     * renamed into it) to the storage device, so the rename survives a crash.
+     *
+     * @param path The path of a file in the directory.
+     * @return True if the directory is durable.
+     */
+    static bool syncDirectoryOf(const std::string& path);
+
+    /**
+     * Returns the underlying OS handle (a file descriptor on POSIX, a HANDLE on Windows).
+     */
+    intptr_t nativeHandle() const { return handle; }
+
+private:
+    /** The OS file handle, or -1 when closed */
+    intptr_t handle;
+};
+
+#endif  // Ends the conditional inclusion directive
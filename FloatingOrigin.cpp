@@ -0,0 +1,80 @@
+// Includes the corresponding header file to access the FloatingOrigin class declaration
+#include "FloatingOrigin.h"
+
+// Jolt physics headers
+#include "Jolt/Jolt.h"
+#include <Jolt/Physics/PhysicsSystem.h>
+#include <Jolt/Physics/Body/BodyInterface.h>
+
+/**
+ * Constructor: Creates a floating origin at the world origin.
+ *
+ * @param rebaseDistance How far (in blocks) the focus may drift before the origin moves.
+ */
+FloatingOrigin::FloatingOrigin(float rebaseDistance) : rebaseDistance(rebaseDistance) {}
+
+/**
+ * Converts a world position into Jolt's local simulation space.
+ */
+glm::vec3 FloatingOrigin::toPhysics(const WorldPosition& position) const {
+    return position.relativeTo(origin);
+}
+
+/**
+ * Converts a position in Jolt's local simulation space back into world space.
+ */
+WorldPosition FloatingOrigin::fromPhysics(const glm::vec3& physicsPosition) const {
+    WorldPosition position = origin;
+    position += physicsPosition;
+    return position;
+}
+
+/**
+ * Moves the origin to the focus if it has drifted beyond the rebase distance.
+ *
+ * @param focus The position physics should stay precise around.
+ * @param shift Receives the offset that must be added to every physics position.
+ * @return True if the origin moved.
+ */
+bool FloatingOrigin::update(const WorldPosition& focus, glm::vec3& shift) {
+    shift = glm::vec3(0.0f);
+
+    if (glm::length(focus.relativeTo(origin)) < rebaseDistance) {
+        return false;
+    }
+
+    // Snap the new origin to a chunk corner so the shift is a whole number of blocks,
+    // which is exactly representable and doesn't accumulate rounding error
+    WorldPosition newOrigin(focus.chunk, glm::vec3(0.0f));
+
+    shift = origin.relativeTo(newOrigin);
+    origin = newOrigin;
+    return true;
+}
+
+/**
+ * Moves the origin if needed and shifts every body in the physics system to match.
+ *
+ * @param focus  The position physics should stay precise around.
+ * @param system The Jolt physics system whose bodies should follow the origin.
+ * @return True if the origin moved.
+ */
+bool FloatingOrigin::update(const WorldPosition& focus, JPH::PhysicsSystem& system) {
+    glm::vec3 shift;
+    if (!update(focus, shift)) {
+        return false;
+    }
+
+    // Collect every body currently in the simulation
+    JPH::BodyIDVector bodies;
+    system.GetBodies(bodies);
+
+    // Move each one by the shift; velocities are unaffected, and bodies are not woken up
+    JPH::BodyInterface& bodyInterface = system.GetBodyInterface();
+    JPH::Vec3 offset(shift.x, shift.y, shift.z);
+    for (const JPH::BodyID& id : bodies) {
+        bodyInterface.SetPosition(id, bodyInterface.GetPosition(id) + offset, JPH::EActivation::DontActivate);
+    }
+
+    return true;
+}
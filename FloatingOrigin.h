@@ -0,0 +1,77 @@
+// Prevents multiple inclusions of this header file, which can cause redefinition errors
+#ifndef FLOATING_ORIGIN_H
+#define FLOATING_ORIGIN_H
+
+#include <glm/glm.hpp> // GLM for vector types
+
+// Includes the WorldPosition struct used to describe the origin
+#include "WorldPosition.h"
+
+// Forward declaration, so users of this header don't need to include Jolt
+namespace JPH { class PhysicsSystem; }
+
+/**
+ * The `FloatingOrigin` class keeps Jolt's simulation space centred near the player.
+ *
+ * Jolt stores body positions as floats (unless built with double precision), so
+ * bodies simulated millions of blocks from the world origin would jitter and
+ * collide inaccurately. Instead, physics runs in a local space whose origin is
+ * a `WorldPosition`. When the focus (usually the camera or player) drifts too far
+ * from that origin, the origin jumps to the focus and every body is shifted by
+ * the opposite amount, so nothing visibly moves.
+ */
+class FloatingOrigin {
+public:
+    /**
+     * Constructor: Creates a floating origin at the world origin.
+     *
+     * @param rebaseDistance How far (in blocks) the focus may drift before the origin moves.
+     */
+    explicit FloatingOrigin(float rebaseDistance = 1024.0f);
+
+    /**
+     * Converts a world position into Jolt's local simulation space.
+     *
+     * @param position The world position to convert.
+     * @return The position relative to the current origin.
+     */
+    glm::vec3 toPhysics(const WorldPosition& position) const;
+
+    /**
+     * Converts a position in Jolt's local simulation space back into world space.
+     *
+     * @param physicsPosition A position relative to the current origin.
+     * @return The matching world position.
+     */
+    WorldPosition fromPhysics(const glm::vec3& physicsPosition) const;
+
+    /**
+     * Moves the origin to the focus if it has drifted beyond the rebase distance.
+     *
+     * @param focus The position physics should stay precise around.
+     * @param shift Receives the offset that must be added to every physics position.
+     * @return True if the origin moved (and `shift` is non-zero).
+     */
+    bool update(const WorldPosition& focus, glm::vec3& shift);
+
+    /**
+     * Moves the origin if needed and shifts every body in the physics system to match.
+     *
+     * @param focus  The position physics should stay precise around.
+     * @param system The Jolt physics system whose bodies should follow the origin.
+     * @return True if the origin moved.
+     */
+    bool update(const WorldPosition& focus, JPH::PhysicsSystem& system);
+
+    /** Returns the current origin of the simulation space */
+    const WorldPosition& getOrigin() const { return origin; }
+
+private:
+    /** The world position that Jolt's (0, 0, 0) corresponds to */
+    WorldPosition origin;
+
+    /** The drift distance, in blocks, that triggers a rebase */
+    float rebaseDistance;
+};
+
+#endif  // Ends the conditional inclusion directive
@@ -0,0 +1,257 @@
+// Includes the corresponding header file to access the GLRenderBackend class declaration
+#include "GLRenderBackend.h"
+
+// Includes std::min
+#include <algorithm>
+
+/** The size of the buffer compile and link logs are read into */
+static const GLsizei INFO_LOG_SIZE = 512;
+
+bool GLRenderBackend::supportsParallelCompile() const {
+    return GLEW_KHR_parallel_shader_compile || GLEW_ARB_parallel_shader_compile;
+}
+
+bool GLRenderBackend::supportsProgramBinary() const {
+    return GLEW_ARB_get_program_binary;
+}
+
+// --- Buffers ---
+
+GLuint GLRenderBackend::createBuffer() {
+    GLuint buffer = 0;
+    glGenBuffers(1, &buffer);
+    return buffer;
+}
+
+void GLRenderBackend::deleteBuffer(GLuint buffer) {
+    glDeleteBuffers(1, &buffer);
+}
+
+void GLRenderBackend::bindBuffer(GLenum target, GLuint buffer) {
+    glBindBuffer(target, buffer);
+}
+
+void GLRenderBackend::bufferData(GLenum target, size_t bytes, const void* data, GLenum usage) {
+    glBufferData(target, GLsizeiptr(bytes), data, usage);
+}
+
+// --- Vertex arrays ---
+
+GLuint GLRenderBackend::createVertexArray() {
+    GLuint vertexArray = 0;
+    glGenVertexArrays(1, &vertexArray);
+    return vertexArray;
+}
+
+void GLRenderBackend::deleteVertexArray(GLuint vertexArray) {
+    glDeleteVertexArrays(1, &vertexArray);
+}
+
+void GLRenderBackend::bindVertexArray(GLuint vertexArray) {
+    glBindVertexArray(vertexArray);
+}
+
+void GLRenderBackend::vertexAttribPointer(GLuint index, GLint size, GLenum type, bool normalized, GLsizei stride, size_t offset) {
+    glVertexAttribPointer(index, size, type, normalized ? GL_TRUE : GL_FALSE, stride, reinterpret_cast<const void*>(offset));
+}
+
+void GLRenderBackend::vertexAttribIPointer(GLuint index, GLint size, GLenum type, GLsizei stride, size_t offset) {
+    glVertexAttribIPointer(index, size, type, stride, reinterpret_cast<const void*>(offset));
+}
+
+void GLRenderBackend::enableVertexAttribArray(GLuint index) {
+    glEnableVertexAttribArray(index);
+}
+
+// --- Textures ---
+
+void GLRenderBackend::activeTexture(int unit) {
+    glActiveTexture(GLenum(GL_TEXTURE0 + unit));
+}
+
+GLuint GLRenderBackend::createTexture() {
+    GLuint texture = 0;
+    glGenTextures(1, &texture);
+    return texture;
+}
+
+void GLRenderBackend::bindTexture(GLenum target, GLuint texture) {
+    glBindTexture(target, texture);
+}
+
+void GLRenderBackend::deleteTexture(GLuint texture) {
+    glDeleteTextures(1, &texture);
+}
+
+void GLRenderBackend::texParameteri(GLenum target, GLenum name, GLint value) {
+    glTexParameteri(target, name, value);
+}
+
+void GLRenderBackend::texImage2D(GLenum target, GLint internalFormat, GLsizei width, GLsizei height, GLenum format,
+                                 GLenum type, const void* data) {
+    glTexImage2D(target, 0, internalFormat, width, height, 0, format, type, data);
+}
+
+void GLRenderBackend::texSubImage2D(GLenum target, GLint x, GLint y, GLsizei width, GLsizei height, GLenum format,
+                                    GLenum type, const void* data) {
+    glTexSubImage2D(target, 0, x, y, width, height, format, type, data);
+}
+
+// --- Shaders and programs ---
+
+GLuint GLRenderBackend::createShader(GLenum type) {
+    return glCreateShader(type);
+}
+
+void GLRenderBackend::compileShader(GLuint shader, const std::string& source) {
+    const char* src = source.c_str();
+    glShaderSource(shader, 1, &src, NULL);
+    glCompileShader(shader);
+}
+
+bool GLRenderBackend::getShaderStatus(GLuint shader, std::string& log) {
+    GLint success = GL_FALSE;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success) {
+        GLchar infoLog[INFO_LOG_SIZE];
+        glGetShaderInfoLog(shader, INFO_LOG_SIZE, NULL, infoLog);
+        log = infoLog;
+    }
+    return success == GL_TRUE;
+}
+
+void GLRenderBackend::deleteShader(GLuint shader) {
+    glDeleteShader(shader);
+}
+
+GLuint GLRenderBackend::createProgram() {
+    return glCreateProgram();
+}
+
+void GLRenderBackend::attachShader(GLuint program, GLuint shader) {
+    glAttachShader(program, shader);
+}
+
+void GLRenderBackend::detachShader(GLuint program, GLuint shader) {
+    glDetachShader(program, shader);
+}
+
+void GLRenderBackend::linkProgram(GLuint program, bool retrievable) {
+    if (retrievable && GLEW_ARB_get_program_binary) {
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+    glLinkProgram(program);
+}
+
+bool GLRenderBackend::getProgramStatus(GLuint program, std::string& log) {
+    GLint success = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        GLchar infoLog[INFO_LOG_SIZE];
+        glGetProgramInfoLog(program, INFO_LOG_SIZE, NULL, infoLog);
+        log = infoLog;
+    }
+    return success == GL_TRUE;
+}
+
+bool GLRenderBackend::isProgramComplete(GLuint program) {
+    if (!supportsParallelCompile()) {
+        return true;
+    }
+
+    GLint complete = GL_TRUE;
+    glGetProgramiv(program, GL_COMPLETION_STATUS_KHR, &complete);
+    return complete == GL_TRUE;
+}
+
+bool GLRenderBackend::loadProgramBinary(GLuint program, GLenum format, const std::vector<uint8_t>& binary) {
+    if (!GLEW_ARB_get_program_binary || binary.empty()) {
+        return false;
+    }
+
+    glProgramBinary(program, format, binary.data(), GLsizei(binary.size()));
+    GLint success = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    return success == GL_TRUE;
+}
+
+bool GLRenderBackend::getProgramBinary(GLuint program, GLenum& format, std::vector<uint8_t>& binary) {
+    if (!GLEW_ARB_get_program_binary) {
+        return false;
+    }
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        return false;
+    }
+
+    binary.resize(size_t(length));
+    glGetProgramBinary(program, length, &length, &format, binary.data());
+    binary.resize(size_t(length));
+    return length > 0;
+}
+
+void GLRenderBackend::useProgram(GLuint program) {
+    glUseProgram(program);
+}
+
+void GLRenderBackend::deleteProgram(GLuint program) {
+    glDeleteProgram(program);
+}
+
+// --- Uniforms ---
+
+GLint GLRenderBackend::getUniformLocation(GLuint program, const std::string& name) {
+    return glGetUniformLocation(program, name.c_str());
+}
+
+void GLRenderBackend::uniform1i(GLint location, int value) {
+    glUniform1i(location, value);
+}
+
+void GLRenderBackend::uniform1f(GLint location, float value) {
+    glUniform1f(location, value);
+}
+
+void GLRenderBackend::uniform3fv(GLint location, const float* value) {
+    glUniform3fv(location, 1, value);
+}
+
+void GLRenderBackend::uniformMatrix4fv(GLint location, const float* value) {
+    glUniformMatrix4fv(location, 1, GL_FALSE, value);
+}
+
+// --- Fragment tests and writes ---
+
+void GLRenderBackend::colorMask(bool enabled) {
+    GLboolean mask = enabled ? GL_TRUE : GL_FALSE;
+    glColorMask(mask, mask, mask, mask);
+}
+
+void GLRenderBackend::depthMask(bool enabled) {
+    glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+}
+
+void GLRenderBackend::depthFunc(GLenum func) {
+    glDepthFunc(func);
+}
+
+// --- Drawing ---
+
+void GLRenderBackend::drawElements(GLenum mode, GLsizei count, GLenum type, size_t offset) {
+    glDrawElements(mode, count, type, reinterpret_cast<const void*>(offset));
+}
+
+void GLRenderBackend::multiDrawElements(GLenum mode, const GLsizei* counts, GLenum type, const size_t* offsets,
+                                        GLsizei drawCount) {
+    // GL takes the offsets as pointers; meshes draw a handful of ranges, so they fit on the stack
+    const void* pointers[8];
+    for (GLsizei first = 0; first < drawCount; first += 8) {
+        GLsizei batch = std::min<GLsizei>(drawCount - first, 8);
+        for (GLsizei i = 0; i < batch; ++i) {
+            pointers[i] = reinterpret_cast<const void*>(offsets[first + i]);
+        }
+        glMultiDrawElements(mode, counts + first, type, pointers, batch);
+    }
+}
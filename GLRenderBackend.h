@@ -0,0 +1,69 @@
+// Prevents multiple inclusions of this header file, which can cause redefinition errors
+#ifndef GL_RENDER_BACKEND_H
+#define GL_RENDER_BACKEND_H
+
+#include "RenderBackend.h" // The interface implemented
+
+/**
+ * The `GLRenderBackend` class is the `RenderBackend` that draws: every call
+ * goes straight to the matching OpenGL function of the current context.
+ */
+class GLRenderBackend : public RenderBackend {
+public:
+    bool supportsParallelCompile() const override;
+    bool supportsProgramBinary() const override;
+
+    GLuint createBuffer() override;
+    void deleteBuffer(GLuint buffer) override;
+    void bindBuffer(GLenum target, GLuint buffer) override;
+    void bufferData(GLenum target, size_t bytes, const void* data, GLenum usage) override;
+
+    GLuint createVertexArray() override;
+    void deleteVertexArray(GLuint vertexArray) override;
+    void bindVertexArray(GLuint vertexArray) override;
+    void vertexAttribPointer(GLuint index, GLint size, GLenum type, bool normalized, GLsizei stride, size_t offset) override;
+    void vertexAttribIPointer(GLuint index, GLint size, GLenum type, GLsizei stride, size_t offset) override;
+    void enableVertexAttribArray(GLuint index) override;
+
+    void activeTexture(int unit) override;
+    GLuint createTexture() override;
+    void bindTexture(GLenum target, GLuint texture) override;
+    void deleteTexture(GLuint texture) override;
+    void texParameteri(GLenum target, GLenum name, GLint value) override;
+    void texImage2D(GLenum target, GLint internalFormat, GLsizei width, GLsizei height, GLenum format, GLenum type,
+                    const void* data) override;
+    void texSubImage2D(GLenum target, GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type,
+                       const void* data) override;
+
+    GLuint createShader(GLenum type) override;
+    void compileShader(GLuint shader, const std::string& source) override;
+    bool getShaderStatus(GLuint shader, std::string& log) override;
+    void deleteShader(GLuint shader) override;
+
+    GLuint createProgram() override;
+    void attachShader(GLuint program, GLuint shader) override;
+    void detachShader(GLuint program, GLuint shader) override;
+    void linkProgram(GLuint program, bool retrievable) override;
+    bool getProgramStatus(GLuint program, std::string& log) override;
+    bool isProgramComplete(GLuint program) override;
+    bool loadProgramBinary(GLuint program, GLenum format, const std::vector<uint8_t>& binary) override;
+    bool getProgramBinary(GLuint program, GLenum& format, std::vector<uint8_t>& binary) override;
+    void useProgram(GLuint program) override;
+    void deleteProgram(GLuint program) override;
+
+    GLint getUniformLocation(GLuint program, const std::string& name) override;
+    void uniform1i(GLint location, int value) override;
+    void uniform1f(GLint location, float value) override;
+    void uniform3fv(GLint location, const float* value) override;
+    void uniformMatrix4fv(GLint location, const float* value) override;
+
+    void colorMask(bool enabled) override;
+    void depthMask(bool enabled) override;
+    void depthFunc(GLenum func) override;
+
+    void drawElements(GLenum mode, GLsizei count, GLenum type, size_t offset) override;
+    void multiDrawElements(GLenum mode, const GLsizei* counts, GLenum type, const size_t* offsets,
+                           GLsizei drawCount) override;
+};
+
+#endif  // Ends the conditional inclusion directive
@@ -0,0 +1,233 @@
+// Includes the corresponding header file to access the GLStateCache class declaration
+#include "GLStateCache.h"
+
+// Includes standard I/O for printing counts to the console
+#include <iostream>
+
+// Includes the render backend, which the binds that aren't skipped go to
+#include "RenderBackend.h"
+
+// Nothing is known about the context until the first bind of each kind
+GLuint GLStateCache::program = GLStateCache::UNKNOWN;
+GLuint GLStateCache::vertexArray = GLStateCache::UNKNOWN;
+GLuint GLStateCache::buffers[GLStateCache::BUFFER_SLOT_COUNT];
+int GLStateCache::activeUnit = -1;
+GLuint GLStateCache::textures[GLStateCache::TEXTURE_UNITS][GLStateCache::TEXTURE_SLOT_COUNT];
+GLCallCounts GLStateCache::counts = {};
+
+/**
+ * Static initializer: marks the buffer and texture bindings unknown before main runs.
+ */
+static const bool stateCacheInitialized = (GLStateCache::invalidate(), true);
+
+/** Returns the total number of skipped state changes */
+uint64_t GLCallCounts::getElidedTotal() const {
+    uint64_t total = 0;
+    for (int kind = 0; kind < GL_CALL_KIND_COUNT; ++kind) {
+        total += elided[kind];
+    }
+    return total;
+}
+
+/** Returns the total number of state changes passed on to OpenGL */
+uint64_t GLCallCounts::getIssuedTotal() const {
+    uint64_t total = 0;
+    for (int kind = 0; kind < GL_CALL_KIND_COUNT; ++kind) {
+        total += issued[kind];
+    }
+    return total;
+}
+
+/** Prints the counts on one line */
+void GLCallCounts::print() const {
+    static const char* const names[GL_CALL_KIND_COUNT] = {
+        "useProgram", "bindVertexArray", "bindBuffer", "activeTexture", "bindTexture"
+    };
+
+    std::cout << "GL_CALLS draws " << draws << " (" << triangles << " triangles), state changes issued " << getIssuedTotal()
+              << ", elided " << getElidedTotal() << " (";
+    for (int kind = 0; kind < GL_CALL_KIND_COUNT; ++kind) {
+        std::cout << (kind > 0 ? ", " : "") << names[kind] << " " << issued[kind] << "/" << issued[kind] + elided[kind];
+    }
+    std::cout << ")" << std::endl;
+}
+
+/** glUseProgram, unless the program is already in use */
+void GLStateCache::useProgram(GLuint program) {
+    bool changed = GLStateCache::program != program;
+    if (changed) {
+        RenderBackend::get().useProgram(program);
+        GLStateCache::program = program;
+    }
+    count(GL_CALL_USE_PROGRAM, changed);
+}
+
+/** glBindVertexArray, unless the vertex array is already bound */
+void GLStateCache::bindVertexArray(GLuint vertexArray) {
+    bool changed = GLStateCache::vertexArray != vertexArray;
+    if (changed) {
+        RenderBackend::get().bindVertexArray(vertexArray);
+        GLStateCache::vertexArray = vertexArray;
+
+        // Each vertex array has its own element array buffer binding
+        buffers[BUFFER_ELEMENT_ARRAY] = UNKNOWN;
+    }
+    count(GL_CALL_BIND_VERTEX_ARRAY, changed);
+}
+
+/** glBindBuffer, unless the buffer is already bound to the target */
+void GLStateCache::bindBuffer(GLenum target, GLuint buffer) {
+    int slot = bufferSlot(target);
+    bool changed = slot < 0 || buffers[slot] != buffer;
+    if (changed) {
+        RenderBackend::get().bindBuffer(target, buffer);
+        if (slot >= 0) {
+            buffers[slot] = buffer;
+        }
+    }
+    count(GL_CALL_BIND_BUFFER, changed);
+}
+
+/**
+ * Binds a texture to a texture unit, skipping the calls that wouldn't change anything.
+ *
+ * @param unit    The texture unit, counting from 0 (not GL_TEXTURE0).
+ * @param target  The texture target, such as GL_TEXTURE_2D_ARRAY.
+ * @param texture The texture.
+ */
+void GLStateCache::bindTexture(int unit, GLenum target, GLuint texture) {
+    int slot = textureSlot(target);
+    bool tracked = slot >= 0 && unit >= 0 && unit < TEXTURE_UNITS;
+    if (tracked && textures[unit][slot] == texture) {
+        count(GL_CALL_BIND_TEXTURE, false);
+        return;
+    }
+
+    // Only switch units when a bind actually happens
+    bool unitChanged = activeUnit != unit;
+    if (unitChanged) {
+        RenderBackend::get().activeTexture(unit);
+        activeUnit = unit;
+    }
+    count(GL_CALL_ACTIVE_TEXTURE, unitChanged);
+
+    RenderBackend::get().bindTexture(target, texture);
+    if (tracked) {
+        textures[unit][slot] = texture;
+    }
+    count(GL_CALL_BIND_TEXTURE, true);
+}
+
+/** glDeleteProgram, forgetting the program if it was in use */
+void GLStateCache::deleteProgram(GLuint program) {
+    RenderBackend::get().deleteProgram(program);
+
+    // A program in use is only deleted once it stops being used, so the binding
+    // stays, but a new program may get the same name: force the next glUseProgram
+    if (GLStateCache::program == program) {
+        GLStateCache::program = UNKNOWN;
+    }
+}
+
+/** glDeleteVertexArrays for one vertex array, forgetting it if it was bound */
+void GLStateCache::deleteVertexArray(GLuint vertexArray) {
+    RenderBackend::get().deleteVertexArray(vertexArray);
+
+    // Deleting a bound vertex array binds 0 instead
+    if (GLStateCache::vertexArray == vertexArray) {
+        GLStateCache::vertexArray = 0;
+        buffers[BUFFER_ELEMENT_ARRAY] = UNKNOWN;
+    }
+}
+
+/** glDeleteBuffers for one buffer, forgetting it wherever it was bound */
+void GLStateCache::deleteBuffer(GLuint buffer) {
+    RenderBackend::get().deleteBuffer(buffer);
+
+    // Deleting a bound buffer binds 0 to each target it was bound to
+    for (GLuint& bound : buffers) {
+        if (bound == buffer) {
+            bound = 0;
+        }
+    }
+}
+
+/** glDeleteTextures for one texture, forgetting it wherever it was bound */
+void GLStateCache::deleteTexture(GLuint texture) {
+    RenderBackend::get().deleteTexture(texture);
+
+    // Deleting a bound texture binds 0 to each unit and target it was bound to
+    for (auto& unit : textures) {
+        for (GLuint& bound : unit) {
+            if (bound == texture) {
+                bound = 0;
+            }
+        }
+    }
+}
+
+/**
+ * Forgets all cached state, so the next bind of each kind is always issued.
+ */
+void GLStateCache::invalidate() {
+    program = UNKNOWN;
+    vertexArray = UNKNOWN;
+    for (GLuint& bound : buffers) {
+        bound = UNKNOWN;
+    }
+    activeUnit = -1;
+    for (auto& unit : textures) {
+        for (GLuint& bound : unit) {
+            bound = UNKNOWN;
+        }
+    }
+}
+
+/**
+ * Returns the counts since the last call and starts counting again.
+ */
+GLCallCounts GLStateCache::takeCounts() {
+    GLCallCounts taken = counts;
+    counts = GLCallCounts();
+    return taken;
+}
+
+/**
+ * Returns the tracking slot of a buffer target, or -1 if it isn't tracked.
+ */
+int GLStateCache::bufferSlot(GLenum target) {
+    switch (target) {
+        case GL_ARRAY_BUFFER: return BUFFER_ARRAY;
+        case GL_ELEMENT_ARRAY_BUFFER: return BUFFER_ELEMENT_ARRAY;
+        case GL_UNIFORM_BUFFER: return BUFFER_UNIFORM;
+        case GL_COPY_READ_BUFFER: return BUFFER_COPY_READ;
+        case GL_COPY_WRITE_BUFFER: return BUFFER_COPY_WRITE;
+        case GL_PIXEL_PACK_BUFFER: return BUFFER_PIXEL_PACK;
+        case GL_PIXEL_UNPACK_BUFFER: return BUFFER_PIXEL_UNPACK;
+        default: return -1;
+    }
+}
+
+/**
+ * Returns the tracking slot of a texture target, or -1 if it isn't tracked.
+ */
+int GLStateCache::textureSlot(GLenum target) {
+    switch (target) {
+        case GL_TEXTURE_2D: return TEXTURE_2D;
+        case GL_TEXTURE_2D_ARRAY: return TEXTURE_2D_ARRAY;
+        case GL_TEXTURE_3D: return TEXTURE_3D;
+        case GL_TEXTURE_CUBE_MAP: return TEXTURE_CUBE_MAP;
+        default: return -1;
+    }
+}
+
+/**
+ * Records one state change, issued or elided.
+ */
+void GLStateCache::count(GLCallKind kind, bool issued) {
+    if (issued) {
+        ++counts.issued[kind];
+    } else {
+        ++counts.elided[kind];
+    }
+}
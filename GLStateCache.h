@@ -0,0 +1,167 @@
+// Prevents multiple inclusions of this header file, which can cause redefinition errors
+#ifndef GL_STATE_CACHE_H
+#define GL_STATE_CACHE_H
+
+// Includes the OpenGL Extension Wrangler Library (GLEW)
+#include <GL/glew.h>
+
+// Includes fixed-width integer types such as uint64_t
+#include <cstdint>
+
+/** The kinds of state change `GLStateCache` counts */
+enum GLCallKind {
+    GL_CALL_USE_PROGRAM,
+    GL_CALL_BIND_VERTEX_ARRAY,
+    GL_CALL_BIND_BUFFER,
+    GL_CALL_ACTIVE_TEXTURE,
+    GL_CALL_BIND_TEXTURE,
+    GL_CALL_KIND_COUNT
+};
+
+/**
+ * The `GLCallCounts` struct counts state changes and draws over some period
+ * (usually one frame, see `GLStateCache::takeCounts`).
+ */
+struct GLCallCounts {
+    /** State changes passed on to OpenGL, by `GLCallKind` */
+    uint64_t issued[GL_CALL_KIND_COUNT];
+
+    /** State changes skipped because the state was already set, by `GLCallKind` */
+    uint64_t elided[GL_CALL_KIND_COUNT];
+
+    /** Draw calls */
+    uint64_t draws;
+
+    /** Triangles submitted by those draws */
+    uint64_t triangles;
+
+    /** Returns the total number of skipped state changes */
+    uint64_t getElidedTotal() const;
+
+    /** Returns the total number of state changes passed on to OpenGL */
+    uint64_t getIssuedTotal() const;
+
+    /** Prints the counts on one line */
+    void print() const;
+};
+
+/**
+ * The `GLStateCache` class remembers which program, vertex array, buffers and
+ * textures are bound, and skips binds that wouldn't change anything.
+ *
+ * OpenGL state belongs to the context and the engine has one context, so the
+ * cache is static. For it to stay right, every bind and every delete of these
+ * objects must go through it (`Shader` and `Mesh` do). Code that changes the
+ * state behind its back, such as a third-party UI library, must call
+ * `invalidate` afterwards.
+ *
+ * The element array buffer binding is part of the vertex array, so it is
+ * forgotten whenever the vertex array changes.
+ */
+class GLStateCache {
+public:
+    /** The number of texture units tracked; binds to higher units are passed through */
+    static constexpr int TEXTURE_UNITS = 16;
+
+    /** glUseProgram, unless the program is already in use */
+    static void useProgram(GLuint program);
+
+    /** glBindVertexArray, unless the vertex array is already bound */
+    static void bindVertexArray(GLuint vertexArray);
+
+    /** glBindBuffer, unless the buffer is already bound to the target */
+    static void bindBuffer(GLenum target, GLuint buffer);
+
+    /**
+     * Binds a texture to a texture unit, skipping the glActiveTexture and
+     * glBindTexture calls that wouldn't change anything.
+     *
+     * @param unit    The texture unit, counting from 0 (not GL_TEXTURE0).
+     * @param target  The texture target, such as GL_TEXTURE_2D_ARRAY.
+     * @param texture The texture.
+     */
+    static void bindTexture(int unit, GLenum target, GLuint texture);
+
+    /** glDeleteProgram, forgetting the program if it was in use */
+    static void deleteProgram(GLuint program);
+
+    /** glDeleteVertexArrays for one vertex array, forgetting it if it was bound */
+    static void deleteVertexArray(GLuint vertexArray);
+
+    /** glDeleteBuffers for one buffer, forgetting it wherever it was bound */
+    static void deleteBuffer(GLuint buffer);
+
+    /** glDeleteTextures for one texture, forgetting it wherever it was bound */
+    static void deleteTexture(GLuint texture);
+
+    /**
+     * Counts one draw call.
+     *
+     * @param indexCount The number of triangle indices it submitted.
+     */
+    static void countDraw(uint64_t indexCount) {
+        ++counts.draws;
+        counts.triangles += indexCount / 3;
+    }
+
+    /**
+     * Forgets all cached state, so the next bind of each kind is always issued.
+     * Call after code outside the cache changed GL state.
+     */
+    static void invalidate();
+
+    /** Returns the counts since the last `takeCounts` */
+    static const GLCallCounts& getCounts() { return counts; }
+
+    /**
+     * Returns the counts since the last call and starts counting again.
+     * Call once per frame for per-frame numbers.
+     */
+    static GLCallCounts takeCounts();
+
+private:
+    /** Marks a binding whose value isn't known, so the next bind is always issued */
+    static constexpr GLuint UNKNOWN = 0xffffffffu;
+
+    /** The buffer targets that are tracked; binds to others are passed through */
+    enum BufferSlot { BUFFER_ARRAY, BUFFER_ELEMENT_ARRAY, BUFFER_UNIFORM, BUFFER_COPY_READ, BUFFER_COPY_WRITE,
+                      BUFFER_PIXEL_PACK, BUFFER_PIXEL_UNPACK, BUFFER_SLOT_COUNT };
+
+    /** The texture targets that are tracked; binds to others are passed through */
+    enum TextureSlot { TEXTURE_2D, TEXTURE_2D_ARRAY, TEXTURE_3D, TEXTURE_CUBE_MAP, TEXTURE_SLOT_COUNT };
+
+    /**
+     * Returns the tracking slot of a buffer target, or -1 if it isn't tracked.
+     */
+    static int bufferSlot(GLenum target);
+
+    /**
+     * Returns the tracking slot of a texture target, or -1 if it isn't tracked.
+     */
+    static int textureSlot(GLenum target);
+
+    /**
+     * Records one state change, issued or elided.
+     */
+    static void count(GLCallKind kind, bool issued);
+
+    /** The program in use */
+    static GLuint program;
+
+    /** The bound vertex array */
+    static GLuint vertexArray;
+
+    /** The buffer bound to each tracked target */
+    static GLuint buffers[BUFFER_SLOT_COUNT];
+
+    /** The active texture unit, counting from 0, or -1 if unknown */
+    static int activeUnit;
+
+    /** The texture bound to each tracked target of each unit */
+    static GLuint textures[TEXTURE_UNITS][TEXTURE_SLOT_COUNT];
+
+    /** The counts since the last `takeCounts` */
+    static GLCallCounts counts;
+};
+
+#endif  // Ends the conditional inclusion directive
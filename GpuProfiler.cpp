@@ -0,0 +1,296 @@
+// Includes the corresponding header file to access the GpuProfiler class declaration
+#include "GpuProfiler.h"
+
+// Includes std::ofstream, used to write traces
+#include <fstream>
+
+// Includes standard I/O for printing results and error messages to the console
+#include <iostream>
+
+// Includes std::fixed and std::setprecision, used to format times
+#include <iomanip>
+
+/** Returns the sum of the passes' GPU times */
+double GpuProfilerFrame::getGpuTime() const {
+    double total = 0.0;
+    for (const GpuProfilerPass& pass : passes) {
+        if (pass.gpuTime > 0.0) {
+            total += pass.gpuTime;
+        }
+    }
+    return total;
+}
+
+/**
+ * Constructor: Creates a profiler. Needs a current OpenGL context.
+ *
+ * @param latency  The number of frames in flight before results are dropped.
+ * @param history  The number of finished frames kept for `getHistory` and `writeTrace`.
+ */
+GpuProfiler::GpuProfiler(size_t latency, size_t history)
+    : slots(latency > 0 ? latency : 1), current(-1), frameCount(0), droppedFrames(0), historySize(history),
+      passOpen(false), gpuTimers(GLEW_ARB_timer_query), epoch(std::chrono::steady_clock::now()), clockOffset(0) {
+    for (Slot& slot : slots) {
+        slot.waiting = false;
+        slot.startQuery = 0;
+        if (gpuTimers) {
+            glGenQueries(1, &slot.startQuery);
+        }
+    }
+    calibrate();
+}
+
+/**
+ * Destructor: Deletes the query objects.
+ */
+GpuProfiler::~GpuProfiler() {
+    for (Slot& slot : slots) {
+        if (slot.startQuery) {
+            glDeleteQueries(1, &slot.startQuery);
+        }
+        if (!slot.passQueries.empty()) {
+            glDeleteQueries(GLsizei(slot.passQueries.size()), slot.passQueries.data());
+        }
+    }
+}
+
+/**
+ * Starts a frame, first collecting any earlier frames the GPU has finished.
+ */
+void GpuProfiler::beginFrame() {
+    if (current >= 0) {
+        endFrame();
+    }
+
+    // Collect oldest first so the history stays in order; the oldest slot is the one reused
+    size_t reuse = size_t(frameCount % slots.size());
+    for (size_t i = 0; i < slots.size(); ++i) {
+        collect(slots[(reuse + i) % slots.size()]);
+    }
+
+    Slot& slot = slots[reuse];
+    if (slot.waiting) {
+        // The GPU is more than a ring behind; waiting here would stall the frame
+        slot.waiting = false;
+        ++droppedFrames;
+    }
+
+    slot.frame.index = frameCount++;
+    slot.frame.passes.clear();
+    slot.frame.cpuStart = now();
+    slot.frame.cpuEnd = slot.frame.cpuStart;
+    slot.frame.gpuStart = -1.0;
+    if (gpuTimers) {
+        glQueryCounter(slot.startQuery, GL_TIMESTAMP);
+    }
+    current = int(reuse);
+}
+
+/**
+ * Starts a pass, ending the current one if there is one.
+ *
+ * @param name The pass name; must stay valid (a string literal).
+ */
+void GpuProfiler::beginPass(const char* name) {
+    if (current < 0) {
+        std::cout << "ERROR::GPU_PROFILER::PASS_OUTSIDE_FRAME " << name << std::endl;
+        return;
+    }
+    if (passOpen) {
+        endPass();
+    }
+
+    Slot& slot = slots[current];
+    slot.frame.passes.push_back(GpuProfilerPass{ name, now(), 0.0, -1.0 });
+
+    if (gpuTimers) {
+        size_t pass = slot.frame.passes.size() - 1;
+        if (pass >= slot.passQueries.size()) {
+            GLuint query = 0;
+            glGenQueries(1, &query);
+            slot.passQueries.push_back(query);
+        }
+        glBeginQuery(GL_TIME_ELAPSED, slot.passQueries[pass]);
+    }
+    passOpen = true;
+}
+
+/**
+ * Ends the current pass.
+ */
+void GpuProfiler::endPass() {
+    if (!passOpen) {
+        return;
+    }
+    if (gpuTimers) {
+        glEndQuery(GL_TIME_ELAPSED);
+    }
+    slots[current].frame.passes.back().cpuEnd = now();
+    passOpen = false;
+}
+
+/**
+ * Ends the frame (and its last pass).
+ */
+void GpuProfiler::endFrame() {
+    if (current < 0) {
+        return;
+    }
+    endPass();
+
+    Slot& slot = slots[current];
+    slot.frame.cpuEnd = now();
+    slot.waiting = true;
+    current = -1;
+}
+
+/**
+ * Returns the most recent frame the GPU has finished.
+ *
+ * @param frame Receives the frame.
+ * @return False if no frame has finished yet.
+ */
+bool GpuProfiler::getLatestFrame(GpuProfilerFrame& frame) const {
+    if (finished.empty()) {
+        return false;
+    }
+    frame = finished.back();
+    return true;
+}
+
+/**
+ * Prints the most recent finished frame, one line per pass.
+ */
+void GpuProfiler::printLatest() const {
+    GpuProfilerFrame frame;
+    if (!getLatestFrame(frame)) {
+        return;
+    }
+
+    std::cout << std::fixed << std::setprecision(3)
+              << "PROFILER::FRAME " << frame.index << " cpu " << frame.cpuEnd - frame.cpuStart << " ms";
+    if (gpuTimers) {
+        std::cout << " gpu " << frame.getGpuTime() << " ms, started " << frame.gpuStart - frame.cpuStart
+                  << " ms after the cpu";
+    }
+    std::cout << std::endl;
+
+    for (const GpuProfilerPass& pass : frame.passes) {
+        std::cout << "  " << pass.name << ": cpu " << pass.cpuEnd - pass.cpuStart << " ms";
+        if (gpuTimers) {
+            std::cout << " gpu " << pass.gpuTime << " ms";
+        }
+        std::cout << std::endl;
+    }
+    std::cout << std::defaultfloat;
+}
+
+/**
+ * Writes the kept frames as a Chrome trace, with the CPU and the GPU as separate tracks.
+ *
+ * @param path The output file.
+ * @return True if the file was written.
+ */
+bool GpuProfiler::writeTrace(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) {
+        std::cout << "ERROR::GPU_PROFILER::CANNOT_WRITE_TRACE " << path << std::endl;
+        return false;
+    }
+
+    // Trace times are in microseconds
+    out << std::fixed << std::setprecision(1);
+    out << "{\"traceEvents\":[\n";
+    out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"CPU\"}},\n";
+    out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"GPU\"}}";
+
+    auto event = [&out](const std::string& name, int track, double start, double duration) {
+        out << ",\n{\"name\":\"" << name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << track
+            << ",\"ts\":" << start * 1000.0 << ",\"dur\":" << duration * 1000.0 << "}";
+    };
+
+    for (const GpuProfilerFrame& frame : finished) {
+        std::string frameName = "frame " + std::to_string(frame.index);
+        event(frameName, 1, frame.cpuStart, frame.cpuEnd - frame.cpuStart);
+        for (const GpuProfilerPass& pass : frame.passes) {
+            event(pass.name, 1, pass.cpuStart, pass.cpuEnd - pass.cpuStart);
+        }
+
+        if (frame.gpuStart < 0.0) {
+            continue;
+        }
+
+        // Only durations are measured on the GPU, so its passes are laid out back to back
+        event(frameName, 2, frame.gpuStart, frame.getGpuTime());
+        double gpuTime = frame.gpuStart;
+        for (const GpuProfilerPass& pass : frame.passes) {
+            event(pass.name, 2, gpuTime, pass.gpuTime);
+            gpuTime += pass.gpuTime;
+        }
+    }
+
+    out << "\n]}\n";
+    return bool(out);
+}
+
+/**
+ * Measures the offset between the GPU clock and the CPU clock again.
+ */
+void GpuProfiler::calibrate() {
+    if (!gpuTimers) {
+        return;
+    }
+
+    GLint64 gpuTime = 0;
+    glGetInteger64v(GL_TIMESTAMP, &gpuTime);
+    int64_t cpuTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+    clockOffset = int64_t(gpuTime) - cpuTime;
+}
+
+/**
+ * Returns the time since the profiler was created, in milliseconds.
+ */
+double GpuProfiler::now() const {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+/**
+ * Reads the results of a slot if they are all available.
+ *
+ * @return True if the slot's frame was finished and recorded.
+ */
+bool GpuProfiler::collect(Slot& slot) {
+    if (!slot.waiting) {
+        return false;
+    }
+
+    GpuProfilerFrame& frame = slot.frame;
+    if (gpuTimers) {
+        // Check availability first: asking for a result that isn't ready blocks until it is
+        GLuint available = GL_FALSE;
+        glGetQueryObjectuiv(slot.startQuery, GL_QUERY_RESULT_AVAILABLE, &available);
+        for (size_t pass = 0; pass < frame.passes.size() && available; ++pass) {
+            glGetQueryObjectuiv(slot.passQueries[pass], GL_QUERY_RESULT_AVAILABLE, &available);
+        }
+        if (!available) {
+            return false;
+        }
+
+        GLuint64 start = 0;
+        glGetQueryObjectui64v(slot.startQuery, GL_QUERY_RESULT, &start);
+        frame.gpuStart = double(int64_t(start) - clockOffset) / 1.0e6;
+
+        for (size_t pass = 0; pass < frame.passes.size(); ++pass) {
+            GLuint64 elapsed = 0;
+            glGetQueryObjectui64v(slot.passQueries[pass], GL_QUERY_RESULT, &elapsed);
+            frame.passes[pass].gpuTime = double(elapsed) / 1.0e6;
+        }
+    }
+
+    finished.push_back(frame);
+    while (finished.size() > historySize) {
+        finished.pop_front();
+    }
+    slot.waiting = false;
+    return true;
+}
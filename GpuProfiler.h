@@ -0,0 +1,211 @@
+// Prevents multiple inclusions of this header file, which can cause redefinition errors
+#ifndef GPU_PROFILER_H
+#define GPU_PROFILER_H
+
+// Includes the OpenGL Extension Wrangler Library (GLEW), for query objects
+#include <GL/glew.h>
+
+// Includes std::chrono::steady_clock, the CPU clock
+#include <chrono>
+
+// Includes fixed-width integer types such as uint64_t
+#include <cstdint>
+
+// Includes the double-ended queue holding recent frames
+#include <deque>
+
+// Includes the C++ Standard Library string class, used for file paths
+#include <string>
+
+// Includes the vector container, used for passes and query objects
+#include <vector>
+
+/**
+ * The `GpuProfilerPass` struct holds the timing of one pass of a frame.
+ * Times are in milliseconds; CPU times count from the profiler's creation.
+ */
+struct GpuProfilerPass {
+    /** The pass name given to `beginPass` */
+    const char* name;
+
+    /** When the CPU started and finished submitting the pass */
+    double cpuStart, cpuEnd;
+
+    /** How long the GPU spent on the pass, or -1 without timer queries */
+    double gpuTime;
+};
+
+/**
+ * The `GpuProfilerFrame` struct holds the timing of one whole frame.
+ */
+struct GpuProfilerFrame {
+    /** The frame number, counting from 0 */
+    uint64_t index;
+
+    /** When the CPU began and ended the frame */
+    double cpuStart, cpuEnd;
+
+    /** When the GPU started the frame's work, on the CPU clock, or -1 if unknown */
+    double gpuStart;
+
+    /** The frame's passes, in submission order */
+    std::vector<GpuProfilerPass> passes;
+
+    /** Returns the sum of the passes' GPU times */
+    double getGpuTime() const;
+};
+
+/**
+ * The `GpuProfiler` class measures how long the CPU and the GPU spend on each
+ * pass of a frame (chunk draw, translucent draw, UI...).
+ *
+ * GPU time is measured with GL_TIME_ELAPSED queries. Results arrive a few
+ * frames late, so every frame gets its own set of query objects from a ring
+ * `latency` frames deep, and results are only read once GL reports them
+ * available: the profiler never waits for the GPU. If the GPU falls further
+ * behind than the ring, the oldest frame is dropped rather than waited for.
+ *
+ * A GL_TIMESTAMP query at the start of each frame, converted to the CPU clock,
+ * places the GPU work on the same timeline as the CPU work, so `writeTrace`
+ * can show both in chrome://tracing (GPU passes are laid out back to back
+ * from that point).
+ *
+ * GL_TIME_ELAPSED queries can't nest, so passes can't either: beginning a
+ * pass ends the previous one.
+ */
+class GpuProfiler {
+public:
+    /**
+     * Constructor: Creates a profiler. Needs a current OpenGL context.
+     *
+     * @param latency  The number of frames in flight before results are dropped.
+     * @param history  The number of finished frames kept for `getHistory` and `writeTrace`.
+     */
+    GpuProfiler(size_t latency = 4, size_t history = 240);
+
+    /**
+     * Destructor: Deletes the query objects.
+     */
+    ~GpuProfiler();
+
+    // The profiler owns GL objects, so it can't be copied
+    GpuProfiler(const GpuProfiler&) = delete;
+    GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+    /**
+     * Starts a frame, first collecting any earlier frames the GPU has finished.
+     */
+    void beginFrame();
+
+    /**
+     * Starts a pass, ending the current one if there is one.
+     *
+     * @param name The pass name; must stay valid (a string literal).
+     */
+    void beginPass(const char* name);
+
+    /**
+     * Ends the current pass.
+     */
+    void endPass();
+
+    /**
+     * Ends the frame (and its last pass).
+     */
+    void endFrame();
+
+    /** Returns true if GPU times are measured (the driver has timer queries) */
+    bool hasGpuTimers() const { return gpuTimers; }
+
+    /**
+     * Returns the most recent frame the GPU has finished.
+     *
+     * @param frame Receives the frame.
+     * @return False if no frame has finished yet.
+     */
+    bool getLatestFrame(GpuProfilerFrame& frame) const;
+
+    /** Returns the finished frames kept, oldest first */
+    const std::deque<GpuProfilerFrame>& getHistory() const { return finished; }
+
+    /** Returns the number of frames dropped because the GPU fell behind the ring */
+    uint64_t getDroppedFrames() const { return droppedFrames; }
+
+    /**
+     * Prints the most recent finished frame, one line per pass.
+     */
+    void printLatest() const;
+
+    /**
+     * Writes the kept frames as a Chrome trace (chrome://tracing or Perfetto),
+     * with the CPU and the GPU as separate tracks.
+     *
+     * @param path The output file.
+     * @return True if the file was written.
+     */
+    bool writeTrace(const std::string& path) const;
+
+    /**
+     * Measures the offset between the GPU clock and the CPU clock again.
+     * Done on creation; call occasionally if the clocks drift.
+     */
+    void calibrate();
+
+private:
+    /** One frame's worth of queries in the ring */
+    struct Slot {
+        /** The frame being measured, and whether it still waits for results */
+        GpuProfilerFrame frame;
+        bool waiting;
+
+        /** The GL_TIMESTAMP query at the start of the frame */
+        GLuint startQuery;
+
+        /** One GL_TIME_ELAPSED query per pass; grown on demand and reused */
+        std::vector<GLuint> passQueries;
+    };
+
+    /**
+     * Returns the time since the profiler was created, in milliseconds.
+     */
+    double now() const;
+
+    /**
+     * Reads the results of a slot if they are all available.
+     *
+     * @return True if the slot's frame was finished and recorded.
+     */
+    bool collect(Slot& slot);
+
+    /** The query ring, one slot per frame in flight */
+    std::vector<Slot> slots;
+
+    /** The slot of the current frame, or -1 between frames */
+    int current;
+
+    /** The number of frames started */
+    uint64_t frameCount;
+
+    /** Frames dropped because the ring wrapped before their results arrived */
+    uint64_t droppedFrames;
+
+    /** Finished frames, oldest first */
+    std::deque<GpuProfilerFrame> finished;
+
+    /** The most finished frames kept */
+    size_t historySize;
+
+    /** True if a pass is open */
+    bool passOpen;
+
+    /** True if the driver has timer queries */
+    bool gpuTimers;
+
+    /** The CPU clock's zero */
+    std::chrono::steady_clock::time_point epoch;
+
+    /** The GPU clock minus the CPU clock, in nanoseconds */
+    int64_t clockOffset;
+};
+
+#endif  // Ends the conditional inclusion directive
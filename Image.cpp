@@ -0,0 +1,83 @@
+// Includes the corresponding header file to access the Image struct declaration
+#include "Image.h"
+
+// Includes std::abs for integers
+#include <cstdlib>
+
+// Includes file streams, used to read and write images
+#include <fstream>
+
+// Includes standard I/O for printing error messages to the console
+#include <iostream>
+
+/**
+ * Saves the image as a binary PPM file.
+ *
+ * @return True if the file was written.
+ */
+bool Image::writePPM(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        std::cout << "ERROR::IMAGE::CANNOT_WRITE " << path << std::endl;
+        return false;
+    }
+
+    out << "P6\n" << width << " " << height << "\n255\n";
+    out.write(reinterpret_cast<const char*>(pixels.data()), std::streamsize(pixels.size()));
+    return bool(out);
+}
+
+/**
+ * Loads a binary PPM file with 8-bit channels.
+ *
+ * @return True if the file was read.
+ */
+bool Image::readPPM(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::string magic;
+    int maxValue = 0;
+    if (!(in >> magic >> width >> height >> maxValue) || magic != "P6" || maxValue != 255 || width <= 0 || height <= 0) {
+        std::cout << "ERROR::IMAGE::CANNOT_READ " << path << std::endl;
+        return false;
+    }
+
+    // A single whitespace byte separates the header from the pixels
+    in.get();
+    pixels.resize(size_t(width) * size_t(height) * 3);
+    in.read(reinterpret_cast<char*>(pixels.data()), std::streamsize(pixels.size()));
+    if (!in) {
+        std::cout << "ERROR::IMAGE::TRUNCATED " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Compares two images pixel by pixel.
+ *
+ * @param a, b      The images.
+ * @param tolerance The largest channel difference still counted as equal.
+ */
+ImageDifference Image::compare(const Image& a, const Image& b, int tolerance) {
+    ImageDifference difference = { 0, 0, a.width == b.width && a.height == b.height };
+    if (!difference.sameSize) {
+        difference.differingPixels = size_t(a.width) * size_t(a.height);
+        difference.maxChannelDifference = 255;
+        return difference;
+    }
+
+    for (size_t pixel = 0; pixel + 2 < a.pixels.size(); pixel += 3) {
+        int worst = 0;
+        for (size_t channel = 0; channel < 3; ++channel) {
+            int delta = std::abs(int(a.pixels[pixel + channel]) - int(b.pixels[pixel + channel]));
+            worst = delta > worst ? delta : worst;
+        }
+        if (worst > tolerance) {
+            ++difference.differingPixels;
+        }
+        if (worst > difference.maxChannelDifference) {
+            difference.maxChannelDifference = worst;
+        }
+    }
+    return difference;
+}
@@ -0,0 +1,66 @@
+// Prevents multiple inclusions of this header file, which can cause redefinition errors
+#ifndef IMAGE_H
+#define IMAGE_H
+
+// Includes fixed-width integer types such as uint8_t
+#include <cstdint>
+
+// Includes the C++ Standard Library string class, used for file paths
+#include <string>
+
+// Includes the vector container, used for the pixels
+#include <vector>
+
+/**
+ * The `ImageDifference` struct summarizes how two images differ.
+ */
+struct ImageDifference {
+    /** The number of pixels with any channel differing by more than the tolerance */
+    size_t differingPixels;
+
+    /** The largest difference of any channel of any pixel */
+    int maxChannelDifference;
+
+    /** True if the images have the same size */
+    bool sameSize;
+};
+
+/**
+ * The `Image` struct is an 8-bit RGB image, stored top row first, used for
+ * rendered frames and the reference images they are checked against.
+ *
+ * Images are saved as binary PPM (P6): no compression, but no library either,
+ * and every image viewer and diff tool reads it.
+ */
+struct Image {
+    int width = 0;
+    int height = 0;
+
+    /** Three bytes (red, green, blue) per pixel, row after row from the top */
+    std::vector<uint8_t> pixels;
+
+    /**
+     * Saves the image as a binary PPM file.
+     *
+     * @return True if the file was written.
+     */
+    bool writePPM(const std::string& path) const;
+
+    /**
+     * Loads a binary PPM file with 8-bit channels.
+     *
+     * @return True if the file was read.
+     */
+    bool readPPM(const std::string& path);
+
+    /**
+     * Compares two images pixel by pixel.
+     *
+     * @param a, b      The images.
+     * @param tolerance The largest channel difference still counted as equal, to allow
+     *                  for rounding differences between drivers.
+     */
+    static ImageDifference compare(const Image& a, const Image& b, int tolerance);
+};
+
+#endif  // Ends the conditional inclusion directive
@@ -0,0 +1,228 @@
+// Includes the corresponding header file to access the LZCodec class declaration
+#include "LZCodec.h"
+
+// Includes std::min and std::fill
+#include <algorithm>
+
+// Includes std::memcpy, used for unaligned loads and literal copies
+#include <cstring>
+
+// The hash table used to find match candidates has 2^HASH_BITS slots
+static const int HASH_BITS = 14;
+
+/**
+ * Loads 4 bytes from an unaligned address.
+ */
+static uint32_t read32(const uint8_t* p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+/**
+ * Hashes 4 bytes into a hash table slot (multiplicative hashing).
+ */
+static uint32_t hash4(uint32_t value) {
+    return (value * 2654435761u) >> (32 - HASH_BITS);
+}
+
+/**
+ * Appends a length that didn't fit in its token nibble, as a run of 255s plus a remainder.
+ */
+static void writeExtraLength(size_t length, std::vector<uint8_t>& out) {
+    while (length >= 255) {
+        out.push_back(255);
+        length -= 255;
+    }
+    out.push_back(uint8_t(length));
+}
+
+/**
+ * Reads a length extension written by `writeExtraLength`.
+ *
+ * @return False if the stream ended inside the extension.
+ */
+static bool readExtraLength(const uint8_t*& in, const uint8_t* end, size_t& length) {
+    uint8_t byte;
+    do {
+        if (in >= end) {
+            return false;
+        }
+        byte = *in++;
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+/**
+ * Appends one command: literals, then (unless `matchLength` is 0) a match.
+ */
+static void writeSequence(const uint8_t* literals, size_t literalLength, size_t offset, size_t matchLength,
+                          std::vector<uint8_t>& out) {
+    size_t matchCode = matchLength ? matchLength - LZCodec::MIN_MATCH : 0;
+
+    out.push_back(uint8_t((std::min<size_t>(literalLength, 15) << 4) | std::min<size_t>(matchCode, 15)));
+    if (literalLength >= 15) {
+        writeExtraLength(literalLength - 15, out);
+    }
+    out.insert(out.end(), literals, literals + literalLength);
+
+    if (matchLength) {
+        out.push_back(uint8_t(offset));
+        out.push_back(uint8_t(offset >> 8));
+        if (matchCode >= 15) {
+            writeExtraLength(matchCode - 15, out);
+        }
+    }
+}
+
+/**
+ * Compresses a buffer, appending the stream to `out`.
+ *
+ * @param input      The bytes to compress.
+ * @param inputSize  The number of input bytes.
+ * @param dictionary Bytes assumed to precede the input, or nullptr.
+ * @param dictSize   The dictionary length; only its last MAX_OFFSET bytes are used.
+ * @param out        Receives the compressed stream (appended).
+ */
+void LZCodec::compress(const uint8_t* input, size_t inputSize, const uint8_t* dictionary, size_t dictSize,
+                       std::vector<uint8_t>& out) {
+    // Only the end of the dictionary is reachable by a 16-bit offset
+    if (!dictionary) {
+        dictSize = 0;
+    }
+    if (dictSize > MAX_OFFSET) {
+        dictionary += dictSize - MAX_OFFSET;
+        dictSize = MAX_OFFSET;
+    }
+
+    // --- Lay the dictionary and input out back to back, so matches can cross between them ---
+    thread_local std::vector<uint8_t> window;
+    thread_local std::vector<int32_t> table;
+    window.resize(dictSize + inputSize);
+    if (dictSize) {
+        std::memcpy(window.data(), dictionary, dictSize);
+    }
+    std::memcpy(window.data() + dictSize, input, inputSize);
+
+    table.assign(size_t(1) << HASH_BITS, -1);
+    const uint8_t* base = window.data();
+    size_t end = dictSize + inputSize;
+
+    // Seed the hash table with every dictionary position
+    for (size_t p = 0; p + MIN_MATCH <= dictSize; ++p) {
+        table[hash4(read32(base + p))] = int32_t(p);
+    }
+
+    // --- Greedy parse: take the first match the hash table offers ---
+    size_t anchor = dictSize;
+    size_t ip = dictSize;
+    while (ip + MIN_MATCH <= end) {
+        uint32_t sequence = read32(base + ip);
+        uint32_t slot = hash4(sequence);
+        int32_t candidate = table[slot];
+        table[slot] = int32_t(ip);
+
+        if (candidate < 0 || ip - size_t(candidate) > MAX_OFFSET || read32(base + candidate) != sequence) {
+            ip++;
+            continue;
+        }
+
+        size_t length = MIN_MATCH;
+        while (ip + length < end && base[candidate + length] == base[ip + length]) {
+            length++;
+        }
+
+        writeSequence(base + anchor, ip - anchor, ip - size_t(candidate), length, out);
+
+        // Index a couple of positions inside the match so later data can refer to it
+        if (ip + length + MIN_MATCH <= end) {
+            size_t inside = ip + length - 2;
+            table[hash4(read32(base + inside))] = int32_t(inside);
+        }
+
+        ip += length;
+        anchor = ip;
+    }
+
+    // The final command holds whatever literals are left
+    writeSequence(base + anchor, end - anchor, 0, 0, out);
+}
+
+/**
+ * Decompresses a stream directly into caller-provided storage.
+ *
+ * @param input      The compressed stream.
+ * @param inputSize  The stream length, in bytes.
+ * @param dictionary The dictionary the stream was compressed with, or nullptr.
+ * @param dictSize   The dictionary length.
+ * @param output     Receives the decompressed bytes.
+ * @param outputSize The exact number of bytes the stream must produce.
+ * @return True if the stream was valid and produced exactly `outputSize` bytes.
+ */
+bool LZCodec::decompress(const uint8_t* input, size_t inputSize, const uint8_t* dictionary, size_t dictSize,
+                         uint8_t* output, size_t outputSize) {
+    if (!dictionary) {
+        dictSize = 0;
+    }
+    if (dictSize > MAX_OFFSET) {
+        dictionary += dictSize - MAX_OFFSET;
+        dictSize = MAX_OFFSET;
+    }
+
+    const uint8_t* in = input;
+    const uint8_t* inEnd = input + inputSize;
+    size_t produced = 0;
+
+    while (in < inEnd) {
+        uint8_t token = *in++;
+
+        // --- Literals ---
+        size_t literalLength = token >> 4;
+        if (literalLength == 15 && !readExtraLength(in, inEnd, literalLength)) {
+            return false;
+        }
+        if (literalLength > size_t(inEnd - in) || literalLength > outputSize - produced) {
+            return false;
+        }
+        std::memcpy(output + produced, in, literalLength);
+        in += literalLength;
+        produced += literalLength;
+
+        // The final command has no match
+        if (in == inEnd) {
+            break;
+        }
+
+        // --- Match ---
+        if (inEnd - in < 2) {
+            return false;
+        }
+        size_t offset = size_t(in[0]) | (size_t(in[1]) << 8);
+        in += 2;
+
+        size_t matchLength = token & 15;
+        if (matchLength == 15 && !readExtraLength(in, inEnd, matchLength)) {
+            return false;
+        }
+        matchLength += MIN_MATCH;
+
+        if (offset == 0 || offset > produced + dictSize || matchLength > outputSize - produced) {
+            return false;
+        }
+
+        if (offset <= produced && offset >= matchLength) {
+            // Common case: the whole match is earlier output and doesn't overlap
+            std::memcpy(output + produced, output + produced - offset, matchLength);
+        } else {
+            // Overlapping runs, or matches starting in the dictionary: copy byte by byte
+            ptrdiff_t source = ptrdiff_t(produced) - ptrdiff_t(offset);
+            for (size_t i = 0; i < matchLength; ++i, ++source) {
+                output[produced + i] = source < 0 ? dictionary[ptrdiff_t(dictSize) + source] : output[source];
+            }
+        }
+        produced += matchLength;
+    }
+
+    return produced == outputSize;
+}
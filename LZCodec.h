@@ -0,0 +1,63 @@
+// Prevents multiple inclusions of this header file, which can cause redefinition errors
+#ifndef LZ_CODEC_H
+#define LZ_CODEC_H
+
+// Includes size_t
+#include <cstddef>
+
+// Includes fixed-width integer types such as uint8_t
+#include <cstdint>
+
+// Includes the vector container used for compressed output
+#include <vector>
+
+/**
+ * The `LZCodec` class is a small byte-oriented LZ77 compressor with optional
+ * dictionary support.
+ *
+ * The stream is a sequence of LZ4-style commands: a token byte (literal count
+ * in the high nibble, match length minus 4 in the low nibble, both extended
+ * with 255-valued bytes when they reach 15), the literals, then a 16-bit match
+ * offset. The last command has literals only.
+ *
+ * A dictionary acts as data that "came before" the input: matches may point
+ * back into it. Chunk payloads are small and similar to each other, so a
+ * dictionary of common chunk content lets even the first bytes of a chunk be
+ * encoded as matches.
+ */
+class LZCodec {
+public:
+    /** The shortest match worth encoding */
+    static constexpr size_t MIN_MATCH = 4;
+
+    /** The furthest back a match can point (dictionary included) */
+    static constexpr size_t MAX_OFFSET = 65535;
+
+    /**
+     * Compresses a buffer, appending the stream to `out`.
+     *
+     * @param input      The bytes to compress.
+     * @param inputSize  The number of input bytes.
+     * @param dictionary Bytes assumed to precede the input, or nullptr.
+     * @param dictSize   The dictionary length; only its last MAX_OFFSET bytes are used.
+     * @param out        Receives the compressed stream (appended).
+     */
+    static void compress(const uint8_t* input, size_t inputSize, const uint8_t* dictionary, size_t dictSize,
+                         std::vector<uint8_t>& out);
+
+    /**
+     * Decompresses a stream directly into caller-provided storage.
+     *
+     * @param input      The compressed stream.
+     * @param inputSize  The stream length, in bytes.
+     * @param dictionary The dictionary the stream was compressed with, or nullptr.
+     * @param dictSize   The dictionary length.
+     * @param output     Receives the decompressed bytes.
+     * @param outputSize The exact number of bytes the stream must produce.
+     * @return True if the stream was valid and produced exactly `outputSize` bytes.
+     */
+    static bool decompress(const uint8_t* input, size_t inputSize, const uint8_t* dictionary, size_t dictSize,
+                           uint8_t* output, size_t outputSize);
+};
+
+#endif  // Ends the conditional inclusion directive
@@ -0,0 +1,79 @@
+// Includes the corresponding header file to access the LodSelector class declaration
+#include "LodSelector.h"
+
+// Includes std::max
+#include <algorithm>
+
+// Nearer than this (in blocks), a chunk is treated as touching the camera and always drawn at full detail
+static const float MIN_DISTANCE = 0.01f;
+
+/**
+ * Constructor: Creates a selector allowing a pixel of error.
+ *
+ * @param projection     The camera's projection matrix.
+ * @param viewportHeight The height of the viewport in pixels.
+ */
+LodSelector::LodSelector(const glm::mat4& projection, int viewportHeight) : errorThreshold(1.0f) {
+    setProjection(projection, viewportHeight);
+}
+
+/**
+ * Sets the projection the chunks are drawn with.
+ *
+ * @param projection     The camera's projection matrix.
+ * @param viewportHeight The height of the viewport in pixels.
+ */
+void LodSelector::setProjection(const glm::mat4& projection, int viewportHeight) {
+    // Y in clip space is projection[1][1] * y, divided by -z for a perspective projection
+    // (whose last row is (0, 0, -1, 0)); the viewport maps clip Y's [-1, 1] to its height
+    pixelsPerBlock = projection[1][1] * float(viewportHeight) * 0.5f;
+    orthographic = projection[3][3] != 0.0f;
+}
+
+/**
+ * Returns the pixels a geometric error covers at a distance from the camera.
+ *
+ * @param geometricError The error in blocks.
+ * @param distance       The distance in blocks.
+ */
+float LodSelector::getScreenError(float geometricError, float distance) const {
+    if (orthographic) {
+        return geometricError * pixelsPerBlock;
+    }
+    return geometricError * pixelsPerBlock / std::max(distance, MIN_DISTANCE);
+}
+
+/**
+ * Picks the coarsest level of a chunk whose error stays within the threshold.
+ *
+ * @param geometricErrors Each level's geometric error.
+ * @param chunkOffset     The chunk's lowest corner relative to the camera.
+ * @return The level.
+ */
+int LodSelector::select(const float (&geometricErrors)[CHUNK_LOD_COUNT], const glm::vec3& chunkOffset) const {
+    float distance = distanceToChunk(chunkOffset);
+
+    // Each level is measured against full detail, but take the largest so far anyway,
+    // so a coarser level is never chosen for showing less error than a finer one
+    int lod = 0;
+    float error = 0.0f;
+    for (int level = 1; level < CHUNK_LOD_COUNT; ++level) {
+        error = std::max(error, geometricErrors[level]);
+        if (getScreenError(error, distance) > errorThreshold) {
+            break;
+        }
+        lod = level;
+    }
+    return lod;
+}
+
+/**
+ * Returns the distance from the camera to the nearest point of a chunk, 0 inside it.
+ *
+ * @param chunkOffset The chunk's lowest corner relative to the camera.
+ */
+float LodSelector::distanceToChunk(const glm::vec3& chunkOffset) {
+    // The camera is the origin: clamp it into the chunk's box
+    glm::vec3 nearest = glm::clamp(glm::vec3(0.0f), chunkOffset, chunkOffset + float(CHUNK_SIZE));
+    return glm::length(nearest);
+}
@@ -0,0 +1,85 @@
+// Prevents multiple inclusions of this header file, which can cause redefinition errors
+#ifndef LOD_SELECTOR_H
+#define LOD_SELECTOR_H
+
+#include <glm/glm.hpp> // GLM for vector and matrix types
+
+#include "ChunkMesher.h" // CHUNK_LOD_COUNT and the geometric error of each level
+
+/**
+ * The `LodSelector` class picks the level of detail each chunk is drawn at
+ * from how large its simplification would look on screen, instead of from
+ * fixed distance rings.
+ *
+ * Each level's mesh carries its geometric error, the farthest its surface
+ * moved from full detail (see `ChunkMesher::build`). Seen from a distance d
+ * through the projection, an error e covers
+ *
+ *   e * projection[1][1] * viewportHeight / 2 / d
+ *
+ * pixels. A chunk gets the coarsest level whose error, measured from the
+ * nearest point of the chunk, stays within the pixel threshold. So flat or
+ * empty chunks, whose coarse levels lose nothing, go coarse right next to
+ * the camera, while rough ones keep their detail until it would no longer
+ * show; a narrower field of view or a taller window keeps detail further out.
+ */
+class LodSelector {
+public:
+    /**
+     * Constructor: Creates a selector allowing a pixel of error.
+     *
+     * @param projection     The camera's projection matrix.
+     * @param viewportHeight The height of the viewport in pixels.
+     */
+    LodSelector(const glm::mat4& projection, int viewportHeight);
+
+    /**
+     * Sets the projection the chunks are drawn with, after a resize or field of view change.
+     *
+     * @param projection     The camera's projection matrix.
+     * @param viewportHeight The height of the viewport in pixels.
+     */
+    void setProjection(const glm::mat4& projection, int viewportHeight);
+
+    /**
+     * Sets the error, in pixels, a level may show. To follow `ViewSettings::lodScale`,
+     * pass a base threshold divided by the scale.
+     */
+    void setErrorThreshold(float pixels) { errorThreshold = pixels; }
+
+    /**
+     * Returns the pixels a geometric error covers at a distance from the camera.
+     *
+     * @param geometricError The error in blocks.
+     * @param distance       The distance in blocks.
+     */
+    float getScreenError(float geometricError, float distance) const;
+
+    /**
+     * Picks the coarsest level of a chunk whose error stays within the threshold.
+     *
+     * @param geometricErrors Each level's `ChunkMeshData::geometricError`.
+     * @param chunkOffset     The chunk's lowest corner relative to the camera.
+     * @return The level, 0 to CHUNK_LOD_COUNT - 1.
+     */
+    int select(const float (&geometricErrors)[CHUNK_LOD_COUNT], const glm::vec3& chunkOffset) const;
+
+    /**
+     * Returns the distance from the camera to the nearest point of a chunk, 0 inside it.
+     *
+     * @param chunkOffset The chunk's lowest corner relative to the camera.
+     */
+    static float distanceToChunk(const glm::vec3& chunkOffset);
+
+private:
+    /** Pixels per block of error one block from the camera (perspective), or at any distance (orthographic) */
+    float pixelsPerBlock;
+
+    /** True if the projection is orthographic, where distance doesn't shrink the error */
+    bool orthographic;
+
+    /** The error, in pixels, a level may show */
+    float errorThreshold;
+};
+
+#endif  // Ends the conditional inclusion directive
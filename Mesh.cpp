@@ -1,6 +1,12 @@
 // Includes the corresponding header file to access the Mesh class declaration
 #include "Mesh.h"
 
+// Includes the GL state cache, which skips binds that wouldn't change anything
+#include "GLStateCache.h"
+
+// Includes the render backend, which every GL call goes through
+#include "RenderBackend.h"
+
 /**
  * Constructor: Initializes the mesh by setting up the Vertex Array Object (VAO),
  * Vertex Buffer Object (VBO), and Element Buffer Object (EBO).
@@ -17,28 +23,77 @@ Mesh::Mesh(const std::vector<float>& vertices, const std::vector<unsigned int>&
  * Destructor: Cleans up allocated OpenGL objects when the mesh is destroyed.
  */
 Mesh::~Mesh() {
-    // Deletes the VAO (Vertex Array Object)
-    glDeleteVertexArrays(1, &VAO);
+    // Deletes the VAO (Vertex Array Object); through the state cache, which must forget deleted bindings
+    GLStateCache::deleteVertexArray(VAO);
 
     // Deletes the VBO (Vertex Buffer Object)
-    glDeleteBuffers(1, &VBO);
+    GLStateCache::deleteBuffer(VBO);
 
     // Deletes the EBO (Element Buffer Object)
-    glDeleteBuffers(1, &EBO);
+    GLStateCache::deleteBuffer(EBO);
 }
 
 /**
  * Draws the mesh by binding its VAO and calling OpenGL’s draw function.
  */
 void Mesh::draw() const {
-    // Bind the VAO (which contains all vertex and index data)
-    glBindVertexArray(VAO);
+    // Bind the VAO (which contains all vertex and index data); skipped if it is already bound
+    GLStateCache::bindVertexArray(VAO);
 
     // Draws the mesh using indexed drawing (GL_TRIANGLES mode means each 3 indices form a triangle)
-    glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0);
+    RenderBackend::get().drawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0);
+    GLStateCache::countDraw(indexCount);
+
+    // The VAO stays bound: unbinding it would only cost another bind on the next draw
+    // of the same mesh. Anything that modifies a VAO binds its own first.
+}
+
+/**
+ * Draws some ranges of the mesh's indices in a single call.
+ *
+ * @param firstIndices The first index of each range.
+ * @param indexCounts  The number of indices of each range.
+ * @param rangeCount   The number of ranges.
+ */
+void Mesh::drawRanges(const unsigned int* firstIndices, const unsigned int* indexCounts, int rangeCount) const {
+    GLStateCache::bindVertexArray(VAO);
+
+    // A mesh has at most a few ranges (one per face direction), so the arguments fit on the stack
+    GLsizei counts[8];
+    size_t offsets[8];
+    uint64_t submitted = 0;
+    int drawCount = 0;
+    for (int i = 0; i < rangeCount && drawCount < 8; ++i) {
+        if (indexCounts[i] > 0) {
+            counts[drawCount] = GLsizei(indexCounts[i]);
+            offsets[drawCount] = firstIndices[i] * sizeof(unsigned int);
+            submitted += indexCounts[i];
+            ++drawCount;
+        }
+    }
+    if (drawCount == 0) {
+        return;
+    }
+
+    // One range is an ordinary draw; several go to the driver in one call
+    RenderBackend& backend = RenderBackend::get();
+    if (drawCount == 1) {
+        backend.drawElements(GL_TRIANGLES, counts[0], GL_UNSIGNED_INT, offsets[0]);
+    } else {
+        backend.multiDrawElements(GL_TRIANGLES, counts, GL_UNSIGNED_INT, offsets, drawCount);
+    }
+    GLStateCache::countDraw(submitted);
+}
 
-    // Unbind the VAO after drawing (optional, but good practice)
-    glBindVertexArray(0);
+/**
+ * Constructor: Initializes a mesh from packed 32-bit vertices.
+ *
+ * @param vertices One packed value per vertex.
+ * @param indices  A vector of unsigned integers representing the order of vertices in drawing.
+ */
+Mesh::Mesh(const std::vector<uint32_t>& vertices, const std::vector<unsigned int>& indices) {
+    // Calls the packed overload, which declares an integer vertex attribute
+    setupMesh(vertices, indices);
 }
 
 /**
@@ -48,41 +103,76 @@ void Mesh::draw() const {
  * @param indices  A vector of unsigned integers representing the order of vertices in drawing.
  */
 void Mesh::setupMesh(const std::vector<float>& vertices, const std::vector<unsigned int>& indices) {
+    // Create the buffers and upload both arrays; the VAO stays bound for the attribute setup
+    uploadBuffers(vertices.data(), vertices.size() * sizeof(float), indices);
+
+    // --- Define Vertex Attribute Layout ---
+    
+    // Configure how OpenGL should interpret the vertex data:
+    // Attribute index 0 -> 3 floats per vertex (x, y, z), no normalization, tightly packed
+    RenderBackend& backend = RenderBackend::get();
+    backend.vertexAttribPointer(0, 3, GL_FLOAT, false, 3 * sizeof(float), 0);
+
+    // Enable the attribute so OpenGL knows to use it
+    backend.enableVertexAttribArray(0);
+
+    // Unbind the VBO (optional, but a good practice)
+    GLStateCache::bindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // Unbind the VAO to prevent accidental modification
+    GLStateCache::bindVertexArray(0);
+}
+
+/**
+ * Sets up the mesh data from packed 32-bit vertices.
+ *
+ * @param vertices The packed vertex data to be uploaded.
+ * @param indices  A vector of unsigned integers representing the order of vertices in drawing.
+ */
+void Mesh::setupMesh(const std::vector<uint32_t>& vertices, const std::vector<unsigned int>& indices) {
+    uploadBuffers(vertices.data(), vertices.size() * sizeof(uint32_t), indices);
+
+    // --- Define Vertex Attribute Layout ---
+
+    // Attribute index 0 -> 1 unsigned integer per vertex. The "I" variant keeps the bits
+    // intact instead of converting them to float, so the shader can unpack the fields.
+    RenderBackend& backend = RenderBackend::get();
+    backend.vertexAttribIPointer(0, 1, GL_UNSIGNED_INT, sizeof(uint32_t), 0);
+    backend.enableVertexAttribArray(0);
+
+    GLStateCache::bindBuffer(GL_ARRAY_BUFFER, 0);
+    GLStateCache::bindVertexArray(0);
+}
+
+/**
+ * Creates the VAO, VBO and EBO and uploads the vertex and index data, leaving the VAO and VBO bound.
+ *
+ * @param vertexData  The vertex data to be uploaded.
+ * @param vertexBytes The size of the vertex data, in bytes.
+ * @param indices     The index data to be uploaded.
+ */
+void Mesh::uploadBuffers(const void* vertexData, size_t vertexBytes, const std::vector<unsigned int>& indices) {
     // Store the number of indices for later use in drawing
     indexCount = indices.size();
 
     // Generate OpenGL objects: a VAO, a VBO, and an EBO
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-    glGenBuffers(1, &EBO);
+    RenderBackend& backend = RenderBackend::get();
+    VAO = backend.createVertexArray();
+    VBO = backend.createBuffer();
+    EBO = backend.createBuffer();
 
     // --- Configure VAO ---
-    glBindVertexArray(VAO);
+    GLStateCache::bindVertexArray(VAO);
 
     // --- Upload Vertex Data to VBO ---
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    GLStateCache::bindBuffer(GL_ARRAY_BUFFER, VBO);
 
     // Copy vertex data into the buffer (GL_STATIC_DRAW suggests the data won't change frequently)
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+    backend.bufferData(GL_ARRAY_BUFFER, vertexBytes, vertexData, GL_STATIC_DRAW);
 
     // --- Upload Index Data to EBO ---
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+    GLStateCache::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
 
     // Copy index data into the buffer
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
-
-    // --- Define Vertex Attribute Layout ---
-    
-    // Configure how OpenGL should interpret the vertex data:
-    // Attribute index 0 -> 3 floats per vertex (x, y, z), no normalization, tightly packed
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
-
-    // Enable the attribute so OpenGL knows to use it
-    glEnableVertexAttribArray(0);
-
-    // Unbind the VBO (optional, but a good practice)
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-    // Unbind the VAO to prevent accidental modification
-    glBindVertexArray(0);
+    backend.bufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
 }
@@ -10,6 +10,12 @@
 // used to store dynamic arrays of data
 #include <vector>
 
+// Includes fixed-width integer types such as uint32_t, used for packed vertices
+#include <cstdint>
+
+// Includes size_t
+#include <cstddef>
+
 /**
  * The `Mesh` class represents a 3D mesh in OpenGL.
  * A mesh is a collection of vertices (points in 3D space) 
@@ -27,6 +33,17 @@ public:
      */
     Mesh(const std::vector<float>& vertices, const std::vector<unsigned int>& indices);
 
+    /**
+     * Constructor: Initializes a mesh from packed 32-bit vertices, such as the
+     * chunk meshes built by `ChunkMesher`. The shader reads them as an unsigned
+     * integer at attribute location 0 and unpacks the fields itself.
+     *
+     * @param vertices One packed value per vertex.
+     * @param indices  A list of unsigned integers representing
+     *                how the vertices should be connected to form triangles.
+     */
+    Mesh(const std::vector<uint32_t>& vertices, const std::vector<unsigned int>& indices);
+
     /**
      * Destructor: Cleans up GPU resources when the mesh object is destroyed.
      */
@@ -35,9 +52,26 @@ public:
     /**
      * Renders the mesh on the screen using OpenGL.
      * This function binds the necessary buffers and issues a draw call.
+     * The vertex array is left bound, so drawing the same mesh again binds nothing.
      */
     void draw() const;
 
+    /**
+     * Renders some ranges of the mesh's indices, in a single call (glMultiDrawElements).
+     * Used to skip the parts of a chunk mesh facing away from the camera.
+     *
+     * @param firstIndices The first index of each range.
+     * @param indexCounts  The number of indices of each range.
+     * @param rangeCount   The number of ranges, at most 8.
+     */
+    void drawRanges(const unsigned int* firstIndices, const unsigned int* indexCounts, int rangeCount) const;
+
+    /** Returns the OpenGL ID of the vertex array, which identifies the mesh in draw sort keys */
+    GLuint getVertexArray() const { return VAO; }
+
+    /** Returns the number of indices drawn */
+    unsigned int getIndexCount() const { return indexCount; }
+
 private:
     // OpenGL handles for storing mesh data in GPU memory
 
@@ -60,6 +94,19 @@ private:
      * @param indices  The index data to be uploaded.
      */
     void setupMesh(const std::vector<float>& vertices, const std::vector<unsigned int>& indices);
+
+    /**
+     * Sets up the mesh by sending packed vertex data and index data to the GPU.
+     *
+     * @param vertices The packed vertex data to be uploaded.
+     * @param indices  The index data to be uploaded.
+     */
+    void setupMesh(const std::vector<uint32_t>& vertices, const std::vector<unsigned int>& indices);
+
+    /**
+     * Creates the VAO, VBO and EBO and uploads the vertex and index data, leaving the VAO and VBO bound.
+     */
+    void uploadBuffers(const void* vertexData, size_t vertexBytes, const std::vector<unsigned int>& indices);
 };
 
 #endif  // Ends the conditional inclusion directive
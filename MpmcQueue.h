@@ -0,0 +1,175 @@
+// Prevents multiple inclusions of this header file, which can cause redefinition errors
+#ifndef MPMC_QUEUE_H
+#define MPMC_QUEUE_H
+
+// Includes std::atomic, the positions and per-cell sequence numbers
+#include <atomic>
+
+// Includes size_t
+#include <cstddef>
+
+// Includes std::unique_ptr, which owns the cells
+#include <memory>
+
+// Includes std::this_thread::yield, used by `push` while the queue is full
+#include <thread>
+
+// Includes std::move
+#include <utility>
+
+/**
+ * The `MpmcQueue` class is a bounded lock-free queue any number of threads
+ * can push to and pop from at once, for handing results (finished meshes,
+ * light, physics shapes) from workers to the main thread without a mutex.
+ *
+ * It is a ring of cells, each with a sequence number saying whose turn the
+ * cell is: a producer may fill cell `pos % capacity` when its sequence is
+ * `pos`, and publishes it by setting it to `pos + 1`; the consumer of `pos`
+ * takes the value and hands the cell to the next lap with `pos + capacity`.
+ * Producers and consumers each claim positions with one compare-and-swap
+ * on their own counter, and only ever wait on each other through a cell,
+ * so a stalled thread blocks no one but the thread needing that cell.
+ *
+ * `popBatch` claims a run of published cells with a single compare-and-swap,
+ * so a consumer draining a frame's results touches the shared counter once
+ * rather than once per item.
+ *
+ * The capacity is rounded up to a power of two. `T` must be default
+ * constructible and move assignable.
+ */
+template <typename T>
+class MpmcQueue {
+public:
+    /**
+     * Constructor: Creates an empty queue.
+     *
+     * @param capacity The most items the queue holds, rounded up to a power of two.
+     */
+    explicit MpmcQueue(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        mask = size - 1;
+        cells.reset(new Cell[size]);
+        for (size_t i = 0; i < size; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        enqueuePosition.store(0, std::memory_order_relaxed);
+        dequeuePosition.store(0, std::memory_order_relaxed);
+    }
+
+    // The cells hold atomics and other threads hold positions in them, so the queue can't be copied
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    /**
+     * Appends an item unless the queue is full.
+     *
+     * @param value The item; moved from only if it was appended.
+     * @return False if the queue is full.
+     */
+    bool tryPush(T&& value) {
+        size_t position = enqueuePosition.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells[position & mask];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            ptrdiff_t lag = ptrdiff_t(sequence) - ptrdiff_t(position);
+            if (lag == 0) {
+                // The cell is free on this lap; claim the position, or learn the one another producer left
+                if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    cell.value = std::move(value);
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (lag < 0) {
+                return false; // Still holds last lap's item: full
+            } else {
+                position = enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * Appends an item, yielding while the queue is full.
+     */
+    void push(T value) {
+        while (!tryPush(std::move(value))) {
+            std::this_thread::yield();
+        }
+    }
+
+    /**
+     * Takes the oldest item, if there is one.
+     *
+     * @return False if the queue is empty.
+     */
+    bool tryPop(T& out) { return popBatch(&out, 1) == 1; }
+
+    /**
+     * Takes up to `maxCount` of the oldest items at once.
+     *
+     * @param out      Receives the items, oldest first.
+     * @param maxCount The most items to take.
+     * @return The number taken; 0 if the queue is empty.
+     */
+    size_t popBatch(T* out, size_t maxCount) {
+        size_t position = dequeuePosition.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& first = cells[position & mask];
+            ptrdiff_t lag = ptrdiff_t(first.sequence.load(std::memory_order_acquire)) - ptrdiff_t(position + 1);
+            if (lag < 0) {
+                return 0; // Not published yet: empty
+            }
+            if (lag > 0) {
+                // Another consumer took it already
+                position = dequeuePosition.load(std::memory_order_relaxed);
+                continue;
+            }
+
+            // Extend the run over the published cells after it. They stay published until their
+            // position's consumer takes them, which is whoever wins the compare-and-swap below
+            size_t count = 1;
+            while (count < maxCount && count <= mask &&
+                   cells[(position + count) & mask].sequence.load(std::memory_order_acquire) == position + count + 1) {
+                ++count;
+            }
+
+            if (dequeuePosition.compare_exchange_weak(position, position + count, std::memory_order_relaxed)) {
+                for (size_t i = 0; i < count; ++i) {
+                    Cell& cell = cells[(position + i) & mask];
+                    out[i] = std::move(cell.value);
+                    cell.sequence.store(position + i + mask + 1, std::memory_order_release);
+                }
+                return count;
+            }
+        }
+    }
+
+    /** Returns the most items the queue holds */
+    size_t getCapacity() const { return mask + 1; }
+
+private:
+    /**
+     * The `Cell` struct is one slot of the ring.
+     */
+    struct Cell {
+        /** Whose turn the cell is (see the class comment) */
+        std::atomic<size_t> sequence;
+
+        /** The item, valid between its push and its pop */
+        T value;
+    };
+
+    /** The ring; its size is a power of two */
+    std::unique_ptr<Cell[]> cells;
+
+    /** The ring size minus one, masking positions to cells */
+    size_t mask;
+
+    /** The next position to push and to pop, on cache lines of their own so producers and consumers don't contend */
+    alignas(64) std::atomic<size_t> enqueuePosition;
+    alignas(64) std::atomic<size_t> dequeuePosition;
+};
+
+#endif  // Ends the conditional inclusion directive
@@ -0,0 +1,158 @@
+// Includes the corresponding header file to access the OffscreenContext class declaration
+#include "OffscreenContext.h"
+
+// Includes standard I/O for printing error messages to the console
+#include <iostream>
+
+// Includes std::memcpy, used to flip rows
+#include <cstring>
+
+// EGL extension declarations, for choosing the surfaceless platform
+#include <EGL/eglext.h>
+
+/**
+ * Constructor: Creates an object with no context yet; call `create`.
+ */
+OffscreenContext::OffscreenContext()
+    : display(EGL_NO_DISPLAY), context(EGL_NO_CONTEXT), framebuffer(0), colorBuffer(0), depthBuffer(0), width(0),
+      height(0) {}
+
+/**
+ * Destructor: Destroys the framebuffer and the context.
+ */
+OffscreenContext::~OffscreenContext() {
+    destroy();
+}
+
+/**
+ * Creates the context, makes it current, loads GL functions through GLEW and
+ * binds a framebuffer of the given size with color and depth.
+ *
+ * @param width, height The framebuffer size in pixels.
+ * @return True if everything was created.
+ */
+bool OffscreenContext::create(int width, int height) {
+    this->width = width;
+    this->height = height;
+
+    // Prefer the surfaceless platform, which needs no display server; fall back to the default display
+    auto getPlatformDisplay =
+        reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    if (getPlatformDisplay) {
+        display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    }
+    if (display == EGL_NO_DISPLAY) {
+        display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    }
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr)) {
+        std::cout << "ERROR::OFFSCREEN::NO_DISPLAY 0x" << std::hex << eglGetError() << std::dec << std::endl;
+        display = EGL_NO_DISPLAY;
+        return false;
+    }
+
+    // No surface is ever created, so any config that supports desktop OpenGL will do
+    const EGLint configAttributes[] = { EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE };
+    EGLConfig config = nullptr;
+    EGLint configCount = 0;
+    if (!eglBindAPI(EGL_OPENGL_API) || !eglChooseConfig(display, configAttributes, &config, 1, &configCount)) {
+        std::cout << "ERROR::OFFSCREEN::NO_OPENGL 0x" << std::hex << eglGetError() << std::dec << std::endl;
+        destroy();
+        return false;
+    }
+
+    // The same version and profile the window path asks SDL for
+    const EGLint contextAttributes[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 3,
+        EGL_CONTEXT_MINOR_VERSION, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+    context = eglCreateContext(display, configCount > 0 ? config : nullptr, EGL_NO_CONTEXT, contextAttributes);
+    if (context == EGL_NO_CONTEXT || !eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context)) {
+        std::cout << "ERROR::OFFSCREEN::CONTEXT_FAILED 0x" << std::hex << eglGetError() << std::dec << std::endl;
+        destroy();
+        return false;
+    }
+
+    // glewInit looks for a GLX display, which a surfaceless context doesn't have; only the context is needed
+    glewExperimental = GL_TRUE;
+    if (glewContextInit() != GLEW_OK) {
+        std::cout << "ERROR::OFFSCREEN::GLEW_FAILED" << std::endl;
+        destroy();
+        return false;
+    }
+
+    // With no window there is no default framebuffer, so render into renderbuffers
+    glGenFramebuffers(1, &framebuffer);
+    glGenRenderbuffers(1, &colorBuffer);
+    glGenRenderbuffers(1, &depthBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::cout << "ERROR::OFFSCREEN::FRAMEBUFFER_INCOMPLETE" << std::endl;
+        destroy();
+        return false;
+    }
+
+    glViewport(0, 0, width, height);
+    return true;
+}
+
+/**
+ * Waits for rendering to finish and reads the framebuffer.
+ *
+ * @param image Receives the frame, top row first.
+ */
+void OffscreenContext::readPixels(Image& image) const {
+    image.width = width;
+    image.height = height;
+    image.pixels.resize(size_t(width) * size_t(height) * 3);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, image.pixels.data());
+
+    // GL returns the bottom row first
+    size_t rowBytes = size_t(width) * 3;
+    std::vector<uint8_t> row(rowBytes);
+    for (int top = 0, bottom = height - 1; top < bottom; ++top, --bottom) {
+        uint8_t* topRow = image.pixels.data() + size_t(top) * rowBytes;
+        uint8_t* bottomRow = image.pixels.data() + size_t(bottom) * rowBytes;
+        std::memcpy(row.data(), topRow, rowBytes);
+        std::memcpy(topRow, bottomRow, rowBytes);
+        std::memcpy(bottomRow, row.data(), rowBytes);
+    }
+}
+
+/** Returns the GL_RENDERER string */
+std::string OffscreenContext::getRenderer() const {
+    const GLubyte* renderer = context != EGL_NO_CONTEXT ? glGetString(GL_RENDERER) : nullptr;
+    return renderer ? reinterpret_cast<const char*>(renderer) : "";
+}
+
+/**
+ * Destroys whatever `create` made.
+ */
+void OffscreenContext::destroy() {
+    if (context != EGL_NO_CONTEXT && framebuffer != 0) {
+        glDeleteFramebuffers(1, &framebuffer);
+        glDeleteRenderbuffers(1, &colorBuffer);
+        glDeleteRenderbuffers(1, &depthBuffer);
+    }
+    framebuffer = colorBuffer = depthBuffer = 0;
+
+    if (display != EGL_NO_DISPLAY) {
+        eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        if (context != EGL_NO_CONTEXT) {
+            eglDestroyContext(display, context);
+        }
+        eglTerminate(display);
+    }
+    context = EGL_NO_CONTEXT;
+    display = EGL_NO_DISPLAY;
+}
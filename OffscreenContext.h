@@ -0,0 +1,82 @@
+// Prevents multiple inclusions of this header file, which can cause redefinition errors
+#ifndef OFFSCREEN_CONTEXT_H
+#define OFFSCREEN_CONTEXT_H
+
+// EGL, which creates OpenGL contexts without a window system
+#include <EGL/egl.h>
+
+// Includes the OpenGL Extension Wrangler Library (GLEW)
+#include <GL/glew.h>
+
+// Includes the C++ Standard Library string class, used for the renderer name
+#include <string>
+
+#include "Image.h" // Rendered frames are read back into images
+
+/**
+ * The `OffscreenContext` class creates an OpenGL 3.3 core context with no
+ * window, rendering into a framebuffer object instead.
+ *
+ * It uses EGL on the surfaceless platform (EGL_MESA_platform_surfaceless),
+ * so it needs neither a display server nor a GPU: on a build machine Mesa's
+ * llvmpipe renders on the CPU. This lets the whole rendering path — shaders,
+ * meshes, batching — run and be timed in CI, with the final frame saved for
+ * visual regression checks.
+ *
+ * Only compiled when EGL is found (KYBUS_HAVE_EGL).
+ */
+class OffscreenContext {
+public:
+    /**
+     * Constructor: Creates an object with no context yet; call `create`.
+     */
+    OffscreenContext();
+
+    /**
+     * Destructor: Destroys the framebuffer and the context.
+     */
+    ~OffscreenContext();
+
+    // The context is an OS resource, so it can't be copied
+    OffscreenContext(const OffscreenContext&) = delete;
+    OffscreenContext& operator=(const OffscreenContext&) = delete;
+
+    /**
+     * Creates the context, makes it current, loads GL functions through GLEW and
+     * binds a framebuffer of the given size with color and depth.
+     *
+     * @param width, height The framebuffer size in pixels.
+     * @return True if everything was created.
+     */
+    bool create(int width, int height);
+
+    /**
+     * Waits for rendering to finish and reads the framebuffer.
+     *
+     * @param image Receives the frame, top row first.
+     */
+    void readPixels(Image& image) const;
+
+    /** Returns the GL_RENDERER string, such as "llvmpipe (LLVM 15.0.7, 256 bits)" */
+    std::string getRenderer() const;
+
+private:
+    /**
+     * Destroys whatever `create` made.
+     */
+    void destroy();
+
+    /** The EGL display and context */
+    EGLDisplay display;
+    EGLContext context;
+
+    /** The framebuffer and its color and depth renderbuffers */
+    GLuint framebuffer;
+    GLuint colorBuffer;
+    GLuint depthBuffer;
+
+    /** The framebuffer size */
+    int width, height;
+};
+
+#endif  // Ends the conditional inclusion directive
@@ -0,0 +1,354 @@
+// Includes the corresponding header file to access the RecordingRenderBackend class declaration
+#include "RecordingRenderBackend.h"
+
+/**
+ * Constructor: Creates a backend with no objects.
+ *
+ * @param recording If false, only count calls (no buffer copies or draw records).
+ */
+RecordingRenderBackend::RecordingRenderBackend(bool recording)
+    : recording(recording), compileFails(false), nextName(1), boundVertexArray(0), activeUnit(0), texture0(0),
+      program(0), colorWrites(true), depthWrites(true), depthComparison(GL_LESS), calls() {}
+
+/** Returns the number of calls of every type together */
+uint64_t RecordingRenderBackend::getTotalCallCount() const {
+    uint64_t total = 0;
+    for (uint64_t count : calls) {
+        total += count;
+    }
+    return total;
+}
+
+/** Returns the last data uploaded to a buffer, or nullptr if there is none */
+const std::vector<uint8_t>* RecordingRenderBackend::getBufferData(GLuint buffer) const {
+    auto found = bufferContents.find(buffer);
+    return found != bufferContents.end() ? &found->second : nullptr;
+}
+
+/** Returns the last value set for a uniform of a program, or nullptr */
+const std::vector<float>* RecordingRenderBackend::getUniform(GLuint program, const std::string& name) const {
+    auto found = uniformValues.find(std::make_pair(program, name));
+    return found != uniformValues.end() ? &found->second : nullptr;
+}
+
+/** Forgets the recorded draws and counts, keeping objects and bindings */
+void RecordingRenderBackend::clearRecording() {
+    draws.clear();
+    for (uint64_t& count : calls) {
+        count = 0;
+    }
+}
+
+// --- Buffers ---
+
+GLuint RecordingRenderBackend::createBuffer() {
+    ++calls[RENDER_CALL_CREATE_BUFFER];
+    return createObject();
+}
+
+void RecordingRenderBackend::deleteBuffer(GLuint buffer) {
+    ++calls[RENDER_CALL_DELETE_BUFFER];
+    deleteObject(buffer);
+    bufferContents.erase(buffer);
+
+    // Like GL, deleting a bound buffer unbinds it
+    for (auto& bound : boundBuffers) {
+        if (bound.second == buffer) {
+            bound.second = 0;
+        }
+    }
+    for (auto& bound : elementBuffers) {
+        if (bound.second == buffer) {
+            bound.second = 0;
+        }
+    }
+}
+
+void RecordingRenderBackend::bindBuffer(GLenum target, GLuint buffer) {
+    ++calls[RENDER_CALL_BIND_BUFFER];
+
+    // The element array binding is part of the vertex array
+    if (target == GL_ELEMENT_ARRAY_BUFFER) {
+        elementBuffers[boundVertexArray] = buffer;
+    } else {
+        boundBuffers[target] = buffer;
+    }
+}
+
+void RecordingRenderBackend::bufferData(GLenum target, size_t bytes, const void* data, GLenum) {
+    ++calls[RENDER_CALL_BUFFER_DATA];
+    if (!recording) {
+        return;
+    }
+
+    GLuint buffer = target == GL_ELEMENT_ARRAY_BUFFER ? elementBuffers[boundVertexArray] : boundBuffers[target];
+    const uint8_t* bytesIn = static_cast<const uint8_t*>(data);
+    bufferContents[buffer] = bytesIn ? std::vector<uint8_t>(bytesIn, bytesIn + bytes) : std::vector<uint8_t>(bytes);
+}
+
+// --- Vertex arrays ---
+
+GLuint RecordingRenderBackend::createVertexArray() {
+    ++calls[RENDER_CALL_CREATE_VERTEX_ARRAY];
+    return createObject();
+}
+
+void RecordingRenderBackend::deleteVertexArray(GLuint vertexArray) {
+    ++calls[RENDER_CALL_DELETE_VERTEX_ARRAY];
+    deleteObject(vertexArray);
+    elementBuffers.erase(vertexArray);
+    if (boundVertexArray == vertexArray) {
+        boundVertexArray = 0;
+    }
+}
+
+void RecordingRenderBackend::bindVertexArray(GLuint vertexArray) {
+    ++calls[RENDER_CALL_BIND_VERTEX_ARRAY];
+    boundVertexArray = vertexArray;
+}
+
+void RecordingRenderBackend::vertexAttribPointer(GLuint, GLint, GLenum, bool, GLsizei, size_t) {
+    ++calls[RENDER_CALL_VERTEX_ATTRIB];
+}
+
+void RecordingRenderBackend::vertexAttribIPointer(GLuint, GLint, GLenum, GLsizei, size_t) {
+    ++calls[RENDER_CALL_VERTEX_ATTRIB];
+}
+
+void RecordingRenderBackend::enableVertexAttribArray(GLuint) {
+    ++calls[RENDER_CALL_VERTEX_ATTRIB];
+}
+
+// --- Textures ---
+
+GLuint RecordingRenderBackend::createTexture() {
+    ++calls[RENDER_CALL_CREATE_TEXTURE];
+    return createObject();
+}
+
+void RecordingRenderBackend::activeTexture(int unit) {
+    ++calls[RENDER_CALL_ACTIVE_TEXTURE];
+    activeUnit = unit;
+}
+
+void RecordingRenderBackend::bindTexture(GLenum target, GLuint texture) {
+    ++calls[RENDER_CALL_BIND_TEXTURE];
+    if (activeUnit == 0 && target == GL_TEXTURE_2D_ARRAY) {
+        texture0 = texture;
+    }
+}
+
+void RecordingRenderBackend::deleteTexture(GLuint texture) {
+    ++calls[RENDER_CALL_DELETE_TEXTURE];
+    deleteObject(texture);
+    if (texture0 == texture) {
+        texture0 = 0;
+    }
+}
+
+void RecordingRenderBackend::texParameteri(GLenum, GLenum, GLint) {
+    ++calls[RENDER_CALL_TEXTURE_IMAGE];
+}
+
+void RecordingRenderBackend::texImage2D(GLenum, GLint, GLsizei, GLsizei, GLenum, GLenum, const void*) {
+    ++calls[RENDER_CALL_TEXTURE_IMAGE];
+}
+
+void RecordingRenderBackend::texSubImage2D(GLenum, GLint, GLint, GLsizei, GLsizei, GLenum, GLenum, const void*) {
+    ++calls[RENDER_CALL_TEXTURE_IMAGE];
+}
+
+// --- Shaders and programs ---
+
+GLuint RecordingRenderBackend::createShader(GLenum) {
+    return createObject();
+}
+
+void RecordingRenderBackend::compileShader(GLuint shader, const std::string&) {
+    ++calls[RENDER_CALL_COMPILE_SHADER];
+    if (compileFails) {
+        failedShaders.insert(shader);
+    }
+}
+
+bool RecordingRenderBackend::getShaderStatus(GLuint shader, std::string& log) {
+    if (failedShaders.count(shader) > 0) {
+        log = "recording backend: compile failure requested\n";
+        return false;
+    }
+    return true;
+}
+
+void RecordingRenderBackend::deleteShader(GLuint shader) {
+    deleteObject(shader);
+    failedShaders.erase(shader);
+}
+
+GLuint RecordingRenderBackend::createProgram() {
+    return createObject();
+}
+
+void RecordingRenderBackend::attachShader(GLuint program, GLuint shader) {
+    attachedShaders[program].push_back(shader);
+}
+
+void RecordingRenderBackend::detachShader(GLuint program, GLuint shader) {
+    std::vector<GLuint>& shaders = attachedShaders[program];
+    for (size_t i = 0; i < shaders.size(); ++i) {
+        if (shaders[i] == shader) {
+            shaders.erase(shaders.begin() + i);
+            break;
+        }
+    }
+}
+
+void RecordingRenderBackend::linkProgram(GLuint program, bool) {
+    ++calls[RENDER_CALL_LINK_PROGRAM];
+
+    // Linking fails if any attached shader failed to compile
+    for (GLuint shader : attachedShaders[program]) {
+        if (failedShaders.count(shader) > 0) {
+            failedPrograms.insert(program);
+        }
+    }
+}
+
+bool RecordingRenderBackend::getProgramStatus(GLuint program, std::string& log) {
+    if (failedPrograms.count(program) > 0) {
+        log = "recording backend: a shader failed to compile\n";
+        return false;
+    }
+    return true;
+}
+
+void RecordingRenderBackend::useProgram(GLuint program) {
+    ++calls[RENDER_CALL_USE_PROGRAM];
+    this->program = program;
+}
+
+void RecordingRenderBackend::deleteProgram(GLuint program) {
+    ++calls[RENDER_CALL_DELETE_PROGRAM];
+    deleteObject(program);
+    failedPrograms.erase(program);
+    attachedShaders.erase(program);
+}
+
+// --- Uniforms ---
+
+GLint RecordingRenderBackend::getUniformLocation(GLuint program, const std::string& name) {
+    auto key = std::make_pair(program, name);
+    auto found = uniformLocations.find(key);
+    if (found != uniformLocations.end()) {
+        return found->second;
+    }
+
+    GLint location = GLint(uniformLocations.size());
+    uniformLocations[key] = location;
+    uniformNames[std::make_pair(program, location)] = name;
+    return location;
+}
+
+void RecordingRenderBackend::uniform1i(GLint location, int value) {
+    float stored = float(value);
+    setUniform(location, &stored, 1);
+}
+
+void RecordingRenderBackend::uniform1f(GLint location, float value) {
+    setUniform(location, &value, 1);
+}
+
+void RecordingRenderBackend::uniform3fv(GLint location, const float* value) {
+    setUniform(location, value, 3);
+}
+
+void RecordingRenderBackend::uniformMatrix4fv(GLint location, const float* value) {
+    setUniform(location, value, 16);
+}
+
+// --- Fragment tests and writes ---
+
+void RecordingRenderBackend::colorMask(bool enabled) {
+    ++calls[RENDER_CALL_FRAGMENT_STATE];
+    colorWrites = enabled;
+}
+
+void RecordingRenderBackend::depthMask(bool enabled) {
+    ++calls[RENDER_CALL_FRAGMENT_STATE];
+    depthWrites = enabled;
+}
+
+void RecordingRenderBackend::depthFunc(GLenum func) {
+    ++calls[RENDER_CALL_FRAGMENT_STATE];
+    depthComparison = func;
+}
+
+// --- Drawing ---
+
+void RecordingRenderBackend::drawElements(GLenum mode, GLsizei count, GLenum, size_t offset) {
+    ++calls[RENDER_CALL_DRAW];
+    recordDraw(mode, count, offset);
+}
+
+void RecordingRenderBackend::multiDrawElements(GLenum mode, const GLsizei* counts, GLenum, const size_t* offsets,
+                                               GLsizei drawCount) {
+    ++calls[RENDER_CALL_DRAW];
+    for (GLsizei i = 0; i < drawCount; ++i) {
+        recordDraw(mode, counts[i], offsets[i]);
+    }
+}
+
+// --- Helpers ---
+
+/**
+ * Hands out the next object name and marks it live.
+ */
+GLuint RecordingRenderBackend::createObject() {
+    GLuint name = nextName++;
+    liveObjects.insert(name);
+    return name;
+}
+
+/**
+ * Marks an object deleted.
+ */
+void RecordingRenderBackend::deleteObject(GLuint object) {
+    liveObjects.erase(object);
+}
+
+/**
+ * Records one draw with the current state.
+ */
+void RecordingRenderBackend::recordDraw(GLenum mode, GLsizei count, size_t offset) {
+    if (!recording) {
+        return;
+    }
+
+    auto element = elementBuffers.find(boundVertexArray);
+    RecordedDraw draw;
+    draw.program = program;
+    draw.vertexArray = boundVertexArray;
+    draw.elementBuffer = element != elementBuffers.end() ? element->second : 0;
+    draw.texture = texture0;
+    draw.mode = mode;
+    draw.count = count;
+    draw.offset = offset;
+    draw.colorWrites = colorWrites;
+    draw.depthWrites = depthWrites;
+    draw.depthFunc = depthComparison;
+    draws.push_back(draw);
+}
+
+/**
+ * Stores a uniform value for the program in use.
+ */
+void RecordingRenderBackend::setUniform(GLint location, const float* values, size_t count) {
+    ++calls[RENDER_CALL_UNIFORM];
+    if (!recording || location < 0) {
+        return;
+    }
+
+    auto name = uniformNames.find(std::make_pair(program, location));
+    if (name != uniformNames.end()) {
+        uniformValues[std::make_pair(program, name->second)].assign(values, values + count);
+    }
+}
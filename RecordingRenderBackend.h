@@ -0,0 +1,242 @@
+// Prevents multiple inclusions of this header file, which can cause redefinition errors
+#ifndef RECORDING_RENDER_BACKEND_H
+#define RECORDING_RENDER_BACKEND_H
+
+// Includes the ordered map used for object state
+#include <map>
+
+// Includes the ordered set used for live and failed objects
+#include <set>
+
+#include "RenderBackend.h" // The interface implemented
+
+/** The calls `RecordingRenderBackend` counts, one per interface method that changes state or draws */
+enum RenderCallType {
+    RENDER_CALL_CREATE_BUFFER,
+    RENDER_CALL_DELETE_BUFFER,
+    RENDER_CALL_BIND_BUFFER,
+    RENDER_CALL_BUFFER_DATA,
+    RENDER_CALL_CREATE_VERTEX_ARRAY,
+    RENDER_CALL_DELETE_VERTEX_ARRAY,
+    RENDER_CALL_BIND_VERTEX_ARRAY,
+    RENDER_CALL_VERTEX_ATTRIB,
+    RENDER_CALL_CREATE_TEXTURE,
+    RENDER_CALL_ACTIVE_TEXTURE,
+    RENDER_CALL_BIND_TEXTURE,
+    RENDER_CALL_DELETE_TEXTURE,
+    RENDER_CALL_TEXTURE_IMAGE,
+    RENDER_CALL_COMPILE_SHADER,
+    RENDER_CALL_LINK_PROGRAM,
+    RENDER_CALL_USE_PROGRAM,
+    RENDER_CALL_DELETE_PROGRAM,
+    RENDER_CALL_UNIFORM,
+    RENDER_CALL_FRAGMENT_STATE,
+    RENDER_CALL_DRAW,
+    RENDER_CALL_TYPE_COUNT
+};
+
+/**
+ * The `RecordedDraw` struct is one draw call seen by `RecordingRenderBackend`,
+ * with the state it would have drawn with.
+ */
+struct RecordedDraw {
+    GLuint program;
+    GLuint vertexArray;
+
+    /** The element buffer of the vertex array, whose uploaded indices `getBufferData` returns */
+    GLuint elementBuffer;
+
+    /** The texture bound to unit 0's GL_TEXTURE_2D_ARRAY target */
+    GLuint texture;
+
+    GLenum mode;
+    GLsizei count;
+
+    /** The byte offset of the first index in the element buffer */
+    size_t offset;
+
+    /** The color and depth write masks and the depth comparison */
+    bool colorWrites;
+    bool depthWrites;
+    GLenum depthFunc;
+};
+
+/**
+ * The `RecordingRenderBackend` class is a `RenderBackend` that needs no GPU or
+ * context. It hands out object names, tracks bindings the way GL would, keeps
+ * a copy of every buffer upload and records each draw with the state it would
+ * have used, so tests can check what would have reached the GPU.
+ *
+ * Shaders always compile and link, unless `setCompileFails` says otherwise.
+ * With recording off it only counts calls, which makes it a null backend for
+ * benchmarking the CPU side of rendering.
+ */
+class RecordingRenderBackend : public RenderBackend {
+public:
+    /**
+     * Constructor: Creates a backend with no objects.
+     *
+     * @param recording If false, only count calls (no buffer copies or draw records).
+     */
+    RecordingRenderBackend(bool recording = true);
+
+    // --- Inspection ---
+
+    /** Returns the number of calls of one type */
+    uint64_t getCallCount(RenderCallType type) const { return calls[type]; }
+
+    /** Returns the number of calls of every type together */
+    uint64_t getTotalCallCount() const;
+
+    /** Returns the recorded draws, in order (a multi-draw records one per range) */
+    const std::vector<RecordedDraw>& getDraws() const { return draws; }
+
+    /** Returns the last data uploaded to a buffer, or nullptr if there is none */
+    const std::vector<uint8_t>* getBufferData(GLuint buffer) const;
+
+    /** Returns the number of buffers, vertex arrays, textures, shaders and programs not yet deleted */
+    size_t getLiveObjectCount() const { return liveObjects.size(); }
+
+    /** Returns the last value set for a uniform of a program (16 floats for a matrix), or nullptr */
+    const std::vector<float>* getUniform(GLuint program, const std::string& name) const;
+
+    /** Makes every following shader compile fail (or succeed again), to test error handling */
+    void setCompileFails(bool fails) { compileFails = fails; }
+
+    /** Forgets the recorded draws and counts, keeping objects and bindings */
+    void clearRecording();
+
+    // --- RenderBackend ---
+
+    bool supportsParallelCompile() const override { return false; }
+    bool supportsProgramBinary() const override { return false; }
+
+    GLuint createBuffer() override;
+    void deleteBuffer(GLuint buffer) override;
+    void bindBuffer(GLenum target, GLuint buffer) override;
+    void bufferData(GLenum target, size_t bytes, const void* data, GLenum usage) override;
+
+    GLuint createVertexArray() override;
+    void deleteVertexArray(GLuint vertexArray) override;
+    void bindVertexArray(GLuint vertexArray) override;
+    void vertexAttribPointer(GLuint index, GLint size, GLenum type, bool normalized, GLsizei stride, size_t offset) override;
+    void vertexAttribIPointer(GLuint index, GLint size, GLenum type, GLsizei stride, size_t offset) override;
+    void enableVertexAttribArray(GLuint index) override;
+
+    void activeTexture(int unit) override;
+    GLuint createTexture() override;
+    void bindTexture(GLenum target, GLuint texture) override;
+    void deleteTexture(GLuint texture) override;
+    void texParameteri(GLenum target, GLenum name, GLint value) override;
+    void texImage2D(GLenum target, GLint internalFormat, GLsizei width, GLsizei height, GLenum format, GLenum type,
+                    const void* data) override;
+    void texSubImage2D(GLenum target, GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type,
+                       const void* data) override;
+
+    GLuint createShader(GLenum type) override;
+    void compileShader(GLuint shader, const std::string& source) override;
+    bool getShaderStatus(GLuint shader, std::string& log) override;
+    void deleteShader(GLuint shader) override;
+
+    GLuint createProgram() override;
+    void attachShader(GLuint program, GLuint shader) override;
+    void detachShader(GLuint program, GLuint shader) override;
+    void linkProgram(GLuint program, bool retrievable) override;
+    bool getProgramStatus(GLuint program, std::string& log) override;
+    bool isProgramComplete(GLuint) override { return true; }
+    bool loadProgramBinary(GLuint, GLenum, const std::vector<uint8_t>&) override { return false; }
+    bool getProgramBinary(GLuint, GLenum&, std::vector<uint8_t>&) override { return false; }
+    void useProgram(GLuint program) override;
+    void deleteProgram(GLuint program) override;
+
+    GLint getUniformLocation(GLuint program, const std::string& name) override;
+    void uniform1i(GLint location, int value) override;
+    void uniform1f(GLint location, float value) override;
+    void uniform3fv(GLint location, const float* value) override;
+    void uniformMatrix4fv(GLint location, const float* value) override;
+
+    void colorMask(bool enabled) override;
+    void depthMask(bool enabled) override;
+    void depthFunc(GLenum func) override;
+
+    void drawElements(GLenum mode, GLsizei count, GLenum type, size_t offset) override;
+    void multiDrawElements(GLenum mode, const GLsizei* counts, GLenum type, const size_t* offsets,
+                           GLsizei drawCount) override;
+
+private:
+    /**
+     * Hands out the next object name and marks it live.
+     */
+    GLuint createObject();
+
+    /**
+     * Marks an object deleted.
+     */
+    void deleteObject(GLuint object);
+
+    /**
+     * Stores a uniform value for the program in use.
+     */
+    void setUniform(GLint location, const float* values, size_t count);
+
+    /**
+     * Records one draw with the current state.
+     */
+    void recordDraw(GLenum mode, GLsizei count, size_t offset);
+
+    /** True if buffer contents, uniforms and draws are kept */
+    bool recording;
+
+    /** True if shader compiles fail */
+    bool compileFails;
+
+    /** The next object name; all object types share one counter, so names never collide */
+    GLuint nextName;
+
+    /** The objects not yet deleted */
+    std::set<GLuint> liveObjects;
+
+    /** The shaders whose compile failed */
+    std::set<GLuint> failedShaders;
+
+    /** The programs that had a failed shader attached when linked */
+    std::set<GLuint> failedPrograms;
+
+    /** The shaders attached to each program */
+    std::map<GLuint, std::vector<GLuint>> attachedShaders;
+
+    /** The buffer bound to each target, the vertex array bound, and each vertex array's element buffer */
+    std::map<GLenum, GLuint> boundBuffers;
+    GLuint boundVertexArray;
+    std::map<GLuint, GLuint> elementBuffers;
+
+    /** The active texture unit and the GL_TEXTURE_2D_ARRAY texture bound on unit 0 */
+    int activeUnit;
+    GLuint texture0;
+
+    /** The program in use */
+    GLuint program;
+
+    /** The color and depth write masks and the depth comparison (GL's defaults to start) */
+    bool colorWrites;
+    bool depthWrites;
+    GLenum depthComparison;
+
+    /** The uniform locations handed out, by program and name, and the name of each location */
+    std::map<std::pair<GLuint, std::string>, GLint> uniformLocations;
+    std::map<std::pair<GLuint, GLint>, std::string> uniformNames;
+
+    /** The last value of each uniform, by program and name */
+    std::map<std::pair<GLuint, std::string>, std::vector<float>> uniformValues;
+
+    /** The last data uploaded to each buffer */
+    std::map<GLuint, std::vector<uint8_t>> bufferContents;
+
+    /** The recorded draws */
+    std::vector<RecordedDraw> draws;
+
+    /** The number of calls of each type */
+    uint64_t calls[RENDER_CALL_TYPE_COUNT];
+};
+
+#endif  // Ends the conditional inclusion directive
@@ -0,0 +1,113 @@
+// Includes the corresponding header file to access the RegionCompactor class declaration
+#include "RegionCompactor.h"
+
+// Includes standard I/O for reporting reclaimed space
+#include <iostream>
+
+// Platform thread priority APIs
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#elif defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Constructor: Starts the background thread.
+ *
+ * @param minWasteFraction Regions with less than this fraction of wasted bytes are left alone.
+ */
+RegionCompactor::RegionCompactor(double minWasteFraction)
+    : minWasteFraction(minWasteFraction), stopping(false), reclaimedBytes(0), compactedCount(0) {
+    // Started last, once every member it uses is initialized
+    worker = std::thread(&RegionCompactor::workerLoop, this);
+}
+
+/**
+ * Destructor: Finishes the region being compacted (if any), then stops.
+ */
+RegionCompactor::~RegionCompactor() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    worker.join();
+}
+
+/**
+ * Queues a region to be checked and, if fragmented enough, compacted.
+ * A region already waiting is not queued again.
+ *
+ * @param region The region to check.
+ */
+void RegionCompactor::enqueue(RegionFile* region) {
+    if (!region) {
+        return;
+    }
+
+    // Every checkpoint syncs the regions it wrote; one check per region covers them all
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!queued.insert(region).second) {
+            return;
+        }
+        queue.push_back(region);
+    }
+    wake.notify_one();
+}
+
+/**
+ * The loop the background thread runs.
+ */
+void RegionCompactor::workerLoop() {
+    lowerThreadPriority();
+
+    for (;;) {
+        RegionFile* region;
+
+        // Sleep until there is a region to check
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (stopping) {
+                return;
+            }
+
+            region = queue.front();
+            queue.pop_front();
+            queued.erase(region);
+        }
+
+        // Skip regions that aren't fragmented enough to be worth rewriting
+        uint64_t wasted = region->getWastedBytes();
+        if (wasted == 0 || double(wasted) < minWasteFraction * double(region->getFileSize())) {
+            continue;
+        }
+
+        uint64_t reclaimed = 0;
+        if (region->compact(reclaimed)) {
+            reclaimedBytes += reclaimed;
+            compactedCount++;
+            std::cout << "Compacted " << region->getPath() << ": reclaimed " << reclaimed << " bytes" << std::endl;
+        }
+    }
+}
+
+/**
+ * Lowers the calling thread's I/O (and CPU) priority, where the OS supports it.
+ */
+void RegionCompactor::lowerThreadPriority() {
+#ifdef _WIN32
+    // Background mode lowers both the CPU and I/O priority of the thread
+    SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN);
+#elif defined(__linux__)
+    // ioprio_set has no glibc wrapper. Values from linux/ioprio.h:
+    // IOPRIO_WHO_PROCESS = 1 (with id 0 meaning the calling thread), IOPRIO_CLASS_IDLE = 3
+    const int ioprioWhoProcess = 1;
+    const int ioprioClassIdle = 3;
+    const int ioprioClassShift = 13;
+    syscall(SYS_ioprio_set, ioprioWhoProcess, 0, ioprioClassIdle << ioprioClassShift);
+#endif
+}
@@ -0,0 +1,111 @@
+// Prevents multiple inclusions of this header file, which can cause redefinition errors
+#ifndef REGION_COMPACTOR_H
+#define REGION_COMPACTOR_H
+
+// Includes std::atomic for counters read from other threads
+#include <atomic>
+
+// Includes std::condition_variable, used to sleep until work arrives
+#include <condition_variable>
+
+// Includes fixed-width integer types such as uint64_t
+#include <cstdint>
+
+// Includes the deque container used as the work queue
+#include <deque>
+
+// Includes std::mutex, which guards the work queue
+#include <mutex>
+
+// Includes std::thread for the background worker
+#include <thread>
+
+// Includes the set of regions already waiting, so none is queued twice
+#include <unordered_set>
+
+// Includes the RegionFile class being compacted
+#include "RegionFile.h"
+
+/**
+ * The `RegionCompactor` class removes holes from region files in the background.
+ *
+ * Regions handed to `enqueue` are checked on a dedicated thread; if enough of
+ * the file is wasted, it is rewritten with `RegionFile::compact`. The thread
+ * lowers its own I/O priority (idle class on Linux, background mode on Windows)
+ * so compaction yields the disk to chunk loading.
+ *
+ * Regions must stay alive until the compactor is destroyed or has processed them.
+ */
+class RegionCompactor {
+public:
+    /**
+     * Constructor: Starts the background thread.
+     *
+     * @param minWasteFraction Regions with less than this fraction of wasted bytes are left alone.
+     */
+    explicit RegionCompactor(double minWasteFraction = 0.25);
+
+    /**
+     * Destructor: Finishes the region being compacted (if any), then stops.
+     * Regions still waiting in the queue are skipped.
+     */
+    ~RegionCompactor();
+
+    // The compactor owns a running thread, so it can't be copied
+    RegionCompactor(const RegionCompactor&) = delete;
+    RegionCompactor& operator=(const RegionCompactor&) = delete;
+
+    /**
+     * Queues a region to be checked and, if fragmented enough, compacted.
+     * A region already waiting is not queued again.
+     *
+     * @param region The region to check.
+     */
+    void enqueue(RegionFile* region);
+
+    /** Returns the total number of bytes reclaimed so far */
+    uint64_t getReclaimedBytes() const { return reclaimedBytes.load(); }
+
+    /** Returns the number of regions compacted so far */
+    uint64_t getCompactedCount() const { return compactedCount.load(); }
+
+private:
+    /** The fraction of wasted bytes that triggers a compaction */
+    double minWasteFraction;
+
+    /** Regions waiting to be checked */
+    std::deque<RegionFile*> queue;
+
+    /** The regions in `queue` */
+    std::unordered_set<RegionFile*> queued;
+
+    /** Guards `queue`, `queued` and `stopping` */
+    std::mutex mutex;
+
+    /** Signalled when a region is queued or the compactor is stopping */
+    std::condition_variable wake;
+
+    /** Set when the compactor is shutting down */
+    bool stopping;
+
+    /** Total bytes reclaimed */
+    std::atomic<uint64_t> reclaimedBytes;
+
+    /** Number of regions compacted */
+    std::atomic<uint64_t> compactedCount;
+
+    /** The background thread */
+    std::thread worker;
+
+    /**
+     * The loop the background thread runs.
+     */
+    void workerLoop();
+
+    /**
+     * Lowers the calling thread's I/O (and CPU) priority, where the OS supports it.
+     */
+    static void lowerThreadPriority();
+};
+
+#endif  // Ends the conditional inclusion directive
@@ -0,0 +1,439 @@
+// Includes the corresponding header file to access the RegionFile class declaration
+#include "RegionFile.h"
+
+// Includes std::fill and std::max
+#include <algorithm>
+
+// Includes std::filesystem::rename, used to swap in a compacted file atomically
+#include <filesystem>
+
+// Includes standard I/O for printing error messages to the console
+#include <iostream>
+
+// Includes ChunkKey, whose bit interleaving orders the chunk table
+#include "ChunkKey.h"
+
+// How many times `compact` re-copies chunks rewritten during its copy before taking the lock
+static const int CATCH_UP_PASSES = 4;
+
+/**
+ * Constructor: Creates a region that isn't backed by a file yet.
+ */
+RegionFile::RegionFile()
+    : file(std::make_shared<File>()), entries(REGION_CHUNKS, Entry{0, 0}),
+      durableEntries(REGION_CHUNKS, Entry{0, 0}), writeCounts(REGION_CHUNKS, 0), renameUnsynced(false) {}
+
+/**
+ * Opens a region file, creating an empty one if it doesn't exist.
+ * The header is stored in the machine's native (little endian) byte order.
+ *
+ * @param path The path of the region file.
+ * @return True if the file was opened and its header is valid.
+ */
+bool RegionFile::open(const std::string& path) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    this->path = path;
+
+    if (!file->open(path, true)) {
+        std::cout << "ERROR::REGION::OPEN_FAILED " << path << std::endl;
+        return false;
+    }
+
+    // --- New File: write an empty header ---
+    if (file->size() == 0) {
+        std::fill(entries.begin(), entries.end(), Entry{0, 0});
+
+        if (!writeHeader(*file, entries)) {
+            std::cout << "ERROR::REGION::HEADER_WRITE_FAILED " << path << std::endl;
+            return false;
+        }
+        durableEntries = entries;
+        return true;
+    }
+
+    // --- Existing File: read and validate the header ---
+    uint32_t preamble[2] = { 0, 0 };
+    if (!file->readAt(preamble, sizeof(preamble), 0) || preamble[0] != MAGIC || preamble[1] != VERSION) {
+        std::cout << "ERROR::REGION::INVALID_HEADER " << path << std::endl;
+        file->close();
+        return false;
+    }
+
+    if (!file->readAt(entries.data(), entries.size() * sizeof(Entry), sizeof(preamble))) {
+        std::cout << "ERROR::REGION::TRUNCATED_HEADER " << path << std::endl;
+        file->close();
+        return false;
+    }
+
+    durableEntries = entries;
+    return true;
+}
+
+/**
+ * Returns the table entry of a chunk.
+ *
+ * @param index The chunk's index inside the region.
+ */
+RegionFile::Entry RegionFile::getEntry(int index) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return entries[index];
+}
+
+/**
+ * Returns a chunk's table entry together with the file it refers to.
+ *
+ * @param index The chunk's index inside the region.
+ * @param entry Receives the table entry.
+ * @param file  Receives the file the entry points into.
+ */
+void RegionFile::locate(int index, Entry& entry, std::shared_ptr<const File>& file) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    entry = entries[index];
+    file = this->file;
+}
+
+/**
+ * Reads a chunk's payload into caller-provided storage.
+ *
+ * @param index  The chunk's index inside the region.
+ * @param buffer Receives the payload; must hold `getEntry(index).byteLength` bytes.
+ * @return True if the chunk is stored and was read completely.
+ */
+bool RegionFile::readChunk(int index, uint8_t* buffer) const {
+    Entry entry;
+    std::shared_ptr<const File> source;
+    locate(index, entry, source);
+
+    if (entry.sectorOffset == 0) {
+        return false;
+    }
+
+    return source->readAt(buffer, entry.byteLength, uint64_t(entry.sectorOffset) * SECTOR_SIZE);
+}
+
+/**
+ * Writes a chunk's payload, replacing any previous version.
+ * An empty payload removes the chunk from the region.
+ *
+ * @param index The chunk's index inside the region.
+ * @param data  The encoded payload.
+ * @param size  The payload length, in bytes.
+ * @return True on success.
+ */
+bool RegionFile::writeChunk(int index, const uint8_t* data, size_t size) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+
+    Entry entry = entries[index];
+
+    if (size == 0) {
+        entry = Entry{0, 0};
+    } else {
+        // Always append, never overwrite the old sectors: a torn write then only
+        // damages the new copy, which the table doesn't point to yet
+        uint64_t fileSectors = (file->size() + SECTOR_SIZE - 1) / SECTOR_SIZE;
+        entry.sectorOffset = uint32_t(std::max<uint64_t>(fileSectors, HEADER_SECTORS));
+        entry.byteLength = uint32_t(size);
+
+        // Only the in-memory table points at the new copy for now. `sync` writes the entry to the
+        // file once the payload is durable, so a crash can't leave the table pointing at a payload
+        // that never reached the disk; until then the old version stays on disk, and the edit log
+        // holds the edits made since
+        if (!file->writeAt(data, size, uint64_t(entry.sectorOffset) * SECTOR_SIZE)) {
+            std::cout << "ERROR::REGION::WRITE_FAILED " << path << std::endl;
+            return false;
+        }
+    }
+
+    entries[index] = entry;
+    writeCounts[index]++;
+    return true;
+}
+
+/**
+ * Flushes every write made so far to the disk: first the payloads, then the
+ * table entries pointing at them, then the table itself.
+ * A compaction that swaps the file in meanwhile has already synced the new one;
+ * this also syncs its rename, if the compaction couldn't.
+ *
+ * @return True on success.
+ */
+bool RegionFile::sync() {
+    std::shared_ptr<File> current;
+    std::vector<Entry> table;
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        current = file;
+        table = entries;
+    }
+
+    // --- Payloads: everything the snapshot of the table points at is durable after this ---
+    if (!current->sync()) {
+        std::cout << "ERROR::REGION::SYNC_FAILED " << path << std::endl;
+        return false;
+    }
+
+    // --- Table: switch the entries on disk over to those payloads ---
+    bool tableChanged = false;
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex);
+
+        // A compaction that swapped the file in meanwhile wrote a complete table of its own
+        if (file == current) {
+            for (int i = 0; i < REGION_CHUNKS; ++i) {
+                if (table[i].sectorOffset != durableEntries[i].sectorOffset ||
+                    table[i].byteLength != durableEntries[i].byteLength) {
+                    durableEntries[i] = table[i];
+                    tableChanged = true;
+                }
+            }
+
+            if (tableChanged && !writeHeader(*current, durableEntries)) {
+                std::cout << "ERROR::REGION::HEADER_WRITE_FAILED " << path << std::endl;
+                return false;
+            }
+        }
+    }
+
+    if (tableChanged && !current->sync()) {
+        std::cout << "ERROR::REGION::SYNC_FAILED " << path << std::endl;
+        return false;
+    }
+    return syncRename();
+}
+
+/**
+ * Returns the current size of the region file, in bytes.
+ */
+uint64_t RegionFile::getFileSize() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return file->size();
+}
+
+/**
+ * Returns the number of bytes in the file not used by the header or any payload.
+ */
+uint64_t RegionFile::getWastedBytes() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+
+    uint64_t usedSectors = HEADER_SECTORS;
+    for (const Entry& entry : entries) {
+        if (entry.sectorOffset != 0) {
+            usedSectors += sectorsFor(entry.byteLength);
+        }
+    }
+
+    uint64_t fileSectors = (file->size() + SECTOR_SIZE - 1) / SECTOR_SIZE;
+    return fileSectors > usedSectors ? (fileSectors - usedSectors) * SECTOR_SIZE : 0;
+}
+
+/**
+ * Rewrites the region with every payload packed back to back, then atomically
+ * replaces the old file with the new one.
+ *
+ * @param reclaimedBytes Receives how much smaller the file became.
+ * @return True if the region was compacted.
+ */
+bool RegionFile::compact(uint64_t& reclaimedBytes) {
+    reclaimedBytes = 0;
+    std::lock_guard<std::mutex> compactLock(compactMutex);
+
+    // --- Snapshot the table; reads and writes carry on while we copy ---
+    std::vector<Entry> snapshot;
+    std::vector<uint32_t> snapshotCounts;
+    std::shared_ptr<File> source;
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        snapshot = entries;
+        snapshotCounts = writeCounts;
+        source = file;
+    }
+    uint64_t oldSize = source->size();
+
+    std::string tempPath = path + ".compact";
+    auto target = std::make_shared<File>();
+    if (!target->open(tempPath, true, true)) {
+        std::cout << "ERROR::REGION::COMPACT_OPEN_FAILED " << tempPath << std::endl;
+        return false;
+    }
+
+    // Discards the partly written copy if anything goes wrong
+    auto abandon = [&target, &tempPath] {
+        target->close();
+        std::error_code ignored;
+        std::filesystem::remove(tempPath, ignored);
+    };
+
+    // --- Copy every payload, in table (Morton) order, with no gaps ---
+    std::vector<Entry> packed(REGION_CHUNKS, Entry{0, 0});
+    std::vector<uint8_t> buffer;
+    uint32_t nextSector = HEADER_SECTORS;
+
+    for (int i = 0; i < REGION_CHUNKS; ++i) {
+        if (snapshot[i].sectorOffset != 0 &&
+            !copyPayload(*source, snapshot[i], *target, nextSector, buffer, packed[i])) {
+            std::cout << "ERROR::REGION::COMPACT_COPY_FAILED " << path << std::endl;
+            abandon();
+            return false;
+        }
+    }
+
+    // --- Catch up: copy chunks rewritten meanwhile, still without blocking anyone ---
+    // Writes only append to `source`, and only a compaction replaces it, so it stays valid to read
+    std::vector<uint32_t> copiedCounts = snapshotCounts;
+    for (int pass = 0; pass < CATCH_UP_PASSES; ++pass) {
+        std::vector<int> changed;
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            for (int i = 0; i < REGION_CHUNKS; ++i) {
+                if (writeCounts[i] != copiedCounts[i]) {
+                    changed.push_back(i);
+                    snapshot[i] = entries[i];
+                    copiedCounts[i] = writeCounts[i];
+                }
+            }
+        }
+        if (changed.empty()) {
+            break;
+        }
+
+        for (int i : changed) {
+            packed[i] = Entry{0, 0};
+            if (snapshot[i].sectorOffset != 0 &&
+                !copyPayload(*source, snapshot[i], *target, nextSector, buffer, packed[i])) {
+                std::cout << "ERROR::REGION::COMPACT_COPY_FAILED " << path << std::endl;
+                abandon();
+                return false;
+            }
+        }
+    }
+
+    // Flush the bulk of the copy now, so the sync under the lock only has the last few chunks to write
+    if (!target->sync()) {
+        std::cout << "ERROR::REGION::COMPACT_WRITE_FAILED " << tempPath << std::endl;
+        abandon();
+        return false;
+    }
+
+    // --- Swap: the only part that blocks other users of the region ---
+    std::unique_lock<std::shared_mutex> lock(mutex);
+
+    // Chunks written since the last pass are copied again from the live table
+    for (int i = 0; i < REGION_CHUNKS; ++i) {
+        if (writeCounts[i] == copiedCounts[i]) {
+            continue;
+        }
+
+        packed[i] = Entry{0, 0};
+        if (entries[i].sectorOffset != 0 &&
+            !copyPayload(*file, entries[i], *target, nextSector, buffer, packed[i])) {
+            std::cout << "ERROR::REGION::COMPACT_COPY_FAILED " << path << std::endl;
+            abandon();
+            return false;
+        }
+    }
+
+    // Make the new file durable before it replaces the old one
+    if (!writeHeader(*target, packed) || !target->sync()) {
+        std::cout << "ERROR::REGION::COMPACT_WRITE_FAILED " << tempPath << std::endl;
+        abandon();
+        return false;
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, path, error);
+    if (error) {
+        std::cout << "ERROR::REGION::COMPACT_RENAME_FAILED " << path << " " << error.message() << std::endl;
+        abandon();
+        return false;
+    }
+
+    // Readers that already hold the old file keep reading it; new reads see the new one
+    uint64_t newSize = target->size();
+    file = target;
+    entries = packed;
+    durableEntries = packed;
+    renameUnsynced = true;
+    lock.unlock();
+
+    // The rename is only durable once the directory is; if this fails, the next `sync` retries it
+    syncRename();
+
+    reclaimedBytes = oldSize > newSize ? oldSize - newSize : 0;
+    return true;
+}
+
+/**
+ * Syncs the directory holding the region if a compaction renamed the file into
+ * it and that rename isn't durable yet.
+ */
+bool RegionFile::syncRename() {
+    // Cleared before syncing, so a rename made meanwhile sets it again and isn't missed
+    if (renameUnsynced.exchange(false) && !File::syncDirectoryOf(path)) {
+        renameUnsynced = true;
+        std::cout << "ERROR::REGION::RENAME_SYNC_FAILED " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Writes a complete header (magic, version and chunk table) to a file,
+ * making sure the file is at least as long as the header's sectors.
+ */
+bool RegionFile::writeHeader(File& target, const std::vector<Entry>& table) {
+    uint32_t preamble[2] = { MAGIC, VERSION };
+    if (!target.writeAt(preamble, sizeof(preamble), 0) ||
+        !target.writeAt(table.data(), table.size() * sizeof(Entry), sizeof(preamble))) {
+        return false;
+    }
+
+    uint64_t headerEnd = uint64_t(HEADER_SECTORS) * SECTOR_SIZE;
+    return target.size() >= headerEnd || target.resize(headerEnd);
+}
+
+/**
+ * Copies one payload from a file to the next free sector of another.
+ *
+ * @param source     The file to copy from.
+ * @param entry      The payload's entry in `source`.
+ * @param target     The file to copy to.
+ * @param nextSector The next free sector in `target`; advanced past the copy.
+ * @param buffer     Scratch space for the payload.
+ * @param copied     Receives the payload's entry in `target`.
+ */
+bool RegionFile::copyPayload(const File& source, const Entry& entry, File& target,
+                             uint32_t& nextSector, std::vector<uint8_t>& buffer, Entry& copied) {
+    buffer.resize(entry.byteLength);
+    if (!source.readAt(buffer.data(), entry.byteLength, uint64_t(entry.sectorOffset) * SECTOR_SIZE) ||
+        !target.writeAt(buffer.data(), entry.byteLength, uint64_t(nextSector) * SECTOR_SIZE)) {
+        return false;
+    }
+
+    copied = Entry{nextSector, entry.byteLength};
+    nextSector += sectorsFor(entry.byteLength);
+    return true;
+}
+
+/**
+ * Returns the coordinate of the region containing a chunk (floor division).
+ */
+glm::i64vec3 RegionFile::regionCoord(const glm::i64vec3& chunk) {
+    glm::i64vec3 region;
+    for (int axis = 0; axis < 3; ++axis) {
+        region[axis] = chunk[axis] >= 0 ? chunk[axis] / REGION_SIZE
+                                        : (chunk[axis] - (REGION_SIZE - 1)) / REGION_SIZE;
+    }
+    return region;
+}
+
+/**
+ * Returns the table index of a chunk inside its region.
+ * The local coordinate bits are interleaved like `ChunkKey`, giving Morton order.
+ */
+int RegionFile::entryIndex(const glm::i64vec3& chunk) {
+    uint64_t x = uint64_t(chunk.x) & (REGION_SIZE - 1);
+    uint64_t y = uint64_t(chunk.y) & (REGION_SIZE - 1);
+    uint64_t z = uint64_t(chunk.z) & (REGION_SIZE - 1);
+
+    return int(ChunkKey::spread(x) | ChunkKey::spread(y) << 1 | ChunkKey::spread(z) << 2);
+}
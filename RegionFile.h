@@ -0,0 +1,241 @@
+// Prevents multiple inclusions of this header file, which can cause redefinition errors
+#ifndef REGION_FILE_H
+#define REGION_FILE_H
+
+// Includes std::atomic, the flag for a compaction's rename that isn't durable yet
+#include <atomic>
+
+// Includes fixed-width integer types such as uint32_t
+#include <cstdint>
+
+// Includes std::shared_ptr, which keeps a region's file alive while reads are in flight
+#include <memory>
+
+// Includes std::mutex, which serializes compactions
+#include <mutex>
+
+// Includes std::shared_mutex, so many readers can use a region at once
+#include <shared_mutex>
+
+// Includes the C++ Standard Library string class, used for file paths
+#include <string>
+
+// Includes the vector container used for the chunk table
+#include <vector>
+
+#include <glm/glm.hpp>                      // GLM for vector types
+#include <glm/ext/vector_int3_sized.hpp>    // GLM 64-bit integer vectors (glm::i64vec3)
+
+// Includes the File class used for positioned reads and writes
+#include "File.h"
+
+/**
+ * The `RegionFile` class stores the encoded payloads of a cube of
+ * REGION_SIZE^3 chunks in a single file.
+ *
+ * Layout:
+ * - A header holding a magic number, a version, and one table entry per chunk
+ *   (first sector and payload length in bytes)
+ * - Payloads, each starting on a SECTOR_SIZE boundary
+ *
+ * Table entries are ordered by the Morton code of the chunk's position inside
+ * the region (see `ChunkKey`), so a whole-region read or rewrite visits
+ * neighbouring chunks together.
+ *
+ * A rewritten chunk is always appended to the end of the file and switched to
+ * in the in-memory table; the table in the file only follows in `sync`, after
+ * the new payloads are durable. So after a crash the file's table points at
+ * the old copy or a complete new one, never at a payload that didn't reach
+ * the disk. This leaves holes behind; `compact` rewrites the file without them.
+ *
+ * Reads snapshot the table entry and the current file under a shared lock and
+ * then read without holding any lock, so they never wait on a compaction.
+ */
+class RegionFile {
+public:
+    /** The number of chunks along each axis of a region */
+    static constexpr int REGION_SIZE = 8;
+
+    /** The number of chunks in a region */
+    static constexpr int REGION_CHUNKS = REGION_SIZE * REGION_SIZE * REGION_SIZE;
+
+    /** The allocation unit for payloads, in bytes */
+    static constexpr uint32_t SECTOR_SIZE = 4096;
+
+    /** Identifies a region file ("KYRG") */
+    static constexpr uint32_t MAGIC = 0x4752594b;
+
+    /** The current file format version */
+    static constexpr uint32_t VERSION = 1;
+
+    /** One entry of the chunk table */
+    struct Entry {
+        /** The first sector of the payload, or 0 if the chunk isn't stored */
+        uint32_t sectorOffset;
+
+        /** The payload length, in bytes */
+        uint32_t byteLength;
+    };
+
+    /** The size of the header (magic, version and chunk table), in bytes */
+    static constexpr uint32_t HEADER_BYTES = 8 + REGION_CHUNKS * sizeof(Entry);
+
+    /** The number of sectors reserved for the header */
+    static constexpr uint32_t HEADER_SECTORS = (HEADER_BYTES + SECTOR_SIZE - 1) / SECTOR_SIZE;
+
+    /**
+     * Constructor: Creates a region that isn't backed by a file yet.
+     */
+    RegionFile();
+
+    /**
+     * Opens a region file, creating an empty one if it doesn't exist.
+     *
+     * @param path The path of the region file.
+     * @return True if the file was opened and its header is valid.
+     */
+    bool open(const std::string& path);
+
+    /**
+     * Returns the table entry of a chunk.
+     *
+     * @param index The chunk's index inside the region (see `entryIndex`).
+     */
+    Entry getEntry(int index) const;
+
+    /**
+     * Returns a chunk's table entry together with the file it refers to.
+     * Holding the returned file keeps it readable even if a compaction replaces it.
+     *
+     * @param index The chunk's index inside the region.
+     * @param entry Receives the table entry.
+     * @param file  Receives the file the entry points into.
+     */
+    void locate(int index, Entry& entry, std::shared_ptr<const File>& file) const;
+
+    /**
+     * Reads a chunk's payload into caller-provided storage.
+     *
+     * @param index  The chunk's index inside the region.
+     * @param buffer Receives the payload; must hold `getEntry(index).byteLength` bytes.
+     * @return True if the chunk is stored and was read completely.
+     */
+    bool readChunk(int index, uint8_t* buffer) const;
+
+    /**
+     * Writes a chunk's payload, replacing any previous version. Reads see it at
+     * once; the file's table points at it from the next `sync`.
+     *
+     * @param index The chunk's index inside the region.
+     * @param data  The encoded payload.
+     * @param size  The payload length, in bytes.
+     * @return True on success.
+     */
+    bool writeChunk(int index, const uint8_t* data, size_t size);
+
+    /**
+     * Flushes every write made so far (payloads and table) to the disk, including
+     * the rename of a compaction that couldn't make it durable itself.
+     *
+     * @return True on success.
+     */
+    bool sync();
+
+    /**
+     * Returns the current size of the region file, in bytes.
+     */
+    uint64_t getFileSize() const;
+
+    /**
+     * Returns the number of bytes in the file not used by the header or any payload.
+     */
+    uint64_t getWastedBytes() const;
+
+    /**
+     * Rewrites the region with every payload packed back to back, then atomically
+     * replaces the old file with the new one.
+     *
+     * Payloads are copied, chunks rewritten meanwhile copied again (a few
+     * times, while writes keep coming), and the copy synced, all without
+     * blocking readers or writers. Only the final swap takes the exclusive
+     * lock: it copies the chunks rewritten since the last pass, writes the
+     * header, syncs those few sectors and renames, so no write is lost and
+     * reads never wait behind the full-file sync. The directory is synced
+     * after the lock is released.
+     *
+     * @param reclaimedBytes Receives how much smaller the file became.
+     * @return True if the region was compacted.
+     */
+    bool compact(uint64_t& reclaimedBytes);
+
+    /** Returns the path this region was opened from */
+    const std::string& getPath() const { return path; }
+
+    /**
+     * Returns the coordinate of the region containing a chunk.
+     */
+    static glm::i64vec3 regionCoord(const glm::i64vec3& chunk);
+
+    /**
+     * Returns the table index of a chunk inside its region (Morton order).
+     */
+    static int entryIndex(const glm::i64vec3& chunk);
+
+    /**
+     * Returns the number of sectors needed to hold a payload.
+     */
+    static uint32_t sectorsFor(uint32_t byteLength) {
+        return (byteLength + SECTOR_SIZE - 1) / SECTOR_SIZE;
+    }
+
+private:
+    /** The path of the region file */
+    std::string path;
+
+    /** The open region file; replaced (not modified) by `compact` */
+    std::shared_ptr<File> file;
+
+    /** In-memory copy of the chunk table */
+    std::vector<Entry> entries;
+
+    /** The chunk table as last written to the file; `sync` catches it up once the payloads are durable */
+    std::vector<Entry> durableEntries;
+
+    /** Per-chunk counters bumped on every write, so compaction can spot concurrent rewrites */
+    std::vector<uint32_t> writeCounts;
+
+    /** Readers take this shared; writers and the compaction swap take it exclusively */
+    mutable std::shared_mutex mutex;
+
+    /** Held for the whole of `compact`, so two compactions of one region can't overlap */
+    std::mutex compactMutex;
+
+    /** Set when `compact` renamed the file into place and the directory isn't synced since */
+    std::atomic<bool> renameUnsynced;
+
+    /**
+     * Syncs the directory holding the region if a compaction renamed the file into
+     * it and that rename isn't durable yet.
+     */
+    bool syncRename();
+
+    /**
+     * Writes a complete header (magic, version and chunk table) to a file.
+     */
+    static bool writeHeader(File& target, const std::vector<Entry>& table);
+
+    /**
+     * Copies one payload from a file to the next free sector of another.
+     *
+     * @param source     The file to copy from.
+     * @param entry      The payload's entry in `source`.
+     * @param target     The file to copy to.
+     * @param nextSector The next free sector in `target`; advanced past the copy.
+     * @param buffer     Scratch space for the payload.
+     * @param copied     Receives the payload's entry in `target`.
+     */
+    static bool copyPayload(const File& source, const Entry& entry, File& target,
+                            uint32_t& nextSector, std::vector<uint8_t>& buffer, Entry& copied);
+};
+
+#endif  // Ends the conditional inclusion directive
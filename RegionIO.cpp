@@ -0,0 +1,25 @@
+// Includes the corresponding header file to access the RegionIOBackend class declaration
+#include "RegionIO.h"
+
+// Includes the portable backend, always available
+#include "ThreadPoolIOBackend.h"
+
+// Includes the io_uring backend, when liburing was found at configure time
+#ifdef KYBUS_HAVE_IO_URING
+#include "UringIOBackend.h"
+#endif
+
+/**
+ * Creates the fastest backend available on this system.
+ */
+std::unique_ptr<RegionIOBackend> RegionIOBackend::create() {
+#ifdef KYBUS_HAVE_IO_URING
+    // io_uring can still be unavailable at runtime (old kernel, seccomp, sysctl)
+    auto uring = std::make_unique<UringIOBackend>();
+    if (uring->isValid()) {
+        return uring;
+    }
+#endif
+
+    return std::make_unique<ThreadPoolIOBackend>();
+}
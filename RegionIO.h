@@ -0,0 +1,74 @@
+// Prevents multiple inclusions of this header file, which can cause redefinition errors
+#ifndef REGION_IO_H
+#define REGION_IO_H
+
+// Includes fixed-width integer types such as uint64_t
+#include <cstdint>
+
+// Includes std::unique_ptr, returned by the backend factory
+#include <memory>
+
+// Includes the vector container used for request batches
+#include <vector>
+
+// Includes the File class that requests read from
+#include "File.h"
+
+/**
+ * One positioned read issued to a `RegionIOBackend`.
+ */
+struct ChunkReadRequest {
+    /** The file to read from */
+    const File* file;
+
+    /** The position in the file to read from */
+    uint64_t offset;
+
+    /** Receives the data; must hold `size` bytes */
+    uint8_t* buffer;
+
+    /** The number of bytes to read */
+    uint32_t size;
+
+    /** Set by the backend: true if all `size` bytes were read */
+    bool success;
+
+    /** Free for the caller to use (for example, the index of the chunk this read belongs to) */
+    size_t tag;
+};
+
+/**
+ * The `RegionIOBackend` class is the interface for reading many chunk payloads at once.
+ *
+ * Loading a world touches tens of thousands of chunks. Issuing one blocking
+ * syscall per chunk from a single thread leaves the disk idle between requests,
+ * so backends take a whole batch and keep many reads in flight:
+ * - `UringIOBackend` submits the batch through io_uring (Linux)
+ * - `ThreadPoolIOBackend` spreads it across worker threads (everywhere)
+ */
+class RegionIOBackend {
+public:
+    /**
+     * Destructor: Virtual, so backends can be destroyed through this interface.
+     */
+    virtual ~RegionIOBackend() = default;
+
+    /**
+     * Performs every read in a batch, blocking until all have completed.
+     * Each request's `success` flag reports its outcome.
+     *
+     * @param requests The reads to perform. Sorting them by file and offset helps.
+     */
+    virtual void readBatch(std::vector<ChunkReadRequest>& requests) = 0;
+
+    /** Returns a short name for the backend, for logs */
+    virtual const char* getName() const = 0;
+
+    /**
+     * Creates the fastest backend available on this system:
+     * io_uring when it was compiled in and the kernel allows it, otherwise a thread pool.
+     */
+    static std::unique_ptr<RegionIOBackend> create();
+};
+
+#endif  // Ends the conditional inclusion directive
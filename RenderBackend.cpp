@@ -0,0 +1,42 @@
+// Includes the corresponding header file to access the RenderBackend class declaration
+#include "RenderBackend.h"
+
+// Includes standard I/O for printing error messages to the console
+#include <iostream>
+
+// Includes the GL state cache, which is reset when the backend changes
+#include "GLStateCache.h"
+
+// Includes the recording backend, used (with recording off) when no backend was set
+#include "RecordingRenderBackend.h"
+
+RenderBackend* RenderBackend::current = nullptr;
+
+/**
+ * Returns the backend in use, or a backend that ignores every call if none was set.
+ */
+RenderBackend& RenderBackend::get() {
+    if (current) {
+        return *current;
+    }
+
+    static RecordingRenderBackend nullBackend(false);
+    static bool reported = false;
+    if (!reported) {
+        std::cout << "ERROR::RENDER_BACKEND::NONE_SET nothing will be drawn" << std::endl;
+        reported = true;
+    }
+    return nullBackend;
+}
+
+/**
+ * Sets the backend in use.
+ *
+ * @param backend The backend, or nullptr to unset it.
+ */
+void RenderBackend::setCurrent(RenderBackend* backend) {
+    current = backend;
+
+    // The cached bindings belonged to the previous backend
+    GLStateCache::invalidate();
+}
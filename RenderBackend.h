@@ -0,0 +1,175 @@
+// Prevents multiple inclusions of this header file, which can cause redefinition errors
+#ifndef RENDER_BACKEND_H
+#define RENDER_BACKEND_H
+
+// Includes the OpenGL Extension Wrangler Library (GLEW), for the GL types and enums only
+#include <GL/glew.h>
+
+// Includes size_t
+#include <cstddef>
+
+// Includes fixed-width integer types such as uint8_t
+#include <cstdint>
+
+// Includes the C++ Standard Library string class, used for shader sources and logs
+#include <string>
+
+// Includes the vector container, used for program binaries
+#include <vector>
+
+/**
+ * The `RenderBackend` class is the interface `Mesh`, `Shader`, `GLStateCache`
+ * and `DrawList` draw through, instead of calling OpenGL themselves.
+ *
+ * `GLRenderBackend` forwards each call to OpenGL. `RecordingRenderBackend`
+ * needs no context at all: it hands out object names, keeps buffer uploads
+ * and records draw calls, so meshing, batching and the state cache can be
+ * tested and benchmarked on machines without a GPU.
+ *
+ * The methods mirror the GL calls they replace, using GL's names and enums.
+ * Like `GLStateCache`, the backend is per-context and the engine has one
+ * context, so the one in use is global: set it with `setCurrent` right after
+ * creating the context, before creating any mesh or shader.
+ */
+class RenderBackend {
+public:
+    /**
+     * Destructor: Virtual, so backends can be deleted through this interface.
+     */
+    virtual ~RenderBackend() {}
+
+    // --- Capabilities ---
+
+    /** Returns true if shaders compile on driver threads (GL_KHR_parallel_shader_compile) */
+    virtual bool supportsParallelCompile() const = 0;
+
+    /** Returns true if linked programs can be saved and loaded (GL_ARB_get_program_binary) */
+    virtual bool supportsProgramBinary() const = 0;
+
+    // --- Buffers ---
+
+    virtual GLuint createBuffer() = 0;
+    virtual void deleteBuffer(GLuint buffer) = 0;
+    virtual void bindBuffer(GLenum target, GLuint buffer) = 0;
+
+    /** Uploads data to the buffer bound to `target` (glBufferData) */
+    virtual void bufferData(GLenum target, size_t bytes, const void* data, GLenum usage) = 0;
+
+    // --- Vertex arrays ---
+
+    virtual GLuint createVertexArray() = 0;
+    virtual void deleteVertexArray(GLuint vertexArray) = 0;
+    virtual void bindVertexArray(GLuint vertexArray) = 0;
+    virtual void vertexAttribPointer(GLuint index, GLint size, GLenum type, bool normalized, GLsizei stride, size_t offset) = 0;
+    virtual void vertexAttribIPointer(GLuint index, GLint size, GLenum type, GLsizei stride, size_t offset) = 0;
+    virtual void enableVertexAttribArray(GLuint index) = 0;
+
+    // --- Textures ---
+
+    /** Selects a texture unit, counting from 0 (glActiveTexture(GL_TEXTURE0 + unit)) */
+    virtual void activeTexture(int unit) = 0;
+    virtual GLuint createTexture() = 0;
+    virtual void bindTexture(GLenum target, GLuint texture) = 0;
+    virtual void deleteTexture(GLuint texture) = 0;
+    virtual void texParameteri(GLenum target, GLenum name, GLint value) = 0;
+
+    /** Allocates (and optionally fills) the bound texture's level 0 (glTexImage2D) */
+    virtual void texImage2D(GLenum target, GLint internalFormat, GLsizei width, GLsizei height, GLenum format,
+                            GLenum type, const void* data) = 0;
+
+    /** Replaces a rectangle of the bound texture's level 0 (glTexSubImage2D) */
+    virtual void texSubImage2D(GLenum target, GLint x, GLint y, GLsizei width, GLsizei height, GLenum format,
+                               GLenum type, const void* data) = 0;
+
+    // --- Shaders and programs ---
+
+    virtual GLuint createShader(GLenum type) = 0;
+
+    /** Sets a shader's source and starts compiling it */
+    virtual void compileShader(GLuint shader, const std::string& source) = 0;
+
+    /**
+     * Returns true if a shader compiled; otherwise fills `log` with the compiler's messages.
+     * Waits for the compile to finish.
+     */
+    virtual bool getShaderStatus(GLuint shader, std::string& log) = 0;
+    virtual void deleteShader(GLuint shader) = 0;
+
+    virtual GLuint createProgram() = 0;
+    virtual void attachShader(GLuint program, GLuint shader) = 0;
+    virtual void detachShader(GLuint program, GLuint shader) = 0;
+
+    /** Starts linking a program; asks for a retrievable binary when `retrievable` is set */
+    virtual void linkProgram(GLuint program, bool retrievable) = 0;
+
+    /**
+     * Returns true if a program linked; otherwise fills `log` with the linker's messages.
+     * Waits for the link to finish.
+     */
+    virtual bool getProgramStatus(GLuint program, std::string& log) = 0;
+
+    /** Returns true once compiling and linking have finished, without blocking */
+    virtual bool isProgramComplete(GLuint program) = 0;
+
+    /** Loads a program from a binary; returns true if the driver accepted it */
+    virtual bool loadProgramBinary(GLuint program, GLenum format, const std::vector<uint8_t>& binary) = 0;
+
+    /** Retrieves a linked program's binary; returns false if the driver has none */
+    virtual bool getProgramBinary(GLuint program, GLenum& format, std::vector<uint8_t>& binary) = 0;
+
+    virtual void useProgram(GLuint program) = 0;
+    virtual void deleteProgram(GLuint program) = 0;
+
+    // --- Uniforms (of the program in use) ---
+
+    virtual GLint getUniformLocation(GLuint program, const std::string& name) = 0;
+    virtual void uniform1i(GLint location, int value) = 0;
+    virtual void uniform1f(GLint location, float value) = 0;
+    virtual void uniform3fv(GLint location, const float* value) = 0;
+    virtual void uniformMatrix4fv(GLint location, const float* value) = 0;
+
+    // --- Fragment tests and writes ---
+
+    /** Turns color writes on or off for every channel (glColorMask) */
+    virtual void colorMask(bool enabled) = 0;
+
+    /** Turns depth writes on or off (glDepthMask) */
+    virtual void depthMask(bool enabled) = 0;
+
+    /** Sets the depth comparison, such as GL_LESS or GL_LEQUAL (glDepthFunc) */
+    virtual void depthFunc(GLenum func) = 0;
+
+    // --- Drawing ---
+
+    /** Draws indexed primitives from the bound vertex array (glDrawElements) */
+    virtual void drawElements(GLenum mode, GLsizei count, GLenum type, size_t offset) = 0;
+
+    /**
+     * Draws several index ranges of the bound vertex array in one call (glMultiDrawElements).
+     *
+     * @param counts    The number of indices of each range.
+     * @param offsets   The byte offset of each range in the element buffer.
+     * @param drawCount The number of ranges.
+     */
+    virtual void multiDrawElements(GLenum mode, const GLsizei* counts, GLenum type, const size_t* offsets,
+                                   GLsizei drawCount) = 0;
+
+    /**
+     * Returns the backend in use. If none was set, reports it once and returns a
+     * backend that ignores every call, so a missing setup fails visibly but safely.
+     */
+    static RenderBackend& get();
+
+    /**
+     * Sets the backend in use. It must outlive every mesh and shader created while it is set.
+     *
+     * @param backend The backend, or nullptr to unset it.
+     */
+    static void setCurrent(RenderBackend* backend);
+
+private:
+    /** The backend in use, or nullptr */
+    static RenderBackend* current;
+};
+
+#endif  // Ends the conditional inclusion directive
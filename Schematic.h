@@ -0,0 +1,70 @@
+// Prevents multiple inclusions of this header file, which can cause redefinition errors
+#ifndef SCHEMATIC_H
+#define SCHEMATIC_H
+
+// Includes fixed-width integer types such as uint32_t
+#include <cstdint>
+
+// Includes the ordered map used for metadata
+#include <map>
+
+// Includes the C++ Standard Library string class, used for metadata
+#include <string>
+
+#include <glm/glm.hpp> // GLM for integer vector types (glm::ivec3)
+
+#include "Chunk.h" // CHUNK_SIZE, the edge length of a schematic tile
+
+/**
+ * The `Schematic` struct describes the on-disk format of saved structures (`.kys`
+ * files), shared by `SchematicWriter` and `SchematicReader`.
+ *
+ * A schematic is cut into CHUNK_SIZE^3 tiles (smaller at the far edges), stored
+ * one after another in Y, Z, X order so they can be streamed:
+ * - FileHeader (32 bytes, native byte order)
+ * - metadata: a uint32 entry count, then per entry a uint16 length and bytes for the key and the value
+ * - tiles: each a uint32 byte length, then (uint16 run, uint16 palette index) pairs
+ *   covering the tile in `Chunk` block order
+ * - palette: `paletteCount` uint16 block IDs, at `paletteOffset`
+ *
+ * The palette comes last because it is only known once every tile is written;
+ * readers fetch it first with a positioned read, then stream the tiles.
+ */
+struct Schematic {
+    /** Identifies a schematic file ("KYSC") */
+    static constexpr uint32_t MAGIC = 0x4353594b;
+
+    /** The current file format version */
+    static constexpr uint32_t VERSION = 1;
+
+    /** The edge length of a tile; equal to the chunk size so aligned tiles map to single chunks */
+    static constexpr int TILE_SIZE = CHUNK_SIZE;
+
+    /** Free-form key/value information, such as the name and author */
+    using Metadata = std::map<std::string, std::string>;
+
+    /** The fixed header at the start of every schematic file */
+    struct FileHeader {
+        uint32_t magic;
+        uint32_t version;
+        int32_t size[3];
+        uint32_t paletteCount;
+        uint64_t paletteOffset;
+    };
+
+    /** Returns the number of tiles along each axis of a schematic */
+    static glm::ivec3 tileCounts(const glm::ivec3& size) {
+        return (size + glm::ivec3(TILE_SIZE - 1)) / TILE_SIZE;
+    }
+
+    /** Returns the position in the stream of the tile containing a block */
+    static size_t tileIndexOf(const glm::ivec3& block, const glm::ivec3& size) {
+        glm::ivec3 counts = tileCounts(size);
+        glm::ivec3 tile = block / TILE_SIZE;
+        return (size_t(tile.y) * counts.z + tile.z) * counts.x + tile.x;
+    }
+};
+
+static_assert(sizeof(Schematic::FileHeader) == 32, "Schematic::FileHeader must have no padding");
+
+#endif  // Ends the conditional inclusion directive
@@ -0,0 +1,283 @@
+// Includes the corresponding header file to access the SchematicReader class declaration
+#include "SchematicReader.h"
+
+// Includes std::copy_n and std::min
+#include <algorithm>
+
+// Includes std::memcpy, used to read values from the buffer
+#include <cstring>
+
+// Includes standard I/O for printing error messages to the console
+#include <iostream>
+
+// Includes std::numeric_limits, the largest structure size whose tile count fits an int
+#include <limits>
+
+// Includes the world structures are placed in
+#include "World.h"
+
+/** The file is read ahead in pieces of this many bytes */
+static const size_t READ_AHEAD_BYTES = 1 << 20;
+
+/**
+ * Reads a value at an offset in a byte buffer, in native byte order.
+ */
+template <typename T>
+static T readValue(const uint8_t* bytes) {
+    T value;
+    std::memcpy(&value, bytes, sizeof(T));
+    return value;
+}
+
+/**
+ * Constructor: Creates a reader with no file open.
+ */
+SchematicReader::SchematicReader()
+    : size(0), tileCount(0), nextTile(0), readOffset(0), tilesEnd(0), bufferPosition(0) {}
+
+/**
+ * Opens a schematic and reads its header, metadata and palette.
+ *
+ * @param path The path of the schematic file.
+ * @return True if the file is a valid schematic.
+ */
+bool SchematicReader::open(const std::string& path) {
+    if (!file.open(path, false)) {
+        std::cout << "ERROR::SCHEMATIC::OPEN_FAILED " << path << std::endl;
+        return false;
+    }
+
+    Schematic::FileHeader header;
+    if (!file.readAt(&header, sizeof(header), 0) ||
+        header.magic != Schematic::MAGIC || header.version != Schematic::VERSION ||
+        header.size[0] <= 0 || header.size[1] <= 0 || header.size[2] <= 0 ||
+        header.paletteOffset < sizeof(header) || header.paletteOffset > file.size()) {
+        std::cout << "ERROR::SCHEMATIC::INVALID_HEADER " << path << std::endl;
+        return false;
+    }
+
+    // --- Palette, stored after the tiles; checked against the file before anything is allocated ---
+    if (header.paletteCount > (file.size() - header.paletteOffset) / sizeof(BlockID)) {
+        std::cout << "ERROR::SCHEMATIC::TRUNCATED_PALETTE " << path << std::endl;
+        return false;
+    }
+    palette.resize(header.paletteCount);
+    if (header.paletteCount > 0 &&
+        !file.readAt(palette.data(), palette.size() * sizeof(BlockID), header.paletteOffset)) {
+        std::cout << "ERROR::SCHEMATIC::TRUNCATED_PALETTE " << path << std::endl;
+        return false;
+    }
+
+    // Every tile starts with a uint32_t, so the bytes before the palette bound the tile count.
+    // Checking each factor against that bound keeps the product from overflowing
+    uint64_t maxTiles = (header.paletteOffset - sizeof(header)) / sizeof(uint32_t);
+    uint64_t tiles = 1;
+    for (int32_t extent : header.size) {
+        // `Schematic::tileCounts` rounds up in int, which must not overflow either
+        if (extent > std::numeric_limits<int32_t>::max() - (Schematic::TILE_SIZE - 1)) {
+            std::cout << "ERROR::SCHEMATIC::INVALID_HEADER " << path << std::endl;
+            return false;
+        }
+        uint64_t tilesAlong = (uint64_t(extent) + Schematic::TILE_SIZE - 1) / Schematic::TILE_SIZE;
+        if (tilesAlong > maxTiles / tiles) {
+            std::cout << "ERROR::SCHEMATIC::TRUNCATED_TILES " << path << std::endl;
+            return false;
+        }
+        tiles *= tilesAlong;
+    }
+
+    size = glm::ivec3(header.size[0], header.size[1], header.size[2]);
+    tileCount = size_t(tiles);
+    nextTile = 0;
+    tilesEnd = header.paletteOffset;
+    readOffset = sizeof(header);
+    buffer.clear();
+    bufferPosition = 0;
+
+    // --- Metadata ---
+    metadata.clear();
+    if (!ensureBuffered(sizeof(uint32_t))) {
+        return false;
+    }
+    uint32_t entries = readValue<uint32_t>(&buffer[bufferPosition]);
+    bufferPosition += sizeof(uint32_t);
+
+    for (uint32_t i = 0; i < entries; ++i) {
+        std::string text[2];
+        for (std::string& part : text) {
+            if (!ensureBuffered(sizeof(uint16_t))) {
+                return false;
+            }
+            uint16_t length = readValue<uint16_t>(&buffer[bufferPosition]);
+            bufferPosition += sizeof(uint16_t);
+
+            if (!ensureBuffered(length)) {
+                return false;
+            }
+            part.assign(reinterpret_cast<const char*>(&buffer[bufferPosition]), length);
+            bufferPosition += length;
+        }
+        metadata[text[0]] = text[1];
+    }
+
+    return true;
+}
+
+/**
+ * Passes every palette entry through a lookup table.
+ *
+ * @param lut     The new ID for each old ID.
+ * @param lutSize The number of entries in `lut`.
+ */
+void SchematicReader::remapPalette(const BlockID* lut, size_t lutSize) {
+    for (BlockID& block : palette) {
+        if (block < lutSize) {
+            block = lut[block];
+        }
+    }
+}
+
+/**
+ * Reads the next tile in stream order.
+ *
+ * @param origin Receives the corner of the tile inside the structure.
+ * @param tile   Receives the blocks of the tile (its storage is reused).
+ * @return True if a tile was read; false at the end of the stream or on error.
+ */
+bool SchematicReader::readTile(glm::ivec3& origin, BlockVolume& tile) {
+    if (isComplete() || !ensureBuffered(sizeof(uint32_t))) {
+        return false;
+    }
+
+    // Tiles are stored in Y, Z, X order, clipped at the far edges
+    glm::ivec3 counts = Schematic::tileCounts(size);
+    size_t tilesPerLayer = size_t(counts.x) * counts.z;
+    origin = glm::ivec3(int(nextTile % counts.x), int(nextTile / tilesPerLayer), int(nextTile / counts.x % counts.z));
+    origin *= Schematic::TILE_SIZE;
+
+    glm::ivec3 tileSize = glm::min(glm::ivec3(Schematic::TILE_SIZE), size - origin);
+    if (tile.getSize() != tileSize) {
+        tile = BlockVolume(tileSize);
+    }
+
+    uint32_t length = readValue<uint32_t>(&buffer[bufferPosition]);
+    bufferPosition += sizeof(uint32_t);
+    if (length % 4 != 0 || !ensureBuffered(length)) {
+        std::cout << "ERROR::SCHEMATIC::TRUNCATED_TILE " << nextTile << std::endl;
+        return false;
+    }
+
+    // Expand the runs straight into the tile, translating palette indices as we go
+    BlockID* blocks = tile.getData();
+    size_t count = tile.getVolume();
+    size_t filled = 0;
+    const uint8_t* runs = &buffer[bufferPosition];
+    for (uint32_t offset = 0; offset < length; offset += 4) {
+        uint16_t run = readValue<uint16_t>(runs + offset);
+        uint16_t index = readValue<uint16_t>(runs + offset + 2);
+        if (run == 0 || filled + run > count || index >= palette.size()) {
+            std::cout << "ERROR::SCHEMATIC::INVALID_RUN " << nextTile << std::endl;
+            return false;
+        }
+
+        std::fill_n(blocks + filled, run, palette[index]);
+        filled += run;
+    }
+    bufferPosition += length;
+
+    if (filled != count) {
+        std::cout << "ERROR::SCHEMATIC::INCOMPLETE_TILE " << nextTile << std::endl;
+        return false;
+    }
+
+    ++nextTile;
+    return true;
+}
+
+/**
+ * Reads every remaining tile into a world.
+ *
+ * @param world  The world to place the structure in.
+ * @param origin Where the structure's first corner lands, as an absolute block coordinate.
+ * @return True if every tile was placed and every chunk it finished was saved.
+ */
+bool SchematicReader::place(World& world, const glm::i64vec3& origin) {
+    // Chunks this placement loaded, to unload once every tile covering them is placed
+    std::vector<glm::i64vec3> loadedHere;
+
+    BlockVolume tile;
+    glm::ivec3 tileOrigin;
+    while (!isComplete()) {
+        if (!readTile(tileOrigin, tile)) {
+            return false;
+        }
+
+        glm::i64vec3 tileMin = origin + glm::i64vec3(tileOrigin);
+        glm::i64vec3 firstChunk = WorldPosition::fromBlock(tileMin).chunk;
+        glm::i64vec3 lastChunk = WorldPosition::fromBlock(tileMin + glm::i64vec3(tile.getSize()) - glm::i64vec3(1)).chunk;
+        glm::i64vec3 coord;
+        for (coord.y = firstChunk.y; coord.y <= lastChunk.y; ++coord.y) {
+            for (coord.z = firstChunk.z; coord.z <= lastChunk.z; ++coord.z) {
+                for (coord.x = firstChunk.x; coord.x <= lastChunk.x; ++coord.x) {
+                    if (!world.getChunk(coord)) {
+                        loadedHere.push_back(coord);
+                    }
+                }
+            }
+        }
+
+        if (!world.pasteVolume(tile, tileMin)) {
+            return false;
+        }
+
+        // A chunk is finished once the tile holding its last block inside the structure is placed;
+        // unloading saves it, so memory stays bounded by the chunks still being written
+        size_t tileIndex = nextTile - 1;
+        bool saved = true;
+        auto finished = [&](const glm::i64vec3& chunk) {
+            glm::i64vec3 chunkMax = chunk * int64_t(CHUNK_SIZE) + glm::i64vec3(CHUNK_SIZE - 1) - origin;
+            glm::ivec3 last(glm::min(chunkMax, glm::i64vec3(size) - glm::i64vec3(1)));
+            if (Schematic::tileIndexOf(last, size) > tileIndex) {
+                return false;
+            }
+            // A chunk that failed to save stays loaded and dirty in the world
+            saved = world.unloadChunk(chunk) && saved;
+            return true;
+        };
+        loadedHere.erase(std::remove_if(loadedHere.begin(), loadedHere.end(), finished), loadedHere.end());
+        if (!saved) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Makes at least `count` unread bytes available in the buffer.
+ */
+bool SchematicReader::ensureBuffered(size_t count) {
+    size_t available = buffer.size() - bufferPosition;
+    if (available >= count) {
+        return true;
+    }
+
+    // Move the unread bytes to the front, then read ahead (never past the palette)
+    std::copy(buffer.begin() + bufferPosition, buffer.end(), buffer.begin());
+    uint64_t remaining = tilesEnd - readOffset;
+    size_t wanted = size_t(std::min<uint64_t>(remaining, std::max(count - available, READ_AHEAD_BYTES)));
+    if (available + wanted < count) {
+        std::cout << "ERROR::SCHEMATIC::UNEXPECTED_END" << std::endl;
+        return false;
+    }
+
+    buffer.resize(available + wanted);
+    bufferPosition = 0;
+    if (!file.readAt(buffer.data() + available, wanted, readOffset)) {
+        std::cout << "ERROR::SCHEMATIC::READ_FAILED" << std::endl;
+        return false;
+    }
+
+    readOffset += wanted;
+    return true;
+}
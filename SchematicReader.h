@@ -0,0 +1,116 @@
+// Prevents multiple inclusions of this header file, which can cause redefinition errors
+#ifndef SCHEMATIC_READER_H
+#define SCHEMATIC_READER_H
+
+// Includes fixed-width integer types such as uint64_t
+#include <cstdint>
+
+// Includes the C++ Standard Library string class, used for file paths
+#include <string>
+
+// Includes the vector container used for the palette and read buffer
+#include <vector>
+
+#include <glm/glm.hpp>                      // GLM for vector types
+#include <glm/ext/vector_int3_sized.hpp>    // GLM 64-bit integer vectors (glm::i64vec3)
+
+#include "BlockVolume.h"    // Tiles of blocks
+#include "File.h"           // The input file
+#include "Schematic.h"      // The file format
+
+// Forward declaration, so this header doesn't pull in the whole world
+class World;
+
+/**
+ * The `SchematicReader` class streams a schematic one tile at a time.
+ *
+ * Only the header, metadata, palette and a fixed-size read buffer are kept in
+ * memory, so `place` can put a structure of any size into a world while
+ * holding just one tile and the chunks it is still writing to.
+ */
+class SchematicReader {
+public:
+    /**
+     * Constructor: Creates a reader with no file open.
+     */
+    SchematicReader();
+
+    /**
+     * Opens a schematic and reads its header, metadata and palette.
+     *
+     * @param path The path of the schematic file.
+     * @return True if the file is a valid schematic.
+     */
+    bool open(const std::string& path);
+
+    /** Returns the size of the structure, in blocks */
+    const glm::ivec3& getSize() const { return size; }
+
+    /** Returns the metadata stored with the structure */
+    const Schematic::Metadata& getMetadata() const { return metadata; }
+
+    /** Returns the block ID of each palette entry */
+    const std::vector<BlockID>& getPalette() const { return palette; }
+
+    /**
+     * Passes every palette entry through a lookup table, for example to
+     * convert block IDs from the world the schematic was saved in.
+     * Applies to tiles read after the call. IDs past the end of the table are left unchanged.
+     *
+     * @param lut     The new ID for each old ID.
+     * @param lutSize The number of entries in `lut`.
+     */
+    void remapPalette(const BlockID* lut, size_t lutSize);
+
+    /**
+     * Reads the next tile in stream order.
+     *
+     * @param origin Receives the corner of the tile inside the structure.
+     * @param tile   Receives the blocks of the tile (its storage is reused).
+     * @return True if a tile was read; false at the end of the stream or on error.
+     */
+    bool readTile(glm::ivec3& origin, BlockVolume& tile);
+
+    /** Returns true once every tile has been read */
+    bool isComplete() const { return nextTile == tileCount; }
+
+    /**
+     * Reads every remaining tile into a world. Chunks that weren't loaded
+     * beforehand are saved and unloaded as soon as their last tile is placed.
+     *
+     * @param world  The world to place the structure in.
+     * @param origin Where the structure's first corner lands, as an absolute block coordinate.
+     * @return True if every tile was placed and every chunk it finished was saved.
+     */
+    bool place(World& world, const glm::i64vec3& origin);
+
+private:
+    /**
+     * Makes at least `count` unread bytes available in the buffer.
+     */
+    bool ensureBuffered(size_t count);
+
+    /** The input file */
+    File file;
+
+    /** The size of the structure, in blocks */
+    glm::ivec3 size;
+
+    /** The metadata stored with the structure */
+    Schematic::Metadata metadata;
+
+    /** The block ID of each palette entry */
+    std::vector<BlockID> palette;
+
+    /** The number of tiles in the structure, and the index of the next one */
+    size_t tileCount, nextTile;
+
+    /** The file offset of the first byte after the buffered data, and of the palette (where tiles end) */
+    uint64_t readOffset, tilesEnd;
+
+    /** Bytes read ahead from the file, and the position of the first unread one */
+    std::vector<uint8_t> buffer;
+    size_t bufferPosition;
+};
+
+#endif  // Ends the conditional inclusion directive
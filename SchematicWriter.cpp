@@ -0,0 +1,243 @@
+// Includes the corresponding header file to access the SchematicWriter class declaration
+#include "SchematicWriter.h"
+
+// Includes std::min
+#include <algorithm>
+
+// Includes standard I/O for printing error messages to the console
+#include <iostream>
+
+// Includes the world that regions are exported from
+#include "World.h"
+
+/** Buffered output is written to the file once it reaches this many bytes */
+static const size_t FLUSH_BYTES = 1 << 20;
+
+/**
+ * Appends a value to a byte buffer in native byte order.
+ */
+template <typename T>
+static void appendValue(std::vector<uint8_t>& buffer, T value) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+/**
+ * Appends a length-prefixed string to a byte buffer.
+ */
+static void appendString(std::vector<uint8_t>& buffer, const std::string& text) {
+    uint16_t length = uint16_t(std::min<size_t>(text.size(), 0xffff));
+    appendValue(buffer, length);
+    buffer.insert(buffer.end(), text.begin(), text.begin() + length);
+}
+
+/**
+ * Constructor: Creates a writer with no file open.
+ */
+SchematicWriter::SchematicWriter() : size(0), tileCount(0), nextTile(0), writeOffset(0) {}
+
+/**
+ * Creates the schematic file and writes its header and metadata.
+ *
+ * @param path     The path of the new file.
+ * @param size     The size of the structure, in blocks.
+ * @param metadata Free-form information stored with the structure.
+ * @return True on success.
+ */
+bool SchematicWriter::open(const std::string& path, const glm::ivec3& size, const Schematic::Metadata& metadata) {
+    if (size.x <= 0 || size.y <= 0 || size.z <= 0) {
+        std::cout << "ERROR::SCHEMATIC::INVALID_SIZE" << std::endl;
+        return false;
+    }
+
+    if (!file.open(path, true, true)) {
+        std::cout << "ERROR::SCHEMATIC::OPEN_FAILED " << path << std::endl;
+        return false;
+    }
+
+    this->size = size;
+    glm::ivec3 counts = Schematic::tileCounts(size);
+    tileCount = size_t(counts.x) * counts.y * counts.z;
+    nextTile = 0;
+    palette.clear();
+    paletteIndex.assign(size_t(1) << 16, -1);
+
+    // The header is rewritten by `finish` once the palette offset is known
+    buffer.clear();
+    buffer.resize(sizeof(Schematic::FileHeader));
+
+    appendValue(buffer, uint32_t(metadata.size()));
+    for (const auto& entry : metadata) {
+        appendString(buffer, entry.first);
+        appendString(buffer, entry.second);
+    }
+
+    writeOffset = 0;
+    return true;
+}
+
+/**
+ * Appends the next tile.
+ *
+ * @param tile The blocks of the tile.
+ * @return True on success.
+ */
+bool SchematicWriter::writeTile(const BlockVolume& tile) {
+    if (isComplete() || tile.getSize() != getNextTileSize()) {
+        std::cout << "ERROR::SCHEMATIC::UNEXPECTED_TILE" << std::endl;
+        return false;
+    }
+
+    // Reserve the length field, then fill in the runs
+    size_t lengthOffset = buffer.size();
+    appendValue(buffer, uint32_t(0));
+
+    const BlockID* blocks = tile.getData();
+    size_t count = tile.getVolume();
+    size_t i = 0;
+    while (i < count) {
+        BlockID block = blocks[i];
+        size_t run = 1;
+        while (i + run < count && blocks[i + run] == block) {
+            ++run;
+        }
+
+        // Add new block types to the palette as they are first seen
+        int32_t& index = paletteIndex[block];
+        if (index < 0) {
+            index = int32_t(palette.size());
+            palette.push_back(block);
+        }
+
+        appendValue(buffer, uint16_t(run));
+        appendValue(buffer, uint16_t(index));
+        i += run;
+    }
+
+    uint32_t length = uint32_t(buffer.size() - lengthOffset - sizeof(uint32_t));
+    std::copy_n(reinterpret_cast<const uint8_t*>(&length), sizeof(length), buffer.begin() + lengthOffset);
+
+    ++nextTile;
+    return buffer.size() < FLUSH_BYTES || flushBuffer();
+}
+
+/**
+ * Writes the palette and completes the header.
+ *
+ * @return True on success.
+ */
+bool SchematicWriter::finish() {
+    if (!isComplete()) {
+        std::cout << "ERROR::SCHEMATIC::MISSING_TILES " << (tileCount - nextTile) << std::endl;
+        return false;
+    }
+
+    Schematic::FileHeader header;
+    header.magic = Schematic::MAGIC;
+    header.version = Schematic::VERSION;
+    header.size[0] = size.x;
+    header.size[1] = size.y;
+    header.size[2] = size.z;
+    header.paletteCount = uint32_t(palette.size());
+    header.paletteOffset = writeOffset + buffer.size();
+
+    for (BlockID block : palette) {
+        appendValue(buffer, block);
+    }
+
+    // Write the header last, so a file cut short never looks complete
+    if (!flushBuffer() || !file.writeAt(&header, sizeof(header), 0) || !file.sync()) {
+        std::cout << "ERROR::SCHEMATIC::WRITE_FAILED" << std::endl;
+        return false;
+    }
+
+    file.close();
+    return true;
+}
+
+/** Returns the corner of the tile expected by the next `writeTile` call */
+glm::ivec3 SchematicWriter::getNextTileOrigin() const {
+    glm::ivec3 counts = Schematic::tileCounts(size);
+    size_t tilesPerLayer = size_t(counts.x) * counts.z;
+    glm::ivec3 tile(int(nextTile % counts.x), int(nextTile / tilesPerLayer), int(nextTile / counts.x % counts.z));
+    return tile * Schematic::TILE_SIZE;
+}
+
+/** Returns the size of the tile expected by the next `writeTile` call */
+glm::ivec3 SchematicWriter::getNextTileSize() const {
+    return glm::min(glm::ivec3(Schematic::TILE_SIZE), size - getNextTileOrigin());
+}
+
+/**
+ * Saves a box of a world as a schematic.
+ *
+ * @param world    The world to copy from.
+ * @param min      The lowest corner of the box, as an absolute block coordinate.
+ * @param size     The size of the box, in blocks.
+ * @param path     The path of the new file.
+ * @param metadata Free-form information stored with the structure.
+ * @return True on success.
+ */
+bool SchematicWriter::exportRegion(World& world, const glm::i64vec3& min, const glm::ivec3& size,
+                                   const std::string& path, const Schematic::Metadata& metadata) {
+    SchematicWriter writer;
+    if (!writer.open(path, size, metadata)) {
+        return false;
+    }
+
+    // Chunks this export loaded, to unload once every tile covering them is written
+    std::vector<glm::i64vec3> loadedHere;
+
+    while (!writer.isComplete()) {
+        glm::ivec3 origin = writer.getNextTileOrigin();
+        glm::ivec3 tileSize = writer.getNextTileSize();
+        glm::i64vec3 tileMin = min + glm::i64vec3(origin);
+
+        // Note which chunks of this tile are about to be loaded by the copy
+        glm::i64vec3 firstChunk = WorldPosition::fromBlock(tileMin).chunk;
+        glm::i64vec3 lastChunk = WorldPosition::fromBlock(tileMin + glm::i64vec3(tileSize) - glm::i64vec3(1)).chunk;
+        glm::i64vec3 coord;
+        for (coord.y = firstChunk.y; coord.y <= lastChunk.y; ++coord.y) {
+            for (coord.z = firstChunk.z; coord.z <= lastChunk.z; ++coord.z) {
+                for (coord.x = firstChunk.x; coord.x <= lastChunk.x; ++coord.x) {
+                    if (!world.getChunk(coord)) {
+                        loadedHere.push_back(coord);
+                    }
+                }
+            }
+        }
+
+        size_t tileIndex = Schematic::tileIndexOf(origin, size);
+        if (!writer.writeTile(world.copyVolume(tileMin, tileSize))) {
+            return false;
+        }
+
+        // A chunk is finished once the tile holding its last block inside the box is written
+        auto finished = [&](const glm::i64vec3& chunk) {
+            glm::i64vec3 chunkMax = chunk * int64_t(CHUNK_SIZE) + glm::i64vec3(CHUNK_SIZE - 1) - min;
+            glm::ivec3 last(glm::min(chunkMax, glm::i64vec3(size) - glm::i64vec3(1)));
+            if (Schematic::tileIndexOf(last, size) > tileIndex) {
+                return false;
+            }
+            world.unloadChunk(chunk);
+            return true;
+        };
+        loadedHere.erase(std::remove_if(loadedHere.begin(), loadedHere.end(), finished), loadedHere.end());
+    }
+
+    return writer.finish();
+}
+
+/**
+ * Writes the buffered bytes to the file.
+ */
+bool SchematicWriter::flushBuffer() {
+    if (!file.writeAt(buffer.data(), buffer.size(), writeOffset)) {
+        std::cout << "ERROR::SCHEMATIC::WRITE_FAILED" << std::endl;
+        return false;
+    }
+
+    writeOffset += buffer.size();
+    buffer.clear();
+    return true;
+}
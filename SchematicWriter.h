@@ -0,0 +1,115 @@
+// Prevents multiple inclusions of this header file, which can cause redefinition errors
+#ifndef SCHEMATIC_WRITER_H
+#define SCHEMATIC_WRITER_H
+
+// Includes fixed-width integer types such as uint64_t
+#include <cstdint>
+
+// Includes the C++ Standard Library string class, used for file paths
+#include <string>
+
+// Includes the vector container used for the palette and output buffer
+#include <vector>
+
+#include <glm/glm.hpp>                      // GLM for vector types
+#include <glm/ext/vector_int3_sized.hpp>    // GLM 64-bit integer vectors (glm::i64vec3)
+
+#include "BlockVolume.h"    // Tiles of blocks
+#include "File.h"           // The output file
+#include "Schematic.h"      // The file format
+
+// Forward declaration, so this header doesn't pull in the whole world
+class World;
+
+/**
+ * The `SchematicWriter` class writes a schematic one tile at a time, so a
+ * structure of any size can be saved without holding it in memory.
+ *
+ * Call `open`, then `writeTile` once per tile in stream order (`getNextTileOrigin`
+ * says which tile is expected), then `finish`.
+ */
+class SchematicWriter {
+public:
+    /**
+     * Constructor: Creates a writer with no file open.
+     */
+    SchematicWriter();
+
+    /**
+     * Creates the schematic file and writes its header and metadata.
+     *
+     * @param path     The path of the new file.
+     * @param size     The size of the structure, in blocks.
+     * @param metadata Free-form information stored with the structure.
+     * @return True on success.
+     */
+    bool open(const std::string& path, const glm::ivec3& size, const Schematic::Metadata& metadata);
+
+    /**
+     * Appends the next tile. Its size must match the tile expected at
+     * `getNextTileOrigin` (TILE_SIZE, clipped to the structure's far edges).
+     *
+     * @param tile The blocks of the tile.
+     * @return True on success.
+     */
+    bool writeTile(const BlockVolume& tile);
+
+    /**
+     * Writes the palette and completes the header. Every tile must have been written.
+     *
+     * @return True on success.
+     */
+    bool finish();
+
+    /** Returns the corner of the tile expected by the next `writeTile` call */
+    glm::ivec3 getNextTileOrigin() const;
+
+    /** Returns the size of the tile expected by the next `writeTile` call */
+    glm::ivec3 getNextTileSize() const;
+
+    /** Returns true once every tile has been written */
+    bool isComplete() const { return nextTile == tileCount; }
+
+    /**
+     * Saves a box of a world as a schematic. Only one tile is held at a time, and
+     * chunks that weren't loaded beforehand are unloaded once fully copied.
+     *
+     * @param world    The world to copy from.
+     * @param min      The lowest corner of the box, as an absolute block coordinate.
+     * @param size     The size of the box, in blocks.
+     * @param path     The path of the new file.
+     * @param metadata Free-form information stored with the structure.
+     * @return True on success.
+     */
+    static bool exportRegion(World& world, const glm::i64vec3& min, const glm::ivec3& size,
+                             const std::string& path, const Schematic::Metadata& metadata);
+
+private:
+    /**
+     * Writes the buffered bytes to the file.
+     */
+    bool flushBuffer();
+
+    /** The output file */
+    File file;
+
+    /** The size of the structure, in blocks */
+    glm::ivec3 size;
+
+    /** The number of tiles in the structure, and the index of the next one */
+    size_t tileCount, nextTile;
+
+    /** The file offset the buffer will be written at */
+    uint64_t writeOffset;
+
+    /** Bytes waiting to be written; flushed in large pieces */
+    std::vector<uint8_t> buffer;
+
+    /** The block ID of each palette entry */
+    std::vector<BlockID> palette;
+
+    /** The palette index of each block ID, or -1 if it isn't in the palette yet */
+    std::vector<int32_t> paletteIndex;
+};
+
+#endif  // Ends the conditional inclusion directive
@@ -4,6 +4,15 @@
 // Includes standard I/O for printing error messages to the console
 #include <iostream>
 
+// Includes std::swap
+#include <utility>
+
+// Includes the GL state cache, which skips glUseProgram when the program is already in use
+#include "GLStateCache.h"
+
+// Includes the render backend, which every GL call goes through
+#include "RenderBackend.h"
+
 #include <glm/glm.hpp> // GLM for matrix operations
 #include <glm/gtc/type_ptr.hpp> // GLM for matrix transformations
 
@@ -13,66 +22,65 @@
  * 
  * @param vertexSource   A string containing the GLSL code for the vertex shader.
  * @param fragmentSource A string containing the GLSL code for the fragment shader.
+ * @param waitForLink    If false, return as soon as the work is submitted; call `finishLink` later.
  */
-Shader::Shader(const std::string& vertexSource, const std::string& fragmentSource) {
-    // --- Compile Vertex Shader ---
-    
-    // Create a new vertex shader object in OpenGL
-    GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
+Shader::Shader(const std::string& vertexSource, const std::string& fragmentSource, bool waitForLink)
+    : linkFinished(false), valid(false) {
+    // --- Compile Vertex and Fragment Shaders ---
 
-    // Convert the C++ string to a C-style string (char pointer) for OpenGL
-    const char* vertexSrc = vertexSource.c_str();
-    
-    // Attach the source code to the shader object and compile it
-    glShaderSource(vertexShader, 1, &vertexSrc, NULL);
-    glCompileShader(vertexShader);
-
-    // Check for compilation errors
-    checkShaderCompileErrors(vertexShader, "VERTEX");
-
-    // --- Compile Fragment Shader ---
-    
-    // Create a new fragment shader object in OpenGL
-    GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-
-    // Convert the C++ string to a C-style string
-    const char* fragmentSrc = fragmentSource.c_str();
-    
-    // Attach the source code to the shader object and compile it
-    glShaderSource(fragmentShader, 1, &fragmentSrc, NULL);
-    glCompileShader(fragmentShader);
-
-    // Check for compilation errors
-    checkShaderCompileErrors(fragmentShader, "FRAGMENT");
+    // Errors are only checked in finishLink: querying the status here would
+    // stall until the driver's compiler threads are done
+    vertexShader = compileStage(GL_VERTEX_SHADER, vertexSource);
+    fragmentShader = compileStage(GL_FRAGMENT_SHADER, fragmentSource);
 
     // --- Link the Shader Program ---
+    RenderBackend& backend = RenderBackend::get();
     
     // Create a new shader program object
-    programID = glCreateProgram();
+    programID = backend.createProgram();
 
     // Attach the compiled vertex and fragment shaders to the program
-    glAttachShader(programID, vertexShader);
-    glAttachShader(programID, fragmentShader);
+    backend.attachShader(programID, vertexShader);
+    backend.attachShader(programID, fragmentShader);
 
-    // Link the program to create an executable shader pipeline
-    glLinkProgram(programID);
+    // Link the program to create an executable shader pipeline; the driver is asked
+    // to keep the linked program retrievable as a binary, for ShaderLibrary's disk cache
+    backend.linkProgram(programID, true);
 
-    // Check for linking errors
-    checkProgramLinkErrors(programID);
+    if (waitForLink) {
+        finishLink();
+    }
+}
 
-    // --- Cleanup Temporary Shader Objects ---
-    
-    // The shaders are now linked into the program, so we no longer need them
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
+/**
+ * Constructor: Loads a program from a binary saved by `getBinary`.
+ *
+ * @param binaryFormat The driver-specific format the binary was saved in.
+ * @param binary       The program binary.
+ */
+Shader::Shader(GLenum binaryFormat, const std::vector<uint8_t>& binary)
+    : vertexShader(0), fragmentShader(0), linkFinished(true), valid(false) {
+    RenderBackend& backend = RenderBackend::get();
+    programID = backend.createProgram();
+
+    // A driver update makes old binaries invalid; that is expected, so it isn't reported
+    valid = backend.loadProgramBinary(programID, binaryFormat, binary);
 }
 
 /**
  * Destructor: Cleans up the shader program when the object is destroyed.
  */
 Shader::~Shader() {
-    // Deletes the shader program from OpenGL memory
-    glDeleteProgram(programID);
+    // Shader objects only remain if finishLink was never called
+    if (vertexShader) {
+        RenderBackend::get().deleteShader(vertexShader);
+    }
+    if (fragmentShader) {
+        RenderBackend::get().deleteShader(fragmentShader);
+    }
+
+    // Deletes the shader program from OpenGL memory (and from the state cache)
+    GLStateCache::deleteProgram(programID);
 }
 
 /**
@@ -80,7 +88,7 @@ Shader::~Shader() {
  * This must be called before rendering objects that use this shader.
  */
 void Shader::use() const {
-    glUseProgram(programID);
+    GLStateCache::useProgram(programID);
 }
 
 /**
@@ -91,14 +99,107 @@ void Shader::use() const {
  */
 void Shader::setFloat(const std::string& name, float value) const {
     // Gets the location of the uniform variable in the shader program
-    GLint location = glGetUniformLocation(programID, name.c_str());
+    RenderBackend& backend = RenderBackend::get();
+    GLint location = backend.getUniformLocation(programID, name);
 
     // Assigns the provided float value to the uniform variable
-    glUniform1f(location, value);
+    backend.uniform1f(location, value);
+}
+
+/**
+ * Sets an integer (or sampler) uniform variable in the shader program.
+ */
+void Shader::setInt(const std::string& name, int value) const {
+    RenderBackend& backend = RenderBackend::get();
+    backend.uniform1i(backend.getUniformLocation(programID, name), value);
+}
+
+/**
+ * Sets a vec3 uniform variable in the shader program.
+ */
+void Shader::setVec3(const std::string& name, const glm::vec3& value) const {
+    RenderBackend& backend = RenderBackend::get();
+    backend.uniform3fv(backend.getUniformLocation(programID, name), glm::value_ptr(value));
 }
 
 void Shader::setMat4(const std::string& name, const glm::mat4& value) const{
-    glUniformMatrix4fv(glGetUniformLocation(programID, name.c_str()), 1, GL_FALSE, glm::value_ptr(value));
+    RenderBackend& backend = RenderBackend::get();
+    backend.uniformMatrix4fv(backend.getUniformLocation(programID, name), glm::value_ptr(value));
+}
+
+/**
+ * Returns true once the driver has finished compiling and linking, without blocking.
+ */
+bool Shader::isLinkComplete() const {
+    return linkFinished || RenderBackend::get().isProgramComplete(programID);
+}
+
+/**
+ * Waits for linking to finish, reports any compile or link errors and releases the shader objects.
+ *
+ * @return True if the program is ready to use.
+ */
+bool Shader::finishLink() {
+    if (linkFinished) {
+        return valid;
+    }
+    linkFinished = true;
+
+    // Check for compilation errors, then for linking errors
+    bool vertexCompiled = checkShaderCompileErrors(vertexShader, "VERTEX");
+    bool fragmentCompiled = checkShaderCompileErrors(fragmentShader, "FRAGMENT");
+    valid = vertexCompiled && fragmentCompiled && checkProgramLinkErrors(programID);
+
+    // --- Cleanup Temporary Shader Objects ---
+    
+    // The shaders are now linked into the program, so we no longer need them
+    RenderBackend& backend = RenderBackend::get();
+    backend.detachShader(programID, vertexShader);
+    backend.detachShader(programID, fragmentShader);
+    backend.deleteShader(vertexShader);
+    backend.deleteShader(fragmentShader);
+    vertexShader = fragmentShader = 0;
+
+    return valid;
+}
+
+/**
+ * Retrieves the linked program as a driver-specific binary, for caching.
+ *
+ * @param binaryFormat Receives the binary's format.
+ * @param binary       Receives the binary.
+ * @return True if the driver provided a binary.
+ */
+bool Shader::getBinary(GLenum& binaryFormat, std::vector<uint8_t>& binary) const {
+    return valid && RenderBackend::get().getProgramBinary(programID, binaryFormat, binary);
+}
+
+/**
+ * Exchanges programs with another shader, so everything holding a pointer to this one
+ * draws with the other's program from now on.
+ *
+ * @param other The shader to exchange with.
+ */
+void Shader::swap(Shader& other) {
+    std::swap(programID, other.programID);
+    std::swap(vertexShader, other.vertexShader);
+    std::swap(fragmentShader, other.fragmentShader);
+    std::swap(linkFinished, other.linkFinished);
+    std::swap(valid, other.valid);
+}
+
+/**
+ * Compiles one shader stage, without waiting for the result.
+ *
+ * @param type   GL_VERTEX_SHADER or GL_FRAGMENT_SHADER.
+ * @param source The GLSL code of the stage.
+ */
+GLuint Shader::compileStage(GLenum type, const std::string& source) {
+    // Create a new shader object, attach the source code to it and compile it
+    RenderBackend& backend = RenderBackend::get();
+    GLuint shader = backend.createShader(type);
+    backend.compileShader(shader, source);
+    return shader;
 }
 
 /**
@@ -106,36 +207,38 @@ void Shader::setMat4(const std::string& name, const glm::mat4& value) const{
  * 
  * @param shader The OpenGL ID of the shader being checked.
  * @param type   The type of shader ("VERTEX" or "FRAGMENT") for error messages.
+ * @return True if the shader compiled.
  */
-void Shader::checkShaderCompileErrors(GLuint shader, const std::string& type) {
-    GLint success;
+bool Shader::checkShaderCompileErrors(GLuint shader, const std::string& type) {
+    std::string infoLog;  // Receives the compiler's error messages
     
     // Query the shader object to check if it compiled successfully
-    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    bool success = RenderBackend::get().getShaderStatus(shader, infoLog);
 
-    // If compilation failed, retrieve and print the error log
+    // If compilation failed, print the error log
     if (!success) {
-        GLchar infoLog[512];  // Buffer for error messages
-        glGetShaderInfoLog(shader, 512, NULL, infoLog);
         std::cout << "ERROR::SHADER::" << type << "::COMPILATION_FAILED\n" << infoLog << std::endl;
     }
+
+    return success;
 }
 
 /**
  * Checks for shader program linking errors and prints an error message if linking fails.
  * 
  * @param program The OpenGL ID of the shader program being checked.
+ * @return True if the program linked.
  */
-void Shader::checkProgramLinkErrors(GLuint program) {
-    GLint success;
+bool Shader::checkProgramLinkErrors(GLuint program) {
+    std::string infoLog;  // Receives the linker's error messages
 
     // Query the shader program to check if linking was successful
-    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    bool success = RenderBackend::get().getProgramStatus(program, infoLog);
 
-    // If linking failed, retrieve and print the error log
+    // If linking failed, print the error log
     if (!success) {
-        GLchar infoLog[512];  // Buffer for error messages
-        glGetProgramInfoLog(program, 512, NULL, infoLog);
         std::cout << "ERROR::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
     }
+
+    return success;
 }
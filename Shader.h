@@ -10,6 +10,12 @@
 // used to handle shader source code as text
 #include <string>
 
+// Includes the vector container, used for program binaries
+#include <vector>
+
+// Includes fixed-width integer types such as uint8_t
+#include <cstdint>
+
 #include <glm/glm.hpp> // GLM for matrix operations
 #include <glm/gtc/type_ptr.hpp> // GLM for matrix transformations
 
@@ -23,6 +29,11 @@
  * - Linking vertex and fragment shaders into a shader program
  * - Activating the shader program for rendering
  * - Setting uniform variables (such as colors, transformations, etc.)
+ *
+ * Linking can be left to finish in the background: with `waitForLink` set to
+ * false the constructor only submits the work, and the driver may compile on
+ * its own threads (GL_KHR_parallel_shader_compile). `isLinkComplete` polls
+ * without blocking and `finishLink` collects the result.
  */
 class Shader {
 public:
@@ -32,8 +43,18 @@ public:
      * 
      * @param vertexSource   A string containing the GLSL code for the vertex shader.
      * @param fragmentSource A string containing the GLSL code for the fragment shader.
+     * @param waitForLink    If false, return as soon as the work is submitted; call `finishLink` later.
+     */
+    Shader(const std::string& vertexSource, const std::string& fragmentSource, bool waitForLink = true);
+
+    /**
+     * Constructor: Loads a program from a binary saved by `getBinary`.
+     * Binaries from another driver or GPU are rejected quietly; check `isValid`.
+     *
+     * @param binaryFormat The driver-specific format the binary was saved in.
+     * @param binary       The program binary.
      */
-    Shader(const std::string& vertexSource, const std::string& fragmentSource);
+    Shader(GLenum binaryFormat, const std::vector<uint8_t>& binary);
 
     /**
      * Destructor: Cleans up the shader program when the object is destroyed.
@@ -53,28 +74,81 @@ public:
      * @param value The float value to be assigned to the uniform variable.
      */
     void setFloat(const std::string& name, float value) const;
+    void setInt(const std::string& name, int value) const;
+    void setVec3(const std::string& name, const glm::vec3& value) const;
     void setMat4(const std::string& name, const glm::mat4& value) const;
 
+    /**
+     * Returns true once the driver has finished compiling and linking, without blocking.
+     * Always true when the driver doesn't support parallel compilation.
+     */
+    bool isLinkComplete() const;
+
+    /**
+     * Waits for linking to finish, reports any compile or link errors and releases
+     * the shader objects. Safe to call more than once.
+     *
+     * @return True if the program is ready to use.
+     */
+    bool finishLink();
+
+    /** Returns true if the program compiled and linked (only meaningful after `finishLink`) */
+    bool isValid() const { return valid; }
+
+    /**
+     * Retrieves the linked program as a driver-specific binary, for caching.
+     *
+     * @param binaryFormat Receives the binary's format.
+     * @param binary       Receives the binary.
+     * @return True if the driver provided a binary.
+     */
+    bool getBinary(GLenum& binaryFormat, std::vector<uint8_t>& binary) const;
+
+    /** Returns the OpenGL ID of the program */
+    GLuint getProgramID() const { return programID; }
+
+    /**
+     * Exchanges programs with another shader, so everything holding a pointer to
+     * this one draws with the other's program from now on. Used for hot reload.
+     * Uniforms belong to the program, so they must be set again after a swap.
+     *
+     * @param other The shader to exchange with.
+     */
+    void swap(Shader& other);
+
 private:
     /** The OpenGL ID of the compiled and linked shader program */
     GLuint programID;
 
+    /** The shader objects, kept until `finishLink` so their logs can be read */
+    GLuint vertexShader, fragmentShader;
+
+    /** True once `finishLink` has run, and whether the program linked */
+    bool linkFinished, valid;
+
+    /**
+     * Compiles one shader stage, without waiting for the result.
+     */
+    static GLuint compileStage(GLenum type, const std::string& source);
+
     /**
      * Checks for compilation errors in a shader.
      * If there are errors, it prints debug information to help fix them.
      * 
      * @param shader The OpenGL ID of the shader being checked.
      * @param type   The type of shader ("VERTEX" or "FRAGMENT") for error messages.
+     * @return True if the shader compiled.
      */
-    void checkShaderCompileErrors(GLuint shader, const std::string& type);
+    bool checkShaderCompileErrors(GLuint shader, const std::string& type);
 
     /**
      * Checks for linking errors in the shader program.
      * If there are errors, it prints debug information to help fix them.
      * 
      * @param program The OpenGL ID of the shader program being checked.
+     * @return True if the program linked.
      */
-    void checkProgramLinkErrors(GLuint program);
+    bool checkProgramLinkErrors(GLuint program);
 };
 
 #endif  // Ends the conditional inclusion directive
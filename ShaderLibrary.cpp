@@ -0,0 +1,425 @@
+// Includes the corresponding header file to access the ShaderLibrary class declaration
+#include "ShaderLibrary.h"
+
+// Includes std::find
+#include <algorithm>
+
+// Includes std::snprintf, used to format cache file names
+#include <cstdio>
+
+// Includes std::filesystem::create_directories and rename, used for the binary cache
+#include <filesystem>
+
+// Includes file streams, used to read shader sources
+#include <fstream>
+
+// Includes standard I/O for printing error messages to the console
+#include <iostream>
+
+// Includes std::random_device, which names each binary's temporary file
+#include <random>
+
+// Includes string streams, used to read whole files
+#include <sstream>
+
+// Includes the File class, used to read and write cached binaries
+#include "File.h"
+
+// Includes the render backend, asked whether program binaries are supported
+#include "RenderBackend.h"
+
+/** The define each feature bit turns on, in bit order */
+static const char* const FEATURE_DEFINES[SHADER_FEATURE_COUNT] = {
+    "FEATURE_AO",
+    "FEATURE_LIGHTING",
+    "FEATURE_FOG",
+    "FEATURE_TRANSPARENCY"
+};
+
+/**
+ * Constructor: Creates a library reading sources from a directory.
+ *
+ * @param directory The directory holding the .vert, .frag and included files.
+ */
+ShaderLibrary::ShaderLibrary(const std::string& directory)
+    : directory(directory), parallelCompile(false), binaryCacheHits(0) {
+    // Ask for as many compiler threads as the driver is willing to use
+    if (GLEW_KHR_parallel_shader_compile) {
+        glMaxShaderCompilerThreadsKHR(0xffffffff);
+        parallelCompile = true;
+    } else if (GLEW_ARB_parallel_shader_compile) {
+        glMaxShaderCompilerThreadsARB(0xffffffff);
+        parallelCompile = true;
+    }
+}
+
+/**
+ * Sets a directory where linked program binaries are cached between runs.
+ */
+void ShaderLibrary::setBinaryCacheDirectory(const std::string& directory) {
+    binaryCacheDirectory = directory;
+    if (!directory.empty()) {
+        std::error_code error;
+        std::filesystem::create_directories(directory, error);
+    }
+}
+
+/**
+ * Starts compiling a permutation unless it is cached or already compiling.
+ *
+ * @param program  The program name (the shared base name of the .vert and .frag files).
+ * @param features A combination of `ShaderFeature` bits.
+ */
+void ShaderLibrary::request(const std::string& program, uint32_t features) {
+    Key key(program, features);
+    if (programs.count(key) > 0) {
+        return;
+    }
+
+    std::string vertexSource, fragmentSource;
+    std::vector<std::string> sourceFiles;
+    if (!preprocess(program + ".vert", features, vertexSource, &sourceFiles) ||
+        !preprocess(program + ".frag", features, fragmentSource, &sourceFiles)) {
+        return;
+    }
+    dependencies[key] = sourceFiles;
+
+    // --- Binary cache ---
+    std::string cachePath;
+    if (!binaryCacheDirectory.empty() && RenderBackend::get().supportsProgramBinary()) {
+        cachePath = binaryPath(vertexSource, fragmentSource);
+
+        File file;
+        uint32_t format = 0;
+        if (file.open(cachePath, false) && file.size() > sizeof(format) && file.readAt(&format, sizeof(format), 0)) {
+            std::vector<uint8_t> binary(size_t(file.size() - sizeof(format)));
+            if (file.readAt(binary.data(), binary.size(), sizeof(format))) {
+                std::unique_ptr<Shader> cached(new Shader(GLenum(format), binary));
+                if (cached->isValid()) {
+                    programs[key] = std::move(cached);
+                    ++binaryCacheHits;
+                    return;
+                }
+            }
+        }
+    }
+
+    // --- Compile, without waiting for the driver ---
+    programs[key].reset(new Shader(vertexSource, fragmentSource, false));
+    pending.emplace_back(key, cachePath);
+}
+
+/**
+ * Waits for every requested permutation and reports errors.
+ *
+ * @return The number of permutations that failed to compile.
+ */
+size_t ShaderLibrary::finishRequests() {
+    size_t failed = 0;
+
+    for (const auto& request : pending) {
+        auto found = programs.find(request.first);
+        if (found == programs.end()) {
+            continue;
+        }
+
+        if (!found->second->finishLink()) {
+            std::cout << "ERROR::SHADER_LIBRARY::PERMUTATION_FAILED " << request.first.first
+                      << " features " << request.first.second << std::endl;
+            programs.erase(found);
+            ++failed;
+            continue;
+        }
+
+        if (!request.second.empty()) {
+            saveBinary(*found->second, request.second);
+        }
+    }
+
+    pending.clear();
+    return failed;
+}
+
+/**
+ * Returns a permutation, compiling it first if needed (blocking).
+ *
+ * @param program  The program name.
+ * @param features A combination of `ShaderFeature` bits.
+ * @return The shader, or nullptr if it failed to compile.
+ */
+Shader* ShaderLibrary::get(const std::string& program, uint32_t features) {
+    request(program, features);
+    if (!pending.empty()) {
+        finishRequests();
+    }
+
+    auto found = programs.find(Key(program, features));
+    return found != programs.end() ? found->second.get() : nullptr;
+}
+
+/**
+ * Builds the full source of one stage: includes expanded and feature defines inserted.
+ *
+ * @param file     The stage's file name, relative to the library directory.
+ * @param features A combination of `ShaderFeature` bits.
+ * @param source   Receives the source.
+ * @param files    If not null, receives every file the source was built from (appended).
+ * @return True if the file and everything it includes could be read.
+ */
+bool ShaderLibrary::preprocess(const std::string& file, uint32_t features, std::string& source,
+                               std::vector<std::string>* files) {
+    std::string expanded;
+    std::vector<std::string> included;
+    if (!expand(file, included, expanded)) {
+        return false;
+    }
+    if (files) {
+        files->insert(files->end(), included.begin(), included.end());
+    }
+
+    std::string defines;
+    for (int bit = 0; bit < int(SHADER_FEATURE_COUNT); ++bit) {
+        if (features & (1u << bit)) {
+            defines += std::string("#define ") + FEATURE_DEFINES[bit] + " 1\n";
+        }
+    }
+
+    // GLSL requires #version to come first, so the defines go right after it
+    size_t insertAt = 0;
+    if (expanded.compare(0, 8, "#version") == 0) {
+        insertAt = expanded.find('\n');
+        insertAt = insertAt == std::string::npos ? expanded.size() : insertAt + 1;
+        defines += "#line 2 0\n";
+    }
+
+    source = expanded.substr(0, insertAt) + defines + expanded.substr(insertAt);
+    return true;
+}
+
+/**
+ * Reads a file relative to the library directory, through the file cache.
+ */
+const std::string* ShaderLibrary::readFile(const std::string& file) {
+    auto found = files.find(file);
+    if (found != files.end()) {
+        return &found->second;
+    }
+
+    std::ifstream stream(directory + "/" + file, std::ios::binary);
+    if (!stream) {
+        std::cout << "ERROR::SHADER_LIBRARY::FILE_NOT_FOUND " << directory << "/" << file << std::endl;
+        return nullptr;
+    }
+
+    std::stringstream contents;
+    contents << stream.rdbuf();
+    return &(files[file] = contents.str());
+}
+
+/**
+ * Appends a file to `source`, expanding its includes.
+ */
+bool ShaderLibrary::expand(const std::string& file, std::vector<std::string>& included, std::string& source) {
+    // Each file is included once per stage, so headers need no include guards
+    if (std::find(included.begin(), included.end(), file) != included.end()) {
+        return true;
+    }
+
+    const std::string* contents = readFile(file);
+    if (!contents) {
+        return false;
+    }
+
+    // Files are numbered in inclusion order; #line makes compile errors point at "<number>(<line>)"
+    size_t fileNumber = included.size();
+    included.push_back(file);
+
+    std::istringstream lines(*contents);
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(lines, line)) {
+        ++lineNumber;
+
+        size_t start = line.find_first_not_of(" \t");
+        if (start == std::string::npos || line.compare(start, 8, "#include") != 0) {
+            source += line;
+            source += '\n';
+            continue;
+        }
+
+        size_t open = line.find('"', start);
+        size_t close = open == std::string::npos ? open : line.find('"', open + 1);
+        if (close == std::string::npos) {
+            std::cout << "ERROR::SHADER_LIBRARY::BAD_INCLUDE " << file << ":" << lineNumber << std::endl;
+            return false;
+        }
+
+        std::string target = line.substr(open + 1, close - open - 1);
+        source += "#line 1 " + std::to_string(included.size()) + "\n";
+        if (!expand(target, included, source)) {
+            return false;
+        }
+        source += "#line " + std::to_string(lineNumber + 1) + " " + std::to_string(fileNumber) + "\n";
+    }
+
+    return true;
+}
+
+/**
+ * Returns the path of a permutation's cached binary.
+ */
+std::string ShaderLibrary::binaryPath(const std::string& vertexSource, const std::string& fragmentSource) const {
+    // Binaries only work on the driver that produced them, so it is part of the name
+    std::string identity = vertexSource + '\0' + fragmentSource + '\0' +
+                           reinterpret_cast<const char*>(glGetString(GL_RENDERER)) + '\0' +
+                           reinterpret_cast<const char*>(glGetString(GL_VERSION));
+
+    // FNV-1a
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (unsigned char c : identity) {
+        hash = (hash ^ c) * 0x100000001b3ull;
+    }
+
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(hash));
+    return binaryCacheDirectory + "/" + name;
+}
+
+/**
+ * Saves a linked permutation to the binary cache.
+ */
+void ShaderLibrary::saveBinary(const Shader& shader, const std::string& path) const {
+    GLenum format = 0;
+    std::vector<uint8_t> binary;
+    if (!shader.getBinary(format, binary)) {
+        return;
+    }
+
+    // Written under a name of its own and renamed into place, so neither a crash nor another
+    // instance saving the same permutation leaves a torn binary behind. A failed write only
+    // costs a recompile next time, so it isn't reported (nor synced: the same goes for a power cut)
+    std::random_device random;
+    char suffix[24];
+    std::snprintf(suffix, sizeof(suffix), ".%08x.tmp", static_cast<unsigned int>(random()));
+    std::string tempPath = path + suffix;
+
+    bool written;
+    {
+        File file;
+        uint32_t storedFormat = uint32_t(format);
+        written = file.open(tempPath, true, true) &&
+                  file.writeAt(&storedFormat, sizeof(storedFormat), 0) &&
+                  file.writeAt(binary.data(), binary.size(), sizeof(storedFormat));
+    }
+
+    std::error_code error;
+    if (written) {
+        std::filesystem::rename(tempPath, path, error);
+    }
+    if (!written || error) {
+        std::filesystem::remove(tempPath, error);
+    }
+}
+
+/**
+ * Starts watching the library directory for edits, which `update` then reloads.
+ *
+ * @return True if the directory could be watched.
+ */
+bool ShaderLibrary::enableHotReload() {
+    if (!watcher) {
+        watcher.reset(new ShaderWatcher(directory));
+    }
+    return watcher->isWatching();
+}
+
+/**
+ * Reloads edited shaders: starts recompiling permutations whose files changed and
+ * swaps in those that have finished.
+ *
+ * @return The number of permutations swapped in this call.
+ */
+size_t ShaderLibrary::update() {
+    std::vector<std::string> changed;
+    if (watcher && watcher->poll(changed)) {
+        startReloads(changed);
+    }
+
+    size_t swapped = 0;
+    for (auto it = reloads.begin(); it != reloads.end();) {
+        Shader& replacement = *it->second.first;
+
+        // Leave programs the driver is still compiling for a later frame
+        if (!replacement.isLinkComplete()) {
+            ++it;
+            continue;
+        }
+
+        const Key& key = it->first;
+        if (!replacement.finishLink()) {
+            // finishLink has printed the compiler's errors; the old program stays in use
+            std::cout << "ERROR::SHADER_LIBRARY::RELOAD_FAILED " << key.first << " features " << key.second
+                      << ", keeping the previous program" << std::endl;
+            it = reloads.erase(it);
+            continue;
+        }
+
+        // Swap in place so pointers handed out by `get` stay valid; the old program
+        // is deleted along with the replacement object
+        auto found = programs.find(key);
+        if (found != programs.end()) {
+            found->second->swap(replacement);
+        } else {
+            programs[key] = std::move(it->second.first);
+        }
+
+        if (!it->second.second.empty()) {
+            saveBinary(*programs[key], it->second.second);
+        }
+
+        std::cout << "SHADER_LIBRARY::RELOADED " << key.first << " features " << key.second << std::endl;
+        ++swapped;
+        it = reloads.erase(it);
+    }
+
+    return swapped;
+}
+
+/**
+ * Starts recompiling every permutation built from one of the given files.
+ */
+void ShaderLibrary::startReloads(const std::vector<std::string>& changed) {
+    for (const std::string& file : changed) {
+        files.erase(file);
+    }
+
+    for (const auto& entry : dependencies) {
+        const std::vector<std::string>& used = entry.second;
+        bool affected = false;
+        for (const std::string& file : changed) {
+            affected = affected || std::find(used.begin(), used.end(), file) != used.end();
+        }
+        if (!affected) {
+            continue;
+        }
+
+        const Key& key = entry.first;
+        std::string vertexSource, fragmentSource;
+        std::vector<std::string> sourceFiles;
+        if (!preprocess(key.first + ".vert", key.second, vertexSource, &sourceFiles) ||
+            !preprocess(key.first + ".frag", key.second, fragmentSource, &sourceFiles)) {
+            continue;  // Already reported; the old program stays in use
+        }
+
+        // The edit may have added or removed includes
+        dependencies[key] = sourceFiles;
+
+        std::string cachePath;
+        if (!binaryCacheDirectory.empty() && RenderBackend::get().supportsProgramBinary()) {
+            cachePath = binaryPath(vertexSource, fragmentSource);
+        }
+
+        // Replaces any reload of the same permutation still compiling from an older edit
+        reloads[key] = std::make_pair(std::unique_ptr<Shader>(new Shader(vertexSource, fragmentSource, false)), cachePath);
+    }
+}
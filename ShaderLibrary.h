@@ -0,0 +1,197 @@
+// Prevents multiple inclusions of this header file, which can cause redefinition errors
+#ifndef SHADER_LIBRARY_H
+#define SHADER_LIBRARY_H
+
+// Includes fixed-width integer types such as uint32_t
+#include <cstdint>
+
+// Includes the ordered map used for the permutation cache
+#include <map>
+
+// Includes std::unique_ptr, which owns each compiled permutation
+#include <memory>
+
+// Includes the C++ Standard Library string class, used for names and sources
+#include <string>
+
+// Includes the hash map used to cache file contents
+#include <unordered_map>
+
+// Includes the vector container, used for the list of pending compiles
+#include <vector>
+
+#include "Shader.h"        // The compiled programs
+#include "ShaderWatcher.h" // File change notifications for hot reload
+
+/** Optional shader features; each one adds a `#define FEATURE_<NAME>` to the source */
+enum ShaderFeature : uint32_t {
+    SHADER_FEATURE_AO = 1 << 0,
+    SHADER_FEATURE_LIGHTING = 1 << 1,
+    SHADER_FEATURE_FOG = 1 << 2,
+    SHADER_FEATURE_TRANSPARENCY = 1 << 3,
+
+    /** The number of feature bits, and so the number of permutations is 2^SHADER_FEATURE_COUNT */
+    SHADER_FEATURE_COUNT = 4
+};
+
+/**
+ * The `ShaderLibrary` class loads GLSL programs from a directory and compiles
+ * feature permutations of them on demand.
+ *
+ * A program called "chunk" is made of `chunk.vert` and `chunk.frag`. Sources may
+ * use `#include "file"` (relative to the library directory; each file is
+ * included at most once per stage), and are compiled once per combination of
+ * `ShaderFeature` bits, with the matching defines inserted after `#version`.
+ *
+ * `request` only submits the compile, so requesting every permutation up front
+ * lets the driver compile them in parallel (GL_KHR_parallel_shader_compile);
+ * `finishRequests` then collects the results. With a binary cache directory set,
+ * linked programs are also saved to disk and reloaded on the next start
+ * without compiling.
+ *
+ * With hot reload on, `update` (called once per frame, between frames) notices
+ * edited files, recompiles every permutation that uses them in the background
+ * and swaps each one in once it links. A permutation that fails to compile
+ * keeps running its previous program, so a typo never takes the renderer down.
+ */
+class ShaderLibrary {
+public:
+    /**
+     * Constructor: Creates a library reading sources from a directory.
+     * Needs a current OpenGL context.
+     *
+     * @param directory The directory holding the .vert, .frag and included files.
+     */
+    ShaderLibrary(const std::string& directory);
+
+    /**
+     * Sets a directory where linked program binaries are cached between runs.
+     * An empty path turns the cache off.
+     */
+    void setBinaryCacheDirectory(const std::string& directory);
+
+    /**
+     * Starts compiling a permutation unless it is cached or already compiling. Doesn't block.
+     *
+     * @param program  The program name (the shared base name of the .vert and .frag files).
+     * @param features A combination of `ShaderFeature` bits.
+     */
+    void request(const std::string& program, uint32_t features);
+
+    /**
+     * Waits for every requested permutation and reports errors.
+     *
+     * @return The number of permutations that failed to compile.
+     */
+    size_t finishRequests();
+
+    /**
+     * Returns a permutation, compiling it first if needed (blocking).
+     *
+     * @param program  The program name.
+     * @param features A combination of `ShaderFeature` bits.
+     * @return The shader, or nullptr if it failed to compile.
+     */
+    Shader* get(const std::string& program, uint32_t features);
+
+    /**
+     * Builds the full source of one stage: includes expanded and feature defines inserted.
+     *
+     * @param file     The stage's file name, relative to the library directory.
+     * @param features A combination of `ShaderFeature` bits.
+     * @param source   Receives the source.
+     * @param files    If not null, receives every file the source was built from (appended).
+     * @return True if the file and everything it includes could be read.
+     */
+    bool preprocess(const std::string& file, uint32_t features, std::string& source,
+                    std::vector<std::string>* files = nullptr);
+
+    /**
+     * Starts watching the library directory for edits, which `update` then reloads.
+     *
+     * @return True if the directory could be watched.
+     */
+    bool enableHotReload();
+
+    /**
+     * Reloads edited shaders. Call once per frame, outside of drawing: it starts
+     * recompiling permutations whose files changed and swaps in those that have
+     * finished, without waiting for the rest.
+     *
+     * @return The number of permutations swapped in this call.
+     */
+    size_t update();
+
+    /** Forgets cached file contents, so the next compile reads the files again */
+    void clearSourceCache() { files.clear(); }
+
+    /** Returns true if the driver compiles shaders on background threads */
+    bool isParallelCompileAvailable() const { return parallelCompile; }
+
+    /** Returns the number of cached permutations */
+    size_t getCachedCount() const { return programs.size(); }
+
+    /** Returns the number of permutations loaded from the binary cache instead of compiled */
+    size_t getBinaryCacheHits() const { return binaryCacheHits; }
+
+private:
+    /** Identifies a permutation: program name and feature bits */
+    using Key = std::pair<std::string, uint32_t>;
+
+    /**
+     * Reads a file relative to the library directory, through the file cache.
+     */
+    const std::string* readFile(const std::string& file);
+
+    /**
+     * Appends a file to `source`, expanding its includes.
+     */
+    bool expand(const std::string& file, std::vector<std::string>& included, std::string& source);
+
+    /**
+     * Returns the path of a permutation's cached binary.
+     */
+    std::string binaryPath(const std::string& vertexSource, const std::string& fragmentSource) const;
+
+    /**
+     * Saves a linked permutation to the binary cache.
+     */
+    void saveBinary(const Shader& shader, const std::string& path) const;
+
+    /**
+     * Starts recompiling every permutation built from one of the given files.
+     */
+    void startReloads(const std::vector<std::string>& changed);
+
+    /** The directory holding the shader sources */
+    std::string directory;
+
+    /** The directory holding cached program binaries, or empty */
+    std::string binaryCacheDirectory;
+
+    /** File contents, keyed by path relative to the library directory */
+    std::unordered_map<std::string, std::string> files;
+
+    /** Every compiled (or compiling) permutation */
+    std::map<Key, std::unique_ptr<Shader>> programs;
+
+    /** Requested permutations that haven't been finished, with the binary cache path to save them to */
+    std::vector<std::pair<Key, std::string>> pending;
+
+    /** The files each requested permutation is built from, kept even if it failed so an edit can fix it */
+    std::map<Key, std::vector<std::string>> dependencies;
+
+    /** Replacement programs still compiling, with the binary cache path to save them to */
+    std::map<Key, std::pair<std::unique_ptr<Shader>, std::string>> reloads;
+
+    /** Watches the directory while hot reload is on */
+    std::unique_ptr<ShaderWatcher> watcher;
+
+    /** True if the driver compiles shaders on background threads */
+    bool parallelCompile;
+
+    /** The number of permutations loaded from the binary cache */
+    size_t binaryCacheHits;
+};
+
+#endif  // Ends the conditional inclusion directive
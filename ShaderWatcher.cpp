@@ -0,0 +1,147 @@
+// Includes the corresponding header file to access the ShaderWatcher class declaration
+#include "ShaderWatcher.h"
+
+// Includes std::find, used to report each file once per poll
+#include <algorithm>
+
+// Includes standard I/O for printing error messages to the console
+#include <iostream>
+
+// Linux file change notifications
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Adds a path to a list unless it is already there.
+ */
+static void addChanged(std::vector<std::string>& changed, const std::string& path) {
+    if (std::find(changed.begin(), changed.end(), path) == changed.end()) {
+        changed.push_back(path);
+    }
+}
+
+/**
+ * Constructor: Starts watching a directory.
+ *
+ * @param directory The shader directory.
+ */
+ShaderWatcher::ShaderWatcher(const std::string& directory) : directory(directory), watching(false) {
+    std::error_code error;
+    if (!std::filesystem::is_directory(directory, error)) {
+        std::cout << "ERROR::SHADER_WATCHER::NOT_A_DIRECTORY " << directory << std::endl;
+#ifdef __linux__
+        inotify = -1;
+#endif
+        return;
+    }
+
+#ifdef __linux__
+    inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify < 0) {
+        std::cout << "ERROR::SHADER_WATCHER::INOTIFY_INIT_FAILED" << std::endl;
+        return;
+    }
+
+    // inotify isn't recursive, so every subdirectory (such as include/) gets its own watch.
+    // Renames are watched too: many editors save by renaming a temporary file over the original.
+    const uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO;
+    int root = inotify_add_watch(inotify, directory.c_str(), mask);
+    if (root < 0) {
+        std::cout << "ERROR::SHADER_WATCHER::WATCH_FAILED " << directory << std::endl;
+        return;
+    }
+    watches[root] = "";
+
+    for (std::filesystem::recursive_directory_iterator it(directory, error), end; !error && it != end; it.increment(error)) {
+        if (!it->is_directory(error)) {
+            continue;
+        }
+
+        int watch = inotify_add_watch(inotify, it->path().string().c_str(), mask);
+        if (watch >= 0) {
+            watches[watch] = std::filesystem::relative(it->path(), directory, error).generic_string() + "/";
+        }
+    }
+#else
+    scan(nullptr);
+#endif
+
+    watching = true;
+}
+
+/**
+ * Destructor: Stops watching.
+ */
+ShaderWatcher::~ShaderWatcher() {
+#ifdef __linux__
+    // Closing the descriptor removes every watch
+    if (inotify >= 0) {
+        close(inotify);
+    }
+#endif
+}
+
+/**
+ * Collects the files that changed since the last call. Doesn't block.
+ *
+ * @param changed Receives the paths of changed files, relative to the directory.
+ * @return True if anything changed.
+ */
+bool ShaderWatcher::poll(std::vector<std::string>& changed) {
+    if (!watching) {
+        return false;
+    }
+
+    size_t before = changed.size();
+
+#ifdef __linux__
+    // Events are variable-length, so the buffer is aligned for the struct
+    alignas(inotify_event) char buffer[4096];
+    for (;;) {
+        ssize_t length = read(inotify, buffer, sizeof(buffer));
+        if (length <= 0) {
+            break;  // EAGAIN: no more events
+        }
+
+        for (ssize_t offset = 0; offset < length;) {
+            const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            offset += ssize_t(sizeof(inotify_event) + event->len);
+
+            auto found = watches.find(event->wd);
+            if (found != watches.end() && event->len > 0 && !(event->mask & IN_ISDIR)) {
+                addChanged(changed, found->second + event->name);
+            }
+        }
+    }
+#else
+    scan(&changed);
+#endif
+
+    return changed.size() > before;
+}
+
+#ifndef __linux__
+/**
+ * Scans the directory, recording modification times and optionally reporting changes.
+ */
+void ShaderWatcher::scan(std::vector<std::string>* changed) {
+    std::error_code error;
+    for (std::filesystem::recursive_directory_iterator it(directory, error), end; !error && it != end; it.increment(error)) {
+        if (!it->is_regular_file(error)) {
+            continue;
+        }
+
+        std::string path = std::filesystem::relative(it->path(), directory, error).generic_string();
+        std::filesystem::file_time_type time = it->last_write_time(error);
+        auto found = times.find(path);
+        if (found == times.end() || found->second != time) {
+            times[path] = time;
+            if (changed) {
+                addChanged(*changed, path);
+            }
+        }
+    }
+}
+#endif
@@ -0,0 +1,83 @@
+// Prevents multiple inclusions of this header file, which can cause redefinition errors
+#ifndef SHADER_WATCHER_H
+#define SHADER_WATCHER_H
+
+// Includes the ordered map used to track watched directories and file times
+#include <map>
+
+// Includes the C++ Standard Library string class, used for paths
+#include <string>
+
+// Includes the vector container, used to return changed files
+#include <vector>
+
+// Includes std::filesystem::file_time_type, used by the portable fallback
+#include <filesystem>
+
+/**
+ * The `ShaderWatcher` class reports which files in a shader directory changed
+ * since the last poll.
+ *
+ * On Linux it uses inotify on the directory and every subdirectory present at
+ * construction, so polling is a single non-blocking read. Elsewhere it falls
+ * back to comparing modification times, which is fine for the handful of
+ * files a shader directory holds.
+ *
+ * Editors save either in place or by writing a temporary file and renaming it
+ * over the original; both show up as a change to the original name.
+ */
+class ShaderWatcher {
+public:
+    /**
+     * Constructor: Starts watching a directory.
+     *
+     * @param directory The shader directory.
+     */
+    ShaderWatcher(const std::string& directory);
+
+    /**
+     * Destructor: Stops watching.
+     */
+    ~ShaderWatcher();
+
+    // The watcher owns an OS handle, so it can't be copied
+    ShaderWatcher(const ShaderWatcher&) = delete;
+    ShaderWatcher& operator=(const ShaderWatcher&) = delete;
+
+    /**
+     * Collects the files that changed since the last call. Doesn't block.
+     *
+     * @param changed Receives the paths of changed files, relative to the directory
+     *                and with '/' separators (as written in `#include`). Not cleared first.
+     * @return True if anything changed.
+     */
+    bool poll(std::vector<std::string>& changed);
+
+    /** Returns true if the directory is being watched */
+    bool isWatching() const { return watching; }
+
+private:
+    /** The watched directory */
+    std::string directory;
+
+    /** True if the directory is being watched */
+    bool watching;
+
+#ifdef __linux__
+    /** The inotify descriptor */
+    int inotify;
+
+    /** The relative path (with trailing '/', or empty for the root) of each watch descriptor */
+    std::map<int, std::string> watches;
+#else
+    /** The last seen modification time of each file, by relative path */
+    std::map<std::string, std::filesystem::file_time_type> times;
+
+    /**
+     * Scans the directory, recording modification times and optionally reporting changes.
+     */
+    void scan(std::vector<std::string>* changed);
+#endif
+};
+
+#endif  // Ends the conditional inclusion directive
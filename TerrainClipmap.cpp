@@ -0,0 +1,301 @@
+// Includes the corresponding header file to access the TerrainClipmap class declaration
+#include "TerrainClipmap.h"
+
+// Includes std::min
+#include <algorithm>
+
+// Includes the clock used to time updates
+#include <chrono>
+
+// Includes std::floor
+#include <cmath>
+
+// Includes std::abs for 64-bit integers
+#include <cstdlib>
+
+// Includes the GL state cache, which binds the level textures
+#include "GLStateCache.h"
+
+// Includes the render backend, which creates and fills the level textures
+#include "RenderBackend.h"
+
+/**
+ * Returns `value` divided by a positive `divisor`, rounded down.
+ */
+static int64_t floorDivide(int64_t value, int64_t divisor) {
+    int64_t quotient = value / divisor;
+    return (value % divisor != 0 && value < 0) ? quotient - 1 : quotient;
+}
+
+/**
+ * Returns `value` modulo a positive `divisor`, between 0 and `divisor` - 1.
+ */
+static int floorModulo(int64_t value, int64_t divisor) {
+    return int(value - floorDivide(value, divisor) * divisor);
+}
+
+/**
+ * Appends the two triangles of a grid cell, wound counter-clockwise seen from above.
+ */
+static void appendCell(std::vector<unsigned int>& indices, int x, int z, int samples) {
+    unsigned int corner = unsigned(z * samples + x);
+    unsigned int right = corner + 1;
+    unsigned int below = corner + unsigned(samples);
+    indices.insert(indices.end(), {corner, below, below + 1, corner, below + 1, right});
+}
+
+/**
+ * Constructor: Creates the level textures and the grid mesh.
+ *
+ * @param heights     The height source.
+ * @param levelCount  The number of levels.
+ * @param gridSize    The cells per level edge; a multiple of 4.
+ * @param baseSpacing The blocks between samples of the finest level.
+ */
+TerrainClipmap::TerrainClipmap(HeightFunction heights, int levelCount, int gridSize, int baseSpacing)
+    : heights(heights), gridSize(gridSize), textureSize(gridSize + 1), fullIndexCount(0), ringIndexCount(0),
+      voxelDistance(0.0f), blendWidth(0.0f), lastUpdate() {
+    RenderBackend& backend = RenderBackend::get();
+    for (int i = 0; i < levelCount; ++i) {
+        Level level;
+        level.spacing = baseSpacing << i;
+        level.originX = 0;
+        level.originZ = 0;
+        level.valid = false;
+        level.active = true;
+
+        // One float per sample; the shader reads exact texels, so no filtering or mipmaps
+        level.texture = backend.createTexture();
+        GLStateCache::bindTexture(0, GL_TEXTURE_2D, level.texture);
+        backend.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        backend.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        backend.texImage2D(GL_TEXTURE_2D, GL_R32F, textureSize, textureSize, GL_RED, GL_FLOAT, nullptr);
+        levels.push_back(level);
+    }
+
+    // Vertices are the sample coordinates; the shader scales and places them per level
+    std::vector<float> vertices;
+    vertices.reserve(size_t(textureSize) * textureSize * 3);
+    for (int z = 0; z < textureSize; ++z) {
+        for (int x = 0; x < textureSize; ++x) {
+            vertices.insert(vertices.end(), {float(x), 0.0f, float(z)});
+        }
+    }
+
+    // Every cell first (the finest level has no level inside it), then a ring per place
+    // the finer level's square can sit: `gridSize` / 4 or one more cell in on each axis
+    std::vector<unsigned int> indices;
+    for (int z = 0; z < gridSize; ++z) {
+        for (int x = 0; x < gridSize; ++x) {
+            appendCell(indices, x, z, textureSize);
+        }
+    }
+    fullIndexCount = unsigned(indices.size());
+
+    int holeSize = gridSize / 2;
+    for (int variant = 0; variant < 4; ++variant) {
+        int holeX = gridSize / 4 + (variant & 1);
+        int holeZ = gridSize / 4 + (variant >> 1);
+        for (int z = 0; z < gridSize; ++z) {
+            for (int x = 0; x < gridSize; ++x) {
+                bool inHole = x >= holeX && x < holeX + holeSize && z >= holeZ && z < holeZ + holeSize;
+                if (!inHole) {
+                    appendCell(indices, x, z, textureSize);
+                }
+            }
+        }
+    }
+    ringIndexCount = unsigned(gridSize * gridSize - holeSize * holeSize) * 6;
+
+    grid = std::make_unique<Mesh>(vertices, indices);
+}
+
+/**
+ * Destructor: Deletes the level textures.
+ */
+TerrainClipmap::~TerrainClipmap() {
+    for (Level& level : levels) {
+        GLStateCache::deleteTexture(level.texture);
+    }
+}
+
+/**
+ * Sets where the voxel chunks end.
+ *
+ * @param distance   The distance from the camera (along x or z) the chunks reach.
+ * @param blendWidth The width of the band inside it where the height field fades in.
+ */
+void TerrainClipmap::setVoxelDistance(float distance, float blendWidth) {
+    voxelDistance = distance;
+    this->blendWidth = blendWidth;
+}
+
+/**
+ * Slides the levels to the camera, sampling the heights they newly cover.
+ *
+ * @param camera The camera position.
+ */
+void TerrainClipmap::update(const WorldPosition& camera) {
+    auto start = std::chrono::steady_clock::now();
+    lastUpdate.samples = 0;
+    lastUpdate.uploads = 0;
+
+    int64_t cameraX = camera.chunk.x * CHUNK_SIZE + int64_t(std::floor(camera.local.x));
+    int64_t cameraZ = camera.chunk.z * CHUNK_SIZE + int64_t(std::floor(camera.local.z));
+    for (Level& level : levels) {
+        // Snap to twice the spacing, so this level's samples are also samples of the finer one
+        int64_t step = int64_t(level.spacing) * 2;
+        int64_t originX = floorDivide(cameraX, step) * 2 - gridSize / 2;
+        int64_t originZ = floorDivide(cameraZ, step) * 2 - gridSize / 2;
+        int64_t movedX = originX - level.originX;
+        int64_t movedZ = originZ - level.originZ;
+        level.originX = originX;
+        level.originZ = originZ;
+
+        // A level that fits inside the discarded part of the voxel chunks draws nothing; its
+        // origin is still kept, since the next level leaves out its square
+        float reach = float(gridSize / 2 + 2) * float(level.spacing);
+        level.active = reach > voxelDistance - blendWidth;
+        if (!level.active) {
+            level.valid = false;
+            continue;
+        }
+
+        if (!level.valid || std::abs(movedX) >= textureSize || std::abs(movedZ) >= textureSize) {
+            uploadRegion(level, originX, originZ, textureSize, textureSize);
+            level.valid = true;
+            continue;
+        }
+
+        // Only the columns and rows the window slid onto are new
+        if (movedX > 0) {
+            uploadRegion(level, originX + textureSize - movedX, originZ, int(movedX), textureSize);
+        } else if (movedX < 0) {
+            uploadRegion(level, originX, originZ, int(-movedX), textureSize);
+        }
+        if (movedZ > 0) {
+            uploadRegion(level, originX, originZ + textureSize - movedZ, textureSize, int(movedZ));
+        } else if (movedZ < 0) {
+            uploadRegion(level, originX, originZ, textureSize, int(-movedZ));
+        }
+    }
+
+    lastUpdate.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * Samples a rectangle of a level's window and uploads it, split where it wraps around the texture.
+ *
+ * @param x, z          The rectangle's lowest sample.
+ * @param width, height The rectangle's size in samples, at most `textureSize`.
+ */
+void TerrainClipmap::uploadRegion(Level& level, int64_t x, int64_t z, int width, int height) {
+    GLStateCache::bindTexture(0, GL_TEXTURE_2D, level.texture);
+    RenderBackend& backend = RenderBackend::get();
+
+    // At most two pieces per axis: up to the texture's edge, and the rest from texel 0
+    int texelX = floorModulo(x, textureSize);
+    int texelZ = floorModulo(z, textureSize);
+    int firstWidth = std::min(width, textureSize - texelX);
+    int firstHeight = std::min(height, textureSize - texelZ);
+    int pieceWidths[2] = {firstWidth, width - firstWidth};
+    int pieceHeights[2] = {firstHeight, height - firstHeight};
+    for (int pieceZ = 0; pieceZ < 2; ++pieceZ) {
+        for (int pieceX = 0; pieceX < 2; ++pieceX) {
+            int pieceWidth = pieceWidths[pieceX];
+            int pieceHeight = pieceHeights[pieceZ];
+            if (pieceWidth == 0 || pieceHeight == 0) {
+                continue;
+            }
+
+            int64_t sampleX = x + (pieceX ? firstWidth : 0);
+            int64_t sampleZ = z + (pieceZ ? firstHeight : 0);
+            scratch.resize(size_t(pieceWidth) * pieceHeight);
+            for (int row = 0; row < pieceHeight; ++row) {
+                for (int column = 0; column < pieceWidth; ++column) {
+                    scratch[size_t(row) * pieceWidth + column] =
+                        heights((sampleX + column) * level.spacing, (sampleZ + row) * level.spacing);
+                }
+            }
+
+            // Columns of one row are consecutive floats, so the default 4-byte row alignment holds
+            backend.texSubImage2D(GL_TEXTURE_2D, pieceX ? 0 : texelX, pieceZ ? 0 : texelZ, pieceWidth, pieceHeight,
+                                  GL_RED, GL_FLOAT, scratch.data());
+            lastUpdate.samples += uint64_t(pieceWidth) * pieceHeight;
+            ++lastUpdate.uploads;
+        }
+    }
+}
+
+/**
+ * Draws the levels, finest first.
+ *
+ * @param shader         The "terrain" program.
+ * @param viewProjection The camera's projection * view matrix (camera-relative).
+ * @param camera         The camera position, the same as the last `update`'s.
+ */
+void TerrainClipmap::draw(const Shader& shader, const glm::mat4& viewProjection, const WorldPosition& camera) {
+    shader.use();
+    shader.setMat4("viewProjection", viewProjection);
+    shader.setInt("heights", 0);
+    shader.setFloat("voxelDistance", voxelDistance);
+    shader.setFloat("blendWidth", blendWidth);
+
+    // Vertices blend fully into the coarser level a little before the window's nearest edge
+    // (`gridSize` / 2 - 2 samples from the camera), so float rounding never leaves a crack
+    float morphWidth = float(gridSize) / 8.0f;
+    shader.setFloat("morphStart", float(gridSize / 2 - 3) - morphWidth);
+    shader.setFloat("morphWidth", morphWidth);
+
+    for (size_t i = 0; i < levels.size(); ++i) {
+        const Level& level = levels[i];
+        if (!level.active) {
+            continue;
+        }
+
+        glm::i64vec3 originBlock(level.originX * level.spacing, 0, level.originZ * level.spacing);
+        shader.setVec3("levelOrigin", WorldPosition::fromBlock(originBlock).relativeTo(camera));
+        shader.setFloat("spacing", float(level.spacing));
+        shader.setInt("textureOriginX", floorModulo(level.originX, textureSize));
+        shader.setInt("textureOriginZ", floorModulo(level.originZ, textureSize));
+        GLStateCache::bindTexture(0, GL_TEXTURE_2D, level.texture);
+
+        // The finer level's window sits `gridSize` / 4 or one more of this level's cells in
+        unsigned int firstIndex = 0;
+        unsigned int indexCount = fullIndexCount;
+        if (i > 0) {
+            const Level& finer = levels[i - 1];
+            getRingRange(int(finer.originX / 2 - level.originX), int(finer.originZ / 2 - level.originZ), firstIndex,
+                         indexCount);
+        }
+        grid->drawRanges(&firstIndex, &indexCount, 1);
+    }
+}
+
+/**
+ * Returns the index range of the ring with the finer level's square left out.
+ *
+ * @param holeX, holeZ The square's lowest cell in the level, `gridSize` / 4 or one more.
+ */
+void TerrainClipmap::getRingRange(int holeX, int holeZ, unsigned int& firstIndex, unsigned int& indexCount) const {
+    int variant = (holeX - gridSize / 4) + (holeZ - gridSize / 4) * 2;
+    firstIndex = fullIndexCount + unsigned(variant) * ringIndexCount;
+    indexCount = ringIndexCount;
+}
+
+/**
+ * Returns the distance from the camera the coarsest level reaches, at least.
+ */
+float TerrainClipmap::getHorizonDistance() const {
+    return levels.empty() ? 0.0f : float(gridSize / 2 - 2) * float(levels.back().spacing);
+}
+
+/**
+ * Returns the GPU memory of the level textures and the grid mesh, in bytes.
+ */
+size_t TerrainClipmap::getGpuBytes() const {
+    size_t textures = levels.size() * size_t(textureSize) * textureSize * sizeof(float);
+    size_t vertices = size_t(textureSize) * textureSize * 3 * sizeof(float);
+    size_t indices = (size_t(fullIndexCount) + 4 * size_t(ringIndexCount)) * sizeof(unsigned int);
+    return textures + vertices + indices;
+}
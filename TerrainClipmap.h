@@ -0,0 +1,178 @@
+// Prevents multiple inclusions of this header file, which can cause redefinition errors
+#ifndef TERRAIN_CLIPMAP_H
+#define TERRAIN_CLIPMAP_H
+
+// Includes fixed-width integer types such as int64_t
+#include <cstdint>
+
+// Includes std::function, the type of the height source
+#include <functional>
+
+// Includes std::unique_ptr, which owns the grid mesh
+#include <memory>
+
+// Includes the vector container, used for the levels and upload scratch
+#include <vector>
+
+#include <glm/glm.hpp> // GLM for matrix operations
+
+#include "Mesh.h"          // The shared grid mesh
+#include "Shader.h"        // The program drawn with
+#include "WorldPosition.h" // The camera position, anywhere in the world
+
+/**
+ * The `ClipmapUpdateStats` struct reports the cost of one `TerrainClipmap::update`.
+ */
+struct ClipmapUpdateStats {
+    /** The number of heights sampled (and uploaded) */
+    uint64_t samples;
+
+    /** The number of texture uploads */
+    uint64_t uploads;
+
+    /** The wall-clock time of the update, sampling included */
+    double seconds;
+};
+
+/**
+ * The `TerrainClipmap` class draws the terrain past the voxel chunks, out to
+ * the horizon, as a height field: a geometry clipmap of nested square grids
+ * around the camera, each with twice the sample spacing of the one inside it.
+ * It needs no block data, only the terrain's height at any column, so it
+ * reaches kilometres for the memory of a few chunks.
+ *
+ * Every level has the same number of samples, stored in a float texture that
+ * is addressed toroidally: when the camera moves, a level's window slides and
+ * only the rows and columns it newly covers are sampled and uploaded, while
+ * the rest stay where they are. Levels snap to twice their own spacing, so
+ * every level's samples are also samples of the finer level inside it.
+ *
+ * One grid mesh is shared by all levels and drawn once per level. The vertex
+ * shader reads the heights; a level leaves out the square the finer level
+ * covers (one of four index ranges, by where the finer level sits), and near
+ * its outer edge blends each vertex towards the coarser level's surface, so
+ * neighbouring levels meet without cracks.
+ *
+ * Inside the voxel view distance the chunks draw the ground, so fragments
+ * there are discarded, fading in with a dither across a band at the boundary,
+ * and levels that lie entirely inside it are neither updated nor drawn.
+ */
+class TerrainClipmap {
+public:
+    /** The height source: the terrain's surface height at a block column */
+    typedef std::function<float(int64_t x, int64_t z)> HeightFunction;
+
+    /**
+     * Constructor: Creates the level textures and the grid mesh. Needs a current
+     * OpenGL context. Nothing is sampled until the first `update`.
+     *
+     * @param heights     The height source; called from `update` only.
+     * @param levelCount  The number of levels.
+     * @param gridSize    The cells per level edge; a multiple of 4.
+     * @param baseSpacing The blocks between samples of the finest level.
+     */
+    TerrainClipmap(HeightFunction heights, int levelCount = 8, int gridSize = 128, int baseSpacing = 2);
+
+    /**
+     * Destructor: Deletes the level textures.
+     */
+    ~TerrainClipmap();
+
+    /**
+     * Sets where the voxel chunks end.
+     *
+     * @param distance   The distance from the camera (along x or z) the chunks reach.
+     * @param blendWidth The width of the band inside it where the height field fades in.
+     */
+    void setVoxelDistance(float distance, float blendWidth);
+
+    /**
+     * Slides the levels to the camera, sampling the heights they newly cover.
+     *
+     * @param camera The camera position.
+     */
+    void update(const WorldPosition& camera);
+
+    /**
+     * Draws the levels, finest first.
+     *
+     * @param shader         The "terrain" program.
+     * @param viewProjection The camera's projection * view matrix (camera-relative).
+     * @param camera         The camera position, the same as the last `update`'s.
+     */
+    void draw(const Shader& shader, const glm::mat4& viewProjection, const WorldPosition& camera);
+
+    /** Returns the cost of the last `update` */
+    const ClipmapUpdateStats& getLastUpdate() const { return lastUpdate; }
+
+    /** Returns the distance from the camera the coarsest level reaches, at least */
+    float getHorizonDistance() const;
+
+    /** Returns the GPU memory of the level textures and the grid mesh, in bytes */
+    size_t getGpuBytes() const;
+
+private:
+    /**
+     * The `Level` struct is one ring of the clipmap.
+     */
+    struct Level {
+        /** The blocks between samples */
+        int spacing;
+
+        /** The lowest sample of the window, in samples (block coordinate / spacing) */
+        int64_t originX;
+        int64_t originZ;
+
+        /** False until the window was sampled, and again once the level goes inactive */
+        bool valid;
+
+        /** True if any of the level lies outside the voxel chunks */
+        bool active;
+
+        /** The heights, `textureSize` squared, addressed by sample coordinate modulo `textureSize` */
+        GLuint texture;
+    };
+
+    /**
+     * Samples a rectangle of a level's window and uploads it, split where it wraps
+     * around the texture.
+     *
+     * @param x, z          The rectangle's lowest sample.
+     * @param width, height The rectangle's size in samples, at most `textureSize`.
+     */
+    void uploadRegion(Level& level, int64_t x, int64_t z, int width, int height);
+
+    /**
+     * Returns the index range of the ring with the finer level's square left out.
+     *
+     * @param holeX, holeZ The square's lowest cell in the level, `gridSize` / 4 or one more.
+     */
+    void getRingRange(int holeX, int holeZ, unsigned int& firstIndex, unsigned int& indexCount) const;
+
+    /** The height source */
+    HeightFunction heights;
+
+    /** The cells per level edge, and the samples (`gridSize` + 1) */
+    int gridSize;
+    int textureSize;
+
+    /** The levels, finest first */
+    std::vector<Level> levels;
+
+    /** The grid mesh: one range covering every cell, then the four rings */
+    std::unique_ptr<Mesh> grid;
+    unsigned int fullIndexCount;
+    unsigned int ringIndexCount;
+
+    /** Where the voxel chunks end, and the band where the height field fades in */
+    float voxelDistance;
+    float blendWidth;
+
+    /** Heights being uploaded */
+    std::vector<float> scratch;
+
+    /** The cost of the last update */
+    ClipmapUpdateStats lastUpdate;
+};
+
+#endif  // Ends the conditional inclusion directive
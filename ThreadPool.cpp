@@ -0,0 +1,98 @@
+// Includes the corresponding header file to access the ThreadPool class declaration
+#include "ThreadPool.h"
+
+/**
+ * Constructor: Starts the worker threads.
+ *
+ * @param threadCount The number of workers; 0 means one per hardware thread.
+ */
+ThreadPool::ThreadPool(size_t threadCount) : pending(0), stopping(false) {
+    if (threadCount == 0) {
+        threadCount = std::thread::hardware_concurrency();
+    }
+    if (threadCount == 0) {
+        threadCount = 1; // hardware_concurrency() may be unknown
+    }
+
+    workers.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+/**
+ * Destructor: Finishes all queued tasks, then stops and joins the workers.
+ */
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    taskAvailable.notify_all();
+
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+/**
+ * Queues a task to run on a worker thread.
+ *
+ * @param task The function to run.
+ */
+void ThreadPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(std::move(task));
+        pending++;
+    }
+    taskAvailable.notify_one();
+}
+
+/**
+ * Blocks until every submitted task has finished.
+ */
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    allDone.wait(lock, [this] { return pending == 0; });
+}
+
+/**
+ * Returns the number of tasks queued or running.
+ */
+size_t ThreadPool::getPendingCount() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return pending;
+}
+
+/**
+ * The loop each worker thread runs: take a task, run it, repeat.
+ */
+void ThreadPool::workerLoop() {
+    for (;;) {
+        std::function<void()> task;
+
+        // Sleep until there is work, or until the pool stops with nothing left to do
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            taskAvailable.wait(lock, [this] { return stopping || !tasks.empty(); });
+            if (tasks.empty()) {
+                return;
+            }
+
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+
+        task();
+
+        // Wake anyone in wait() once the last task is done
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending--;
+            if (pending == 0) {
+                allDone.notify_all();
+            }
+        }
+    }
+}
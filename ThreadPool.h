@@ -0,0 +1,94 @@
+// Prevents multiple inclusions of this header file, which can cause redefinition errors
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+// Includes std::condition_variable, used to sleep until work or completion
+#include <condition_variable>
+
+// Includes the deque container used as the task queue
+#include <deque>
+
+// Includes std::function, the type of a queued task
+#include <functional>
+
+// Includes std::mutex, which guards the task queue
+#include <mutex>
+
+// Includes std::thread for the worker threads
+#include <thread>
+
+// Includes the vector container that holds the workers
+#include <vector>
+
+/**
+ * The `ThreadPool` class runs tasks on a fixed set of worker threads.
+ *
+ * Tasks are plain `std::function<void()>` objects executed in submission order
+ * (though they may finish in any order). Idle workers sleep on a condition
+ * variable rather than polling.
+ */
+class ThreadPool {
+public:
+    /**
+     * Constructor: Starts the worker threads.
+     *
+     * @param threadCount The number of workers; 0 means one per hardware thread.
+     */
+    explicit ThreadPool(size_t threadCount = 0);
+
+    /**
+     * Destructor: Finishes all queued tasks, then stops and joins the workers.
+     */
+    ~ThreadPool();
+
+    // The pool owns running threads, so it can't be copied
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * Queues a task to run on a worker thread.
+     *
+     * @param task The function to run.
+     */
+    void submit(std::function<void()> task);
+
+    /**
+     * Blocks until every submitted task has finished.
+     */
+    void wait();
+
+    /** Returns the number of worker threads */
+    size_t getThreadCount() const { return workers.size(); }
+
+    /** Returns the number of tasks queued or running (the job queue depth) */
+    size_t getPendingCount();
+
+private:
+    /** The worker threads */
+    std::vector<std::thread> workers;
+
+    /** Tasks waiting for a worker */
+    std::deque<std::function<void()>> tasks;
+
+    /** Guards `tasks`, `pending` and `stopping` */
+    std::mutex mutex;
+
+    /** Signalled when a task is queued or the pool is stopping */
+    std::condition_variable taskAvailable;
+
+    /** Signalled when the last pending task finishes */
+    std::condition_variable allDone;
+
+    /** The number of tasks queued or running */
+    size_t pending;
+
+    /** Set when the pool is shutting down */
+    bool stopping;
+
+    /**
+     * The loop each worker thread runs: take a task, run it, repeat.
+     */
+    void workerLoop();
+};
+
+#endif  // Ends the conditional inclusion directive
@@ -0,0 +1,38 @@
+// Includes the corresponding header file to access the ThreadPoolIOBackend class declaration
+#include "ThreadPoolIOBackend.h"
+
+// Includes std::min
+#include <algorithm>
+
+/**
+ * Constructor: Starts the I/O worker threads.
+ *
+ * @param threadCount The number of workers.
+ */
+ThreadPoolIOBackend::ThreadPoolIOBackend(size_t threadCount) : pool(threadCount) {}
+
+/**
+ * Performs every read in a batch, blocking until all have completed.
+ *
+ * The batch is cut into one contiguous slice per worker rather than one task per
+ * read, so a sorted batch gives each worker a run of neighbouring offsets.
+ *
+ * @param requests The reads to perform.
+ */
+void ThreadPoolIOBackend::readBatch(std::vector<ChunkReadRequest>& requests) {
+    size_t workers = pool.getThreadCount();
+    size_t sliceSize = (requests.size() + workers - 1) / workers;
+
+    for (size_t begin = 0; begin < requests.size(); begin += sliceSize) {
+        size_t end = std::min(begin + sliceSize, requests.size());
+
+        pool.submit([&requests, begin, end] {
+            for (size_t i = begin; i < end; ++i) {
+                ChunkReadRequest& request = requests[i];
+                request.success = request.file->readAt(request.buffer, request.size, request.offset);
+            }
+        });
+    }
+
+    pool.wait();
+}
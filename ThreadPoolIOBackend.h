@@ -0,0 +1,38 @@
+// Prevents multiple inclusions of this header file, which can cause redefinition errors
+#ifndef THREAD_POOL_IO_BACKEND_H
+#define THREAD_POOL_IO_BACKEND_H
+
+#include "RegionIO.h"   // The backend interface being implemented
+#include "ThreadPool.h" // The workers that perform the reads
+
+/**
+ * The `ThreadPoolIOBackend` class performs a batch of reads with ordinary
+ * blocking `File::readAt` calls spread across a pool of worker threads.
+ *
+ * This is the portable fallback: it works on every platform, and keeps as many
+ * reads in flight as there are workers.
+ */
+class ThreadPoolIOBackend : public RegionIOBackend {
+public:
+    /**
+     * Constructor: Starts the I/O worker threads.
+     *
+     * @param threadCount The number of workers. I/O threads mostly sleep, so
+     *                    more than the core count is fine.
+     */
+    explicit ThreadPoolIOBackend(size_t threadCount = 8);
+
+    /**
+     * Performs every read in a batch, blocking until all have completed.
+     */
+    void readBatch(std::vector<ChunkReadRequest>& requests) override;
+
+    /** Returns "thread-pool" */
+    const char* getName() const override { return "thread-pool"; }
+
+private:
+    /** The workers that perform the reads */
+    ThreadPool pool;
+};
+
+#endif  // Ends the conditional inclusion directive
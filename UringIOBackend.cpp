@@ -0,0 +1,137 @@
+// Includes the corresponding header file to access the UringIOBackend class declaration
+#include "UringIOBackend.h"
+
+// Includes EINTR
+#include <cerrno>
+
+// Includes standard I/O for printing error messages to the console
+#include <iostream>
+
+/**
+ * Constructor: Sets up the ring.
+ *
+ * @param queueDepth The maximum number of reads in flight.
+ */
+UringIOBackend::UringIOBackend(unsigned queueDepth) : queueDepth(queueDepth), valid(false), failed(false) {
+    int result = io_uring_queue_init(queueDepth, &ring, 0);
+    if (result < 0) {
+        std::cout << "ERROR::IO_URING::INIT_FAILED " << -result << std::endl;
+        return;
+    }
+    valid = true;
+}
+
+/**
+ * Destructor: Tears down the ring.
+ */
+UringIOBackend::~UringIOBackend() {
+    if (valid) {
+        io_uring_queue_exit(&ring);
+    }
+}
+
+/**
+ * Performs every read in a batch, blocking until all have completed.
+ *
+ * @param requests The reads to perform.
+ */
+void UringIOBackend::readBatch(std::vector<ChunkReadRequest>& requests) {
+    size_t next = 0;
+
+    // A failed submission can leave prepared entries on the ring; submitting anything
+    // again would hand the kernel reads into buffers of a batch long returned
+    if (failed) {
+        finishSynchronously(requests, next);
+        return;
+    }
+
+    // Prepared entries wait on the ring until the kernel takes them; only then are they in flight
+    unsigned prepared = 0;
+    unsigned inFlight = 0;
+
+    while (next < requests.size() || prepared > 0 || inFlight > 0) {
+        // --- Fill the submission ring ---
+        while (next < requests.size() && prepared + inFlight < queueDepth) {
+            io_uring_sqe* sqe = io_uring_get_sqe(&ring);
+            if (!sqe) {
+                break;
+            }
+
+            ChunkReadRequest& request = requests[next++];
+            io_uring_prep_read(sqe, int(request.file->nativeHandle()), request.buffer, request.size, request.offset);
+            io_uring_sqe_set_data(sqe, &request);
+            prepared++;
+        }
+
+        // --- Submit everything queued and wait for at least one completion ---
+        // The kernel takes entries in order, so the ones it didn't take are the last prepared
+        int result = io_uring_submit_and_wait(&ring, 1);
+        if (result > 0) {
+            prepared -= unsigned(result);
+            inFlight += unsigned(result);
+        } else if (result < 0 && result != -EINTR) {
+            std::cout << "ERROR::IO_URING::SUBMIT_FAILED " << -result << std::endl;
+            failed = true;
+            break;
+        }
+
+        // --- Reap every completion available ---
+        unsigned head;
+        unsigned reaped = 0;
+        io_uring_cqe* cqe;
+        io_uring_for_each_cqe(&ring, head, cqe) {
+            complete(*static_cast<ChunkReadRequest*>(io_uring_cqe_get_data(cqe)), cqe->res);
+            reaped++;
+        }
+        io_uring_cq_advance(&ring, reaped);
+        inFlight -= reaped;
+    }
+
+    // If the ring failed, wait out what the kernel took (waiting submits nothing),
+    // then finish the rest, prepared entries included, synchronously
+    while (inFlight > 0) {
+        io_uring_cqe* cqe;
+        if (io_uring_wait_cqe(&ring, &cqe) < 0) {
+            break;
+        }
+        complete(*static_cast<ChunkReadRequest*>(io_uring_cqe_get_data(cqe)), cqe->res);
+        io_uring_cqe_seen(&ring, cqe);
+        inFlight--;
+    }
+    finishSynchronously(requests, next - prepared);
+}
+
+/**
+ * Performs the reads of a batch from a request on with ordinary positioned reads.
+ *
+ * @param requests The batch.
+ * @param first    The first request not yet performed.
+ */
+void UringIOBackend::finishSynchronously(std::vector<ChunkReadRequest>& requests, size_t first) {
+    for (size_t i = first; i < requests.size(); ++i) {
+        ChunkReadRequest& request = requests[i];
+        request.success = request.file->readAt(request.buffer, request.size, request.offset);
+    }
+}
+
+/**
+ * Records the result of one completed read.
+ *
+ * @param request The request the completion belongs to.
+ * @param result  The completion's result: bytes read, or a negative error code.
+ */
+void UringIOBackend::complete(ChunkReadRequest& request, int result) {
+    if (result == int(request.size)) {
+        request.success = true;
+        return;
+    }
+
+    // A short read is legal; fetch the remainder with an ordinary positioned read
+    if (result > 0) {
+        request.success = request.file->readAt(request.buffer + result, request.size - uint32_t(result),
+                                               request.offset + uint64_t(result));
+        return;
+    }
+
+    request.success = false;
+}
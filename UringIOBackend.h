@@ -0,0 +1,77 @@
+// Prevents multiple inclusions of this header file, which can cause redefinition errors
+#ifndef URING_IO_BACKEND_H
+#define URING_IO_BACKEND_H
+
+// liburing, the userspace helper library for Linux io_uring
+#include <liburing.h>
+
+// Includes the backend interface being implemented
+#include "RegionIO.h"
+
+/**
+ * The `UringIOBackend` class performs a batch of reads through Linux io_uring.
+ *
+ * Reads are placed on a shared submission ring and handed to the kernel with a
+ * single syscall per refill, instead of one `pread` per chunk. Completions are
+ * reaped in bulk and the ring is topped up as slots free, so up to `queueDepth`
+ * reads are in flight at any time from one thread.
+ *
+ * Only compiled when liburing is found (KYBUS_HAVE_IO_URING).
+ */
+class UringIOBackend : public RegionIOBackend {
+public:
+    /**
+     * Constructor: Sets up the ring. Check `isValid` afterwards; the kernel may
+     * be too old, or io_uring may be disabled by policy.
+     *
+     * @param queueDepth The maximum number of reads in flight.
+     */
+    explicit UringIOBackend(unsigned queueDepth = 256);
+
+    /**
+     * Destructor: Tears down the ring.
+     */
+    ~UringIOBackend() override;
+
+    /** Returns true if the ring was created successfully */
+    bool isValid() const { return valid; }
+
+    /**
+     * Performs every read in a batch, blocking until all have completed.
+     */
+    void readBatch(std::vector<ChunkReadRequest>& requests) override;
+
+    /** Returns "io_uring" */
+    const char* getName() const override { return "io_uring"; }
+
+private:
+    /** The submission and completion rings shared with the kernel */
+    io_uring ring;
+
+    /** The number of submission slots */
+    unsigned queueDepth;
+
+    /** True if `ring` was initialized */
+    bool valid;
+
+    /** Set once a submission fails; every later batch is read synchronously */
+    bool failed;
+
+    /**
+     * Records the result of one completed read.
+     *
+     * @param request The request the completion belongs to.
+     * @param result  The completion's result: bytes read, or a negative error code.
+     */
+    static void complete(ChunkReadRequest& request, int result);
+
+    /**
+     * Performs the reads of a batch from a request on with ordinary positioned reads.
+     *
+     * @param requests The batch.
+     * @param first    The first request not yet performed.
+     */
+    static void finishSynchronously(std::vector<ChunkReadRequest>& requests, size_t first);
+};
+
+#endif  // Ends the conditional inclusion directive
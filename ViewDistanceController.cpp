@@ -0,0 +1,194 @@
+// Includes the corresponding header file to access the ViewDistanceController class declaration
+#include "ViewDistanceController.h"
+
+// Includes std::nth_element and std::min/max
+#include <algorithm>
+
+// Includes std::fixed and std::setprecision, used to format times
+#include <iomanip>
+
+// Includes standard I/O for printing decisions to the console
+#include <iostream>
+
+// Frames in the window the percentile is taken over, and waited after a change (a second at 60 fps)
+static const size_t WINDOW_SIZE = 60;
+
+// Shrink above this fraction of the budget, grow below this one; the gap is the hysteresis
+static const double SHRINK_RATIO = 1.1;
+static const double GROW_RATIO = 0.75;
+
+// Frames of headroom in a row needed before growing
+static const size_t GROW_FRAMES = 180;
+
+// A queue deeper than this many times the limit, for a whole window, means streaming cannot keep up
+static const size_t BACKLOG_FACTOR = 4;
+
+// How far one decision moves the LOD scale
+static const float LOD_STEP = 0.25f;
+
+/**
+ * Constructor: Starts at the smallest radius and LOD scale and the largest budgets.
+ *
+ * @param targetFrameMs The frame time budget in milliseconds.
+ * @param minimum       The lowest value of each setting.
+ * @param maximum       The highest value of each setting.
+ * @param queueLimit    The job queue depth streaming is considered to keep up at.
+ */
+ViewDistanceController::ViewDistanceController(double targetFrameMs, const ViewSettings& minimum,
+                                               const ViewSettings& maximum, size_t queueLimit)
+    : targetFrameMs(targetFrameMs), minimum(minimum), maximum(maximum), queueLimit(queueLimit),
+      frameTimes(WINDOW_SIZE, 0.0), nextFrame(0), frameCount(0), percentile(0.0), framesSinceChange(0),
+      headroomFrames(0), backlogFrames(0), logging(true), startTime(std::chrono::steady_clock::now()) {
+    // Start small and grow: a slow machine never sees the stutter of starting too far out
+    settings.streamingRadius = minimum.streamingRadius;
+    settings.lodScale = minimum.lodScale;
+    settings.meshBudget = maximum.meshBudget;
+    settings.uploadBudget = maximum.uploadBudget;
+}
+
+/**
+ * Feeds one frame's measurements and adjusts the settings if needed.
+ *
+ * @param frameMs    The frame's time in milliseconds.
+ * @param queueDepth The number of streaming jobs queued or running.
+ * @return True if the settings changed.
+ */
+bool ViewDistanceController::update(double frameMs, size_t queueDepth) {
+    frameTimes[nextFrame] = frameMs;
+    nextFrame = (nextFrame + 1) % WINDOW_SIZE;
+    frameCount = std::min(frameCount + 1, WINDOW_SIZE);
+    ++framesSinceChange;
+    backlogFrames = queueDepth > queueLimit * BACKLOG_FACTOR ? backlogFrames + 1 : 0;
+
+    // Wait until the whole window was measured with the current settings
+    if (frameCount < WINDOW_SIZE || framesSinceChange < WINDOW_SIZE) {
+        return false;
+    }
+
+    std::vector<double> sorted(frameTimes);
+    size_t rank = WINDOW_SIZE * 9 / 10;
+    std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+    percentile = sorted[rank];
+
+    bool changed = false;
+    if (percentile > targetFrameMs * SHRINK_RATIO) {
+        headroomFrames = 0;
+        changed = shrink("over budget", queueDepth);
+    } else if (backlogFrames >= WINDOW_SIZE && settings.streamingRadius > minimum.streamingRadius) {
+        // Fast frames, but the workers can't keep up with what the radius asks for
+        headroomFrames = 0;
+        log("SHRINK", "radius", settings.streamingRadius, settings.streamingRadius - 1, "streaming behind", queueDepth);
+        --settings.streamingRadius;
+        changed = true;
+    } else if (percentile < targetFrameMs * GROW_RATIO) {
+        if (++headroomFrames >= GROW_FRAMES) {
+            headroomFrames = 0;
+            changed = grow(queueDepth);
+        }
+    } else {
+        headroomFrames = 0;
+    }
+
+    if (changed) {
+        framesSinceChange = 0;
+        backlogFrames = 0;
+    }
+    return changed;
+}
+
+/**
+ * Gives up the cheapest detail left: the budgets (if streaming uses them), then LOD distance,
+ * then radius.
+ *
+ * @param reason     Why, for the log.
+ * @param queueDepth The job queue depth, for the log.
+ * @return False if everything is at its minimum.
+ */
+bool ViewDistanceController::shrink(const char* reason, size_t queueDepth) {
+    // Meshing and uploads come in bursts, so they are the usual cause of stutter; but with
+    // fewer jobs queued than the budget they are not what the frame spends its time on
+    bool budgetsUsed = queueDepth >= size_t(settings.meshBudget);
+    if (budgetsUsed && (settings.meshBudget > minimum.meshBudget || settings.uploadBudget > minimum.uploadBudget)) {
+        int meshBudget = std::max(minimum.meshBudget, settings.meshBudget / 2);
+        int uploadBudget = std::max(minimum.uploadBudget, settings.uploadBudget / 2);
+        log("SHRINK", "mesh budget", settings.meshBudget, meshBudget, reason, queueDepth);
+        log("SHRINK", "upload budget", settings.uploadBudget, uploadBudget, reason, queueDepth);
+        settings.meshBudget = meshBudget;
+        settings.uploadBudget = uploadBudget;
+        return true;
+    }
+    if (settings.lodScale > minimum.lodScale) {
+        float lodScale = std::max(minimum.lodScale, settings.lodScale - LOD_STEP);
+        log("SHRINK", "lod scale", settings.lodScale, lodScale, reason, queueDepth);
+        settings.lodScale = lodScale;
+        return true;
+    }
+    if (settings.streamingRadius > minimum.streamingRadius) {
+        log("SHRINK", "radius", settings.streamingRadius, settings.streamingRadius - 1, reason, queueDepth);
+        --settings.streamingRadius;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Takes back the most important detail given up: the radius last, as growing it adds work
+ * to the queue.
+ *
+ * @param queueDepth The job queue depth.
+ * @return False if there is nothing to take back or streaming is behind.
+ */
+bool ViewDistanceController::grow(size_t queueDepth) {
+    const char* reason = "headroom";
+    if (settings.meshBudget < maximum.meshBudget || settings.uploadBudget < maximum.uploadBudget) {
+        int meshBudget = std::min(maximum.meshBudget, std::max(1, settings.meshBudget * 2));
+        int uploadBudget = std::min(maximum.uploadBudget, std::max(1, settings.uploadBudget * 2));
+        log("GROW", "mesh budget", settings.meshBudget, meshBudget, reason, queueDepth);
+        log("GROW", "upload budget", settings.uploadBudget, uploadBudget, reason, queueDepth);
+        settings.meshBudget = meshBudget;
+        settings.uploadBudget = uploadBudget;
+        return true;
+    }
+
+    // More detail or distance only adds jobs; wait for streaming to catch up first
+    if (queueDepth > queueLimit) {
+        return false;
+    }
+    if (settings.lodScale < maximum.lodScale) {
+        float lodScale = std::min(maximum.lodScale, settings.lodScale + LOD_STEP);
+        log("GROW", "lod scale", settings.lodScale, lodScale, reason, queueDepth);
+        settings.lodScale = lodScale;
+        return true;
+    }
+    if (settings.streamingRadius < maximum.streamingRadius) {
+        log("GROW", "radius", settings.streamingRadius, settings.streamingRadius + 1, reason, queueDepth);
+        ++settings.streamingRadius;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Prints a decision with its timestamp.
+ *
+ * @param action     "SHRINK" or "GROW".
+ * @param setting    The setting changed.
+ * @param from, to   Its old and new value.
+ * @param reason     Why.
+ * @param queueDepth The job queue depth at the time.
+ */
+void ViewDistanceController::log(const char* action, const char* setting, double from, double to, const char* reason,
+                                 size_t queueDepth) const {
+    if (!logging) {
+        return;
+    }
+
+    // Whole numbers (radius, budgets) print without decimals
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    int decimals = (from == double(int(from)) && to == double(int(to))) ? 0 : 2;
+    std::cout << std::fixed << std::setprecision(3) << "[" << seconds << " s] VIEW_DISTANCE::" << action << " "
+              << setting << " " << std::setprecision(decimals) << from << " -> " << to << std::setprecision(2) << " ("
+              << reason << ": frame p90 " << percentile << " ms, target " << targetFrameMs << " ms, queue "
+              << queueDepth << ")" << std::endl;
+    std::cout << std::defaultfloat;
+}
@@ -0,0 +1,130 @@
+// Prevents multiple inclusions of this header file, which can cause redefinition errors
+#ifndef VIEW_DISTANCE_CONTROLLER_H
+#define VIEW_DISTANCE_CONTROLLER_H
+
+// Includes the clock used to timestamp decisions
+#include <chrono>
+
+// Includes size_t
+#include <cstddef>
+
+// Includes the vector container, used for the frame time window
+#include <vector>
+
+/**
+ * The `ViewSettings` struct holds the knobs that trade detail for frame time.
+ */
+struct ViewSettings {
+    /** The radius, in chunks, around the camera that is loaded and drawn */
+    int streamingRadius;
+
+    /** Scales every LOD switch distance; below 1 coarser LODs start nearer */
+    float lodScale;
+
+    /** The chunk meshes built per frame */
+    int meshBudget;
+
+    /** The chunk meshes uploaded to the GPU per frame */
+    int uploadBudget;
+};
+
+/**
+ * The `ViewDistanceController` class adjusts the `ViewSettings` to the
+ * machine it runs on, from measured frame times and the depth of the
+ * streaming job queue, so that a fixed view distance neither wastes a fast
+ * machine nor stutters on a slow one.
+ *
+ * It looks at the 90th percentile frame time over the last second or so of
+ * frames, which follows stutter but not a single hitch. Over budget, it
+ * gives up the cheapest detail first: the per-frame meshing and upload
+ * budgets (halved, if enough jobs are queued to use them), then LOD
+ * distance, then streaming radius. With headroom it takes them back in the
+ * reverse order, but only after the headroom has lasted a few seconds, and
+ * it grows the radius only while streaming keeps up with the job queue. Growing asks for a lot more headroom than
+ * shrinking tolerates, and after every change it waits for a full window
+ * of frames measured with the new settings, so it settles rather than
+ * oscillating. A job queue that stays far too deep shrinks the radius even
+ * when frames are fast.
+ *
+ * Each decision is printed with the time since the controller started.
+ */
+class ViewDistanceController {
+public:
+    /**
+     * Constructor: Starts at the smallest radius and LOD scale and the largest budgets.
+     *
+     * @param targetFrameMs The frame time budget in milliseconds (16.7 for 60 fps).
+     * @param minimum       The lowest value of each setting.
+     * @param maximum       The highest value of each setting.
+     * @param queueLimit    The job queue depth streaming is considered to keep up at.
+     */
+    ViewDistanceController(double targetFrameMs, const ViewSettings& minimum, const ViewSettings& maximum,
+                           size_t queueLimit = 64);
+
+    /**
+     * Feeds one frame's measurements and adjusts the settings if needed.
+     *
+     * @param frameMs    The frame's time in milliseconds (the larger of its CPU and GPU time).
+     * @param queueDepth The number of streaming jobs queued or running.
+     * @return True if the settings changed.
+     */
+    bool update(double frameMs, size_t queueDepth);
+
+    /** Returns the settings to use */
+    const ViewSettings& getSettings() const { return settings; }
+
+    /** Returns the 90th percentile frame time of the window, or 0 before it has filled */
+    double getFrameTimePercentile() const { return percentile; }
+
+    /** Turns printing the decisions on (the default) or off */
+    void setLogging(bool enabled) { logging = enabled; }
+
+private:
+    /**
+     * Gives up the cheapest detail left. Returns false if everything is at its minimum.
+     */
+    bool shrink(const char* reason, size_t queueDepth);
+
+    /**
+     * Takes back the most important detail given up, or grows the radius.
+     * Returns false if there is nothing to take back or streaming is behind.
+     */
+    bool grow(size_t queueDepth);
+
+    /**
+     * Prints a decision with its timestamp.
+     */
+    void log(const char* action, const char* setting, double from, double to, const char* reason, size_t queueDepth) const;
+
+    /** The frame time budget */
+    double targetFrameMs;
+
+    /** The bounds of each setting, and the settings in use */
+    ViewSettings minimum;
+    ViewSettings maximum;
+    ViewSettings settings;
+
+    /** The job queue depth streaming keeps up at */
+    size_t queueLimit;
+
+    /** The most recent frame times, a ring of one window */
+    std::vector<double> frameTimes;
+    size_t nextFrame;
+    size_t frameCount;
+
+    /** The 90th percentile of `frameTimes` */
+    double percentile;
+
+    /** Frames since the last change, frames of headroom in a row, and frames with the queue far too deep */
+    size_t framesSinceChange;
+    size_t headroomFrames;
+    size_t backlogFrames;
+
+    /** True to print decisions */
+    bool logging;
+
+    /** When the controller started, the zero of the timestamps */
+    std::chrono::steady_clock::time_point startTime;
+};
+
+#endif  // Ends the conditional inclusion directive
@@ -0,0 +1,737 @@
+// Includes the corresponding header file to access the VoxelRaytracer class declaration
+#include "VoxelRaytracer.h"
+
+// Includes std::min and std::max
+#include <algorithm>
+
+// Includes std::atomic, used to hand out tiles and sum step counts across workers
+#include <atomic>
+
+// Includes std::chrono, used to time renders
+#include <chrono>
+
+// Includes std::floor, std::tan and INFINITY
+#include <cmath>
+
+// Includes std::memcpy, used to read four blocks at once when building brick masks
+#include <cstring>
+
+// Includes standard I/O for printing error messages to the console
+#include <iostream>
+
+// Packets are as wide as the widest float vectors the build targets. SSE2 is part of every
+// x86-64 CPU; AVX needs a compiler flag (/arch:AVX2 or -mavx), such as KYBUS_ENABLE_BMI2 sets on MSVC.
+#if defined(__AVX__)
+#include <immintrin.h>
+#define VOXEL_RAYTRACER_USE_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VOXEL_RAYTRACER_USE_SSE2 1
+#endif
+
+/**
+ * The `Lanes` struct wraps the float vector operations packet tracing needs,
+ * so the packet loop is written once for every instruction set.
+ */
+#if defined(VOXEL_RAYTRACER_USE_AVX)
+struct Lanes {
+    static constexpr int WIDTH = 8;
+    using Value = __m256;
+    static Value load(const float* p) { return _mm256_load_ps(p); }
+    static void store(float* p, Value v) { _mm256_store_ps(p, v); }
+    static Value set(float f) { return _mm256_set1_ps(f); }
+    static Value add(Value a, Value b) { return _mm256_add_ps(a, b); }
+    static Value sub(Value a, Value b) { return _mm256_sub_ps(a, b); }
+    static Value mul(Value a, Value b) { return _mm256_mul_ps(a, b); }
+    static Value min(Value a, Value b) { return _mm256_min_ps(a, b); }
+    static Value max(Value a, Value b) { return _mm256_max_ps(a, b); }
+    static Value floor(Value v) { return _mm256_floor_ps(v); }
+    static Value lessEqual(Value a, Value b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+    static Value select(Value mask, Value a, Value b) { return _mm256_blendv_ps(b, a, mask); }
+};
+#elif defined(VOXEL_RAYTRACER_USE_SSE2)
+struct Lanes {
+    static constexpr int WIDTH = 4;
+    using Value = __m128;
+    static Value load(const float* p) { return _mm_load_ps(p); }
+    static void store(float* p, Value v) { _mm_store_ps(p, v); }
+    static Value set(float f) { return _mm_set1_ps(f); }
+    static Value add(Value a, Value b) { return _mm_add_ps(a, b); }
+    static Value sub(Value a, Value b) { return _mm_sub_ps(a, b); }
+    static Value mul(Value a, Value b) { return _mm_mul_ps(a, b); }
+    static Value min(Value a, Value b) { return _mm_min_ps(a, b); }
+    static Value max(Value a, Value b) { return _mm_max_ps(a, b); }
+    static Value lessEqual(Value a, Value b) { return _mm_cmple_ps(a, b); }
+    static Value select(Value mask, Value a, Value b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+
+    // SSE2 has no rounding instruction: truncate, then step down where that rounded up
+    static Value floor(Value v) {
+        Value truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(v));
+        return _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, v), _mm_set1_ps(1.0f)));
+    }
+};
+#else
+struct Lanes {
+    static constexpr int WIDTH = 4;
+    struct Value {
+        float v[WIDTH];
+    };
+    static Value load(const float* p) { Value r; std::memcpy(r.v, p, sizeof(r.v)); return r; }
+    static void store(float* p, Value v) { std::memcpy(p, v.v, sizeof(v.v)); }
+    static Value set(float f) { Value r; for (float& x : r.v) x = f; return r; }
+    template <typename Op>
+    static Value apply(Value a, Value b, Op op) { Value r; for (int i = 0; i < WIDTH; ++i) r.v[i] = op(a.v[i], b.v[i]); return r; }
+    static Value add(Value a, Value b) { return apply(a, b, [](float x, float y) { return x + y; }); }
+    static Value sub(Value a, Value b) { return apply(a, b, [](float x, float y) { return x - y; }); }
+    static Value mul(Value a, Value b) { return apply(a, b, [](float x, float y) { return x * y; }); }
+    static Value min(Value a, Value b) { return apply(a, b, [](float x, float y) { return x < y ? x : y; }); }
+    static Value max(Value a, Value b) { return apply(a, b, [](float x, float y) { return x > y ? x : y; }); }
+    static Value floor(Value v) { return apply(v, v, [](float x, float) { return std::floor(x); }); }
+    static Value lessEqual(Value a, Value b) { return apply(a, b, [](float x, float y) { return x <= y ? 1.0f : 0.0f; }); }
+    static Value select(Value mask, Value a, Value b) {
+        Value r; for (int i = 0; i < WIDTH; ++i) r.v[i] = mask.v[i] != 0.0f ? a.v[i] : b.v[i]; return r;
+    }
+};
+#endif
+
+/** The number of rays in a packet, and the pixels they cover */
+static constexpr int PACKET_WIDTH = Lanes::WIDTH;
+static constexpr int PACKET_COLUMNS = PACKET_WIDTH == 8 ? 4 : 2;
+static constexpr int PACKET_ROWS = 2;
+
+/** The edge length of the square tiles workers take in turn, in pixels */
+static constexpr int TILE_SIZE = 32;
+
+/** How far past its clipped start a ray is sampled to find the block it starts in */
+static constexpr float SAMPLE_OFFSET = 1e-3f;
+
+/** Stands in for 1/0 on axes a ray doesn't move along, so those boundaries are never reached */
+static constexpr float NO_CROSSING = 1e30f;
+
+/** The most chunks a grid may hold (16 bytes each) */
+static constexpr size_t MAX_GRID_CHUNKS = size_t(1) << 20;
+
+/** The log2 of the size of each level of empty space, in blocks */
+static constexpr int CELL_LEVEL = 6;
+static constexpr int CHUNK_LEVEL = 4;
+static constexpr int BRICK_LEVEL = 2;
+
+/** Light per face (`BlockFace` order), so the shape of the terrain reads without real lighting */
+static const float FACE_LIGHT[FACE_COUNT + 1] = { 0.8f, 0.7f, 1.0f, 0.5f, 0.9f, 0.6f, 1.0f };
+
+/**
+ * The `RayPacket` struct holds the rays of one packet and their results,
+ * one array entry per ray so whole packets load into vector registers.
+ */
+struct VoxelRaytracer::RayPacket {
+    alignas(32) float originX[PACKET_WIDTH];
+    alignas(32) float originY[PACKET_WIDTH];
+    alignas(32) float originZ[PACKET_WIDTH];
+    alignas(32) float directionX[PACKET_WIDTH];
+    alignas(32) float directionY[PACKET_WIDTH];
+    alignas(32) float directionZ[PACKET_WIDTH];
+
+    /** The results: the block hit (BLOCK_AIR for none), the face and the distance */
+    BlockID block[PACKET_WIDTH];
+    int face[PACKET_WIDTH];
+    float distance[PACKET_WIDTH];
+};
+
+/** Returns the reciprocal of a direction component, or NO_CROSSING if it is 0 */
+static inline float inverse(float direction) {
+    return direction != 0.0f ? 1.0f / direction : NO_CROSSING;
+}
+
+/** Returns the face a ray moving along `axis` enters through */
+static inline int enteredFace(int axis, float inverseDirection) {
+    return axis < 0 ? int(FACE_COUNT) : axis * 2 + (inverseDirection >= 0.0f ? 1 : 0);
+}
+
+/** Returns the block a ray clipped to the grid starts in, kept inside the grid */
+static glm::ivec3 startCell(const glm::vec3& origin, const glm::vec3& direction, float start,
+                            const glm::ivec3& gridBlocks) {
+    glm::ivec3 cell(glm::floor(origin + direction * (start + SAMPLE_OFFSET)));
+    return glm::clamp(cell, glm::ivec3(0), gridBlocks - 1);
+}
+
+/** Converts a world position to grid space: blocks from the grid's lowest corner */
+static glm::vec3 toGrid(const WorldPosition& position, const glm::i64vec3& originChunk) {
+    return glm::vec3(position.chunk - originChunk) * float(CHUNK_SIZE) + position.local;
+}
+
+/** Creates a perspective camera */
+RaytraceCamera RaytraceCamera::perspective(const WorldPosition& position, const glm::vec3& forward,
+                                           const glm::vec3& up, float verticalFov) {
+    return RaytraceCamera{ position, forward, up, verticalFov, false, 0.0f };
+}
+
+/** Creates an orthographic camera */
+RaytraceCamera RaytraceCamera::orthographicView(const WorldPosition& position, const glm::vec3& forward,
+                                                const glm::vec3& up, float height) {
+    return RaytraceCamera{ position, forward, up, 0.0f, true, height };
+}
+
+/**
+ * Constructor: Creates a tracer with nothing built.
+ *
+ * @param pool The workers renders are split across.
+ */
+VoxelRaytracer::VoxelRaytracer(ThreadPool& pool)
+    : pool(pool), originChunk(0), gridChunks(0), gridBlocks(0), gridCells(0), skyColor(0.6f, 0.75f, 0.95f),
+      packetTracing(true) {}
+
+/**
+ * Builds the acceleration grid over a box of chunks.
+ *
+ * @param chunks     The loaded chunks.
+ * @param minChunk   The lowest chunk coordinate of the box.
+ * @param chunkCount The size of the box, in chunks.
+ * @return False if the box is empty or too large.
+ */
+bool VoxelRaytracer::build(const ChunkMap<Chunk*>& chunks, const glm::i64vec3& minChunk,
+                           const glm::ivec3& chunkCount) {
+    this->chunks.clear();
+    cells.clear();
+    gridChunks = gridBlocks = gridCells = glm::ivec3(0);
+
+    if (chunkCount.x <= 0 || chunkCount.y <= 0 || chunkCount.z <= 0) {
+        std::cout << "ERROR::RAYTRACER::EMPTY_REGION" << std::endl;
+        return false;
+    }
+    size_t chunkTotal = size_t(chunkCount.x) * size_t(chunkCount.y) * size_t(chunkCount.z);
+    if (chunkTotal > MAX_GRID_CHUNKS) {
+        std::cout << "ERROR::RAYTRACER::REGION_TOO_LARGE " << chunkTotal << " chunks" << std::endl;
+        return false;
+    }
+
+    originChunk = minChunk;
+    gridChunks = chunkCount;
+    gridBlocks = chunkCount * CHUNK_SIZE;
+    gridCells = (chunkCount + 3) / 4;
+    this->chunks.assign(chunkTotal, GridChunk{ nullptr, 0 });
+    cells.assign(size_t(gridCells.x) * size_t(gridCells.y) * size_t(gridCells.z), 0);
+
+    // Visit the map rather than the box, so sparse worlds build quickly
+    for (const auto& entry : chunks) {
+        glm::i64vec3 offset = entry.first.toCoord() - minChunk;
+        if (offset.x < 0 || offset.y < 0 || offset.z < 0 || offset.x >= chunkCount.x || offset.y >= chunkCount.y ||
+            offset.z >= chunkCount.z) {
+            continue;
+        }
+
+        // A brick row is four consecutive blocks, so one 64-bit read tests it
+        const Chunk* chunk = entry.second;
+        uint64_t brickMask = 0;
+        for (int y = 0; y < CHUNK_SIZE; ++y) {
+            for (int z = 0; z < CHUNK_SIZE; ++z) {
+                for (int x = 0; x < CHUNK_SIZE; x += 4) {
+                    uint64_t row;
+                    std::memcpy(&row, &chunk->blocks[Chunk::index(x, y, z)], sizeof(row));
+                    if (row != 0) {
+                        brickMask |= uint64_t(1) << (((y >> 2) * 4 + (z >> 2)) * 4 + (x >> 2));
+                    }
+                }
+            }
+        }
+        if (brickMask == 0) {
+            continue;
+        }
+
+        glm::ivec3 c(offset);
+        this->chunks[(size_t(c.y) * gridChunks.z + c.z) * gridChunks.x + c.x] = GridChunk{ chunk, brickMask };
+        cells[(size_t(c.y >> 2) * gridCells.z + (c.z >> 2)) * gridCells.x + (c.x >> 2)] = 1;
+    }
+    return true;
+}
+
+/**
+ * Builds the acceleration grid over the bounding box of every chunk in a map.
+ */
+bool VoxelRaytracer::build(const ChunkMap<Chunk*>& chunks) {
+    if (chunks.empty()) {
+        return build(chunks, glm::i64vec3(0), glm::ivec3(0));
+    }
+
+    glm::i64vec3 low(INT64_MAX), high(INT64_MIN);
+    for (const auto& entry : chunks) {
+        glm::i64vec3 coord = entry.first.toCoord();
+        low = glm::min(low, coord);
+        high = glm::max(high, coord);
+    }
+
+    // Larger boxes than the grid allows are rejected by the other overload
+    glm::i64vec3 extent = glm::min(high - low + glm::i64vec3(1), glm::i64vec3(int64_t(MAX_GRID_CHUNKS) + 1));
+    return build(chunks, low, glm::ivec3(extent));
+}
+
+/**
+ * Sets the color a block type is drawn with.
+ */
+void VoxelRaytracer::setBlockColor(BlockID block, const glm::vec3& color) {
+    if (colors.size() <= block) {
+        colors.resize(size_t(block) + 1);
+        hasColor.resize(size_t(block) + 1, 0);
+    }
+    colors[block] = color;
+    hasColor[block] = 1;
+}
+
+/** Returns the number of rays in a packet */
+int VoxelRaytracer::getPacketWidth() {
+    return PACKET_WIDTH;
+}
+
+/**
+ * Renders the built chunks.
+ *
+ * @param camera        The view.
+ * @param width, height The image size in pixels.
+ * @param image         Receives the image.
+ * @param depth         If not null, receives each pixel's hit distance.
+ * @return The ray count and time.
+ */
+RaytraceStats VoxelRaytracer::render(const RaytraceCamera& camera, int width, int height, Image& image,
+                                     std::vector<float>* depth) {
+    auto startTime = std::chrono::steady_clock::now();
+
+    image.width = width;
+    image.height = height;
+    image.pixels.assign(size_t(width) * size_t(height) * 3, 0);
+    if (depth) {
+        depth->assign(size_t(width) * size_t(height), INFINITY);
+    }
+
+    // Camera basis; image rows run down, so the top row gets +up
+    glm::vec3 eye = toGrid(camera.position, originChunk);
+    glm::vec3 forward = glm::normalize(camera.forward);
+    glm::vec3 right = glm::normalize(glm::cross(forward, camera.up));
+    glm::vec3 up = glm::cross(right, forward);
+    float aspect = float(width) / float(height);
+    float halfHeight = camera.orthographic ? camera.orthographicHeight * 0.5f : std::tan(camera.verticalFov * 0.5f);
+
+    // Returns the ray through the centre of a pixel
+    auto makeRay = [&](int x, int y, glm::vec3& origin, glm::vec3& direction) {
+        float u = ((float(x) + 0.5f) / float(width) * 2.0f - 1.0f) * aspect * halfHeight;
+        float v = (1.0f - (float(y) + 0.5f) / float(height) * 2.0f) * halfHeight;
+        if (camera.orthographic) {
+            origin = eye + right * u + up * v;
+            direction = forward;
+        } else {
+            origin = eye;
+            direction = glm::normalize(forward + right * u + up * v);
+        }
+    };
+
+    // Writes one pixel's result
+    auto writePixel = [&](int x, int y, BlockID block, int face, float distance) {
+        glm::vec3 color = block != BLOCK_AIR ? shade(block, face) : shade(BLOCK_AIR, -1);
+        uint8_t* pixel = &image.pixels[(size_t(y) * width + x) * 3];
+        for (int channel = 0; channel < 3; ++channel) {
+            pixel[channel] = uint8_t(std::min(std::max(color[channel], 0.0f), 1.0f) * 255.0f + 0.5f);
+        }
+        if (depth && block != BLOCK_AIR) {
+            (*depth)[size_t(y) * width + x] = distance;
+        }
+    };
+
+    int tilesX = (width + TILE_SIZE - 1) / TILE_SIZE;
+    int tilesY = (height + TILE_SIZE - 1) / TILE_SIZE;
+    int tileCount = tilesX * tilesY;
+    std::atomic<int> nextTile(0);
+    std::atomic<uint64_t> totalSteps(0);
+
+    // Each worker takes tiles until none are left
+    auto worker = [&]() {
+        uint64_t steps = 0;
+        RayPacket packet;
+        for (int tile = nextTile++; tile < tileCount; tile = nextTile++) {
+            int tileX = tile % tilesX * TILE_SIZE;
+            int tileY = tile / tilesX * TILE_SIZE;
+            int tileRight = std::min(tileX + TILE_SIZE, width);
+            int tileBottom = std::min(tileY + TILE_SIZE, height);
+
+            if (!packetTracing) {
+                for (int y = tileY; y < tileBottom; ++y) {
+                    for (int x = tileX; x < tileRight; ++x) {
+                        glm::vec3 origin, direction;
+                        makeRay(x, y, origin, direction);
+                        BlockID block = BLOCK_AIR;
+                        int face = -1;
+                        float distance = INFINITY;
+                        glm::ivec3 position;
+                        if (!traceGrid(origin, direction, INFINITY, block, face, distance, position, steps)) {
+                            block = BLOCK_AIR;
+                        }
+                        writePixel(x, y, block, face, distance);
+                    }
+                }
+                continue;
+            }
+
+            for (int y = tileY; y < tileBottom; y += PACKET_ROWS) {
+                for (int x = tileX; x < tileRight; x += PACKET_COLUMNS) {
+                    // Rays past the image edge repeat the last pixel and are not written
+                    for (int lane = 0; lane < PACKET_WIDTH; ++lane) {
+                        glm::vec3 origin, direction;
+                        makeRay(std::min(x + lane % PACKET_COLUMNS, tileRight - 1),
+                                std::min(y + lane / PACKET_COLUMNS, tileBottom - 1), origin, direction);
+                        packet.originX[lane] = origin.x;
+                        packet.originY[lane] = origin.y;
+                        packet.originZ[lane] = origin.z;
+                        packet.directionX[lane] = direction.x;
+                        packet.directionY[lane] = direction.y;
+                        packet.directionZ[lane] = direction.z;
+                    }
+                    tracePacket(packet, steps);
+
+                    for (int lane = 0; lane < PACKET_WIDTH; ++lane) {
+                        int px = x + lane % PACKET_COLUMNS;
+                        int py = y + lane / PACKET_COLUMNS;
+                        if (px < tileRight && py < tileBottom) {
+                            writePixel(px, py, packet.block[lane], packet.face[lane], packet.distance[lane]);
+                        }
+                    }
+                }
+            }
+        }
+        totalSteps += steps;
+    };
+
+    for (size_t i = 0; i < pool.getThreadCount(); ++i) {
+        pool.submit(worker);
+    }
+    pool.wait();
+
+    RaytraceStats stats;
+    stats.rays = uint64_t(width) * uint64_t(height);
+    stats.steps = totalSteps;
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    return stats;
+}
+
+/**
+ * Renders an impostor: an orthographic view of the whole built box, looking
+ * at one of its faces from outside.
+ *
+ * @param face       The side of the box the camera looks at.
+ * @param resolution The image width and height in pixels.
+ * @param image      Receives the image.
+ * @param depth      If not null, receives each pixel's distance from the face.
+ */
+RaytraceStats VoxelRaytracer::renderImpostor(BlockFace face, int resolution, Image& image, std::vector<float>* depth) {
+    int axis = face / 2;
+    glm::vec3 normal(0.0f);
+    normal[axis] = face % 2 == 0 ? 1.0f : -1.0f;
+
+    // Looking along Y, north (-Z) is up in the image; otherwise the sky is
+    glm::vec3 up = axis == 1 ? glm::vec3(0.0f, 0.0f, -1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+    glm::vec3 extent(gridBlocks);
+    float height = std::max(extent[(axis + 1) % 3], extent[(axis + 2) % 3]);
+
+    // The camera sits one block outside the face, centred on it
+    glm::vec3 eye = extent * 0.5f + normal * (extent[axis] * 0.5f + 1.0f);
+    RaytraceCamera camera = RaytraceCamera::orthographicView(WorldPosition(originChunk, eye), -normal, up, height);
+    RaytraceStats stats = render(camera, resolution, resolution, image, depth);
+
+    if (depth) {
+        for (float& distance : *depth) {
+            distance -= 1.0f;
+        }
+    }
+    return stats;
+}
+
+/**
+ * Traces a single ray.
+ *
+ * @param origin      The start of the ray.
+ * @param direction   The direction (need not be normalized).
+ * @param maxDistance The furthest distance to look, in blocks.
+ * @param hit         Receives the hit.
+ * @return True if the ray hit a block.
+ */
+bool VoxelRaytracer::traceRay(const WorldPosition& origin, const glm::vec3& direction, float maxDistance,
+                              RaytraceHit& hit) const {
+    if (direction == glm::vec3(0.0f)) {
+        return false;
+    }
+
+    uint64_t steps = 0;
+    glm::ivec3 position;
+    if (!traceGrid(toGrid(origin, originChunk), glm::normalize(direction), maxDistance, hit.block, hit.face,
+                   hit.distance, position, steps)) {
+        return false;
+    }
+    hit.position = originChunk * int64_t(CHUNK_SIZE) + glm::i64vec3(position);
+    return true;
+}
+
+/**
+ * Finds the largest empty cell containing a block coordinate inside the grid.
+ *
+ * @param block Receives the block if the coordinate is solid.
+ * @return The log2 of the empty cell's size, or -1 for a solid block.
+ */
+inline int VoxelRaytracer::classify(int x, int y, int z, BlockID& block) const {
+    int cx = x >> CHUNK_LEVEL, cy = y >> CHUNK_LEVEL, cz = z >> CHUNK_LEVEL;
+    if (!cells[(size_t(cy >> 2) * gridCells.z + (cz >> 2)) * gridCells.x + (cx >> 2)]) {
+        return CELL_LEVEL;
+    }
+
+    const GridChunk& gridChunk = chunks[(size_t(cy) * gridChunks.z + cz) * gridChunks.x + cx];
+    if (!gridChunk.chunk) {
+        return CHUNK_LEVEL;
+    }
+
+    int lx = x & (CHUNK_SIZE - 1), ly = y & (CHUNK_SIZE - 1), lz = z & (CHUNK_SIZE - 1);
+    if (!(gridChunk.brickMask >> (((ly >> 2) * 4 + (lz >> 2)) * 4 + (lx >> 2)) & 1)) {
+        return BRICK_LEVEL;
+    }
+
+    block = gridChunk.chunk->get(lx, ly, lz);
+    return block == BLOCK_AIR ? 0 : -1;
+}
+
+/**
+ * Clips a ray to the grid's bounds.
+ *
+ * @param enterAxis Receives the axis of the face the ray enters through, or -1 if it starts inside.
+ * @return False if the ray misses the grid.
+ */
+bool VoxelRaytracer::clipToGrid(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, float& start,
+                                float& end, int& enterAxis) const {
+    if (chunks.empty()) {
+        return false;
+    }
+
+    float enter = -INFINITY, exit = INFINITY;
+    enterAxis = -1;
+    for (int axis = 0; axis < 3; ++axis) {
+        float inv = inverse(direction[axis]);
+        float near = (0.0f - origin[axis]) * inv;
+        float far = (float(gridBlocks[axis]) - origin[axis]) * inv;
+        if (near > far) {
+            std::swap(near, far);
+        }
+        if (near > enter) {
+            enter = near;
+            enterAxis = axis;
+        }
+        exit = std::min(exit, far);
+    }
+
+    start = std::max(enter, 0.0f);
+    end = std::min(exit, maxDistance);
+    if (enter <= 0.0f) {
+        enterAxis = -1;
+    }
+    return start < end;
+}
+
+/**
+ * Traces one ray in grid space.
+ *
+ * @param position Receives the grid coordinate of the block hit.
+ * @param steps    Incremented once per traversal step.
+ * @return True if the ray hit a block.
+ */
+bool VoxelRaytracer::traceGrid(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, BlockID& block,
+                               int& face, float& distance, glm::ivec3& position, uint64_t& steps) const {
+    float t, end;
+    int axis;
+    if (!clipToGrid(origin, direction, maxDistance, t, end, axis)) {
+        return false;
+    }
+
+    // The block the ray is in is tracked in integers rather than sampled from `t`: far
+    // from the origin, a small step in `t` rounds away, and the ray would stop moving
+    glm::vec3 inv(inverse(direction.x), inverse(direction.y), inverse(direction.z));
+    glm::ivec3 cell = startCell(origin, direction, t, gridBlocks);
+    while (t < end) {
+        ++steps;
+        int level = classify(cell.x, cell.y, cell.z, block);
+        if (level < 0) {
+            face = enteredFace(axis, axis < 0 ? 0.0f : inv[axis]);
+            distance = t;
+            position = cell;
+            return true;
+        }
+
+        // Step to where the ray leaves the empty cell
+        int size = 1 << level;
+        glm::ivec3 low = cell & ~(size - 1);
+        float next = INFINITY;
+        for (int a = 0; a < 3; ++a) {
+            float boundary = float(low[a] + (inv[a] >= 0.0f ? size : 0));
+            float crossing = (boundary - origin[a]) * inv[a];
+            if (crossing < next) {
+                next = crossing;
+                axis = a;
+            }
+        }
+        t = std::max(next, t);
+
+        // The crossing axis moves into the next cell exactly. The others follow the ray, but
+        // stay inside the cell being left and never move back, so every step makes progress
+        glm::vec3 point = origin + direction * t;
+        for (int a = 0; a < 3; ++a) {
+            bool positive = inv[a] >= 0.0f;
+            if (a == axis) {
+                cell[a] = positive ? low[a] + size : low[a] - 1;
+            } else {
+                int followed = int(std::floor(point[a]));
+                cell[a] = positive ? std::min(std::max(followed, cell[a]), low[a] + size - 1)
+                                   : std::max(std::min(followed, cell[a]), low[a]);
+            }
+        }
+        if (cell[axis] < 0 || cell[axis] >= gridBlocks[axis]) {
+            return false;
+        }
+    }
+    return false;
+}
+
+/**
+ * Traces every ray of a packet at once.
+ */
+void VoxelRaytracer::tracePacket(RayPacket& packet, uint64_t& steps) const {
+    alignas(32) float t[PACKET_WIDTH];
+    alignas(32) float end[PACKET_WIDTH];
+    alignas(32) float axis[PACKET_WIDTH];
+    alignas(32) float inverseX[PACKET_WIDTH];
+    alignas(32) float inverseY[PACKET_WIDTH];
+    alignas(32) float inverseZ[PACKET_WIDTH];
+    alignas(32) float cellX[PACKET_WIDTH];
+    alignas(32) float cellY[PACKET_WIDTH];
+    alignas(32) float cellZ[PACKET_WIDTH];
+    alignas(32) float size[PACKET_WIDTH];
+    alignas(32) float inverseSize[PACKET_WIDTH];
+
+    // Clip each ray to the grid; rays that miss it start finished
+    unsigned active = 0;
+    for (int lane = 0; lane < PACKET_WIDTH; ++lane) {
+        glm::vec3 origin(packet.originX[lane], packet.originY[lane], packet.originZ[lane]);
+        glm::vec3 direction(packet.directionX[lane], packet.directionY[lane], packet.directionZ[lane]);
+        inverseX[lane] = inverse(direction.x);
+        inverseY[lane] = inverse(direction.y);
+        inverseZ[lane] = inverse(direction.z);
+        size[lane] = inverseSize[lane] = 1.0f;
+        packet.block[lane] = BLOCK_AIR;
+        packet.face[lane] = -1;
+        packet.distance[lane] = INFINITY;
+
+        // Cells are whole numbers kept in floats, exact for any grid coordinate (below 2^24)
+        int enterAxis;
+        glm::ivec3 cell(0);
+        if (clipToGrid(origin, direction, INFINITY, t[lane], end[lane], enterAxis)) {
+            axis[lane] = float(enterAxis);
+            cell = startCell(origin, direction, t[lane], gridBlocks);
+            active |= 1u << lane;
+        } else {
+            t[lane] = end[lane] = 0.0f;
+            axis[lane] = -1.0f;
+        }
+        cellX[lane] = float(cell.x);
+        cellY[lane] = float(cell.y);
+        cellZ[lane] = float(cell.z);
+    }
+
+    using V = Lanes::Value;
+    V originX = Lanes::load(packet.originX), originY = Lanes::load(packet.originY), originZ = Lanes::load(packet.originZ);
+    V directionX = Lanes::load(packet.directionX), directionY = Lanes::load(packet.directionY);
+    V directionZ = Lanes::load(packet.directionZ);
+    V invX = Lanes::load(inverseX), invY = Lanes::load(inverseY), invZ = Lanes::load(inverseZ);
+    V zero = Lanes::set(0.0f), one = Lanes::set(1.0f);
+    V positiveX = Lanes::lessEqual(zero, invX), positiveY = Lanes::lessEqual(zero, invY);
+    V positiveZ = Lanes::lessEqual(zero, invZ);
+
+    while (active != 0) {
+        // The lookups are per ray; finished rays keep stepping harmlessly but are skipped here
+        for (int lane = 0; lane < PACKET_WIDTH; ++lane) {
+            if (!(active >> lane & 1)) {
+                continue;
+            }
+            ++steps;
+            BlockID block;
+            int level = classify(int(cellX[lane]), int(cellY[lane]), int(cellZ[lane]), block);
+            if (level < 0) {
+                int hitAxis = int(axis[lane]);
+                float hitInverse = hitAxis == 0 ? inverseX[lane] : hitAxis == 1 ? inverseY[lane] : inverseZ[lane];
+                packet.block[lane] = block;
+                packet.face[lane] = enteredFace(hitAxis, hitInverse);
+                packet.distance[lane] = t[lane];
+                active &= ~(1u << lane);
+            } else {
+                size[lane] = float(1 << level);
+                inverseSize[lane] = 1.0f / size[lane];
+            }
+        }
+
+        // Step every ray to where it leaves its empty cell
+        V tt = Lanes::load(t);
+        V cx = Lanes::load(cellX), cy = Lanes::load(cellY), cz = Lanes::load(cellZ);
+        V s = Lanes::load(size), is = Lanes::load(inverseSize);
+        V lowX = Lanes::mul(Lanes::floor(Lanes::mul(cx, is)), s);
+        V lowY = Lanes::mul(Lanes::floor(Lanes::mul(cy, is)), s);
+        V lowZ = Lanes::mul(Lanes::floor(Lanes::mul(cz, is)), s);
+        V crossX = Lanes::mul(Lanes::sub(Lanes::add(lowX, Lanes::select(positiveX, s, zero)), originX), invX);
+        V crossY = Lanes::mul(Lanes::sub(Lanes::add(lowY, Lanes::select(positiveY, s, zero)), originY), invY);
+        V crossZ = Lanes::mul(Lanes::sub(Lanes::add(lowZ, Lanes::select(positiveZ, s, zero)), originZ), invZ);
+        V crossYZ = Lanes::min(crossY, crossZ);
+        V firstX = Lanes::lessEqual(crossX, crossYZ), yBeforeZ = Lanes::lessEqual(crossY, crossZ);
+        V nextAxis = Lanes::select(firstX, zero, Lanes::select(yBeforeZ, one, Lanes::set(2.0f)));
+        tt = Lanes::max(Lanes::min(crossX, crossYZ), tt);
+        Lanes::store(t, tt);
+
+        // Move the cells as `traceGrid` does: the crossing axis into the next cell, the others
+        // following the ray without leaving the cell being left or moving back
+        V pointX = Lanes::floor(Lanes::add(originX, Lanes::mul(directionX, tt)));
+        V pointY = Lanes::floor(Lanes::add(originY, Lanes::mul(directionY, tt)));
+        V pointZ = Lanes::floor(Lanes::add(originZ, Lanes::mul(directionZ, tt)));
+        V highX = Lanes::sub(Lanes::add(lowX, s), one);
+        V highY = Lanes::sub(Lanes::add(lowY, s), one);
+        V highZ = Lanes::sub(Lanes::add(lowZ, s), one);
+        V followX = Lanes::select(positiveX, Lanes::min(Lanes::max(pointX, cx), highX), Lanes::max(Lanes::min(pointX, cx), lowX));
+        V followY = Lanes::select(positiveY, Lanes::min(Lanes::max(pointY, cy), highY), Lanes::max(Lanes::min(pointY, cy), lowY));
+        V followZ = Lanes::select(positiveZ, Lanes::min(Lanes::max(pointZ, cz), highZ), Lanes::max(Lanes::min(pointZ, cz), lowZ));
+        V exitX = Lanes::select(positiveX, Lanes::add(highX, one), Lanes::sub(lowX, one));
+        V exitY = Lanes::select(positiveY, Lanes::add(highY, one), Lanes::sub(lowY, one));
+        V exitZ = Lanes::select(positiveZ, Lanes::add(highZ, one), Lanes::sub(lowZ, one));
+        Lanes::store(cellX, Lanes::select(firstX, exitX, followX));
+        Lanes::store(cellY, Lanes::select(firstX, followY, Lanes::select(yBeforeZ, exitY, followY)));
+        Lanes::store(cellZ, Lanes::select(firstX, followZ, Lanes::select(yBeforeZ, followZ, exitZ)));
+
+        // Keep the entry axis of rays that just hit; they report the face they came through
+        alignas(32) float stepAxis[PACKET_WIDTH];
+        Lanes::store(stepAxis, nextAxis);
+        for (int lane = 0; lane < PACKET_WIDTH; ++lane) {
+            if (active >> lane & 1) {
+                axis[lane] = stepAxis[lane];
+                if (t[lane] >= end[lane] || unsigned(int(cellX[lane])) >= unsigned(gridBlocks.x) ||
+                    unsigned(int(cellY[lane])) >= unsigned(gridBlocks.y) ||
+                    unsigned(int(cellZ[lane])) >= unsigned(gridBlocks.z)) {
+                    active &= ~(1u << lane);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Shades a hit (or a miss, with `face` < 0).
+ */
+glm::vec3 VoxelRaytracer::shade(BlockID block, int face) const {
+    if (face < 0) {
+        return skyColor;
+    }
+
+    glm::vec3 color;
+    if (block < colors.size() && hasColor[block]) {
+        color = colors[block];
+    } else {
+        // A stable made-up color per block type
+        uint32_t hash = uint32_t(block) * 2654435761u;
+        color = glm::vec3(float(hash >> 24), float(hash >> 16 & 255), float(hash >> 8 & 255)) / 255.0f * 0.6f + 0.3f;
+    }
+    return color * FACE_LIGHT[face];
+}
@@ -0,0 +1,263 @@
+// Prevents multiple inclusions of this header file, which can cause redefinition errors
+#ifndef VOXEL_RAYTRACER_H
+#define VOXEL_RAYTRACER_H
+
+// Includes fixed-width integer types such as uint64_t
+#include <cstdint>
+
+// Includes the vector container used for the acceleration grid and depth output
+#include <vector>
+
+#include <glm/glm.hpp>                      // GLM for vector types
+#include <glm/ext/vector_int3_sized.hpp>    // GLM 64-bit integer vectors (glm::i64vec3)
+
+#include "BlockRegistry.h"  // BlockFace, used to report which face a ray hit
+#include "Chunk.h"          // Block storage
+#include "ChunkKey.h"       // The chunk map the tracer reads from
+#include "Image.h"          // Rendered images
+#include "ThreadPool.h"     // Workers that trace tiles of the image
+#include "WorldPosition.h"  // Camera positions anywhere in the world
+
+/**
+ * The `RaytraceCamera` struct describes the view a `VoxelRaytracer` renders:
+ * a perspective camera for previews, or an orthographic one for impostors.
+ */
+struct RaytraceCamera {
+    /** Where the camera is */
+    WorldPosition position;
+
+    /** The view direction (need not be normalized) */
+    glm::vec3 forward;
+
+    /** Roughly up; only used to orient the image */
+    glm::vec3 up;
+
+    /** The vertical field of view in radians (perspective cameras) */
+    float verticalFov;
+
+    /** If true, rays are parallel and the image covers `orthographicHeight` blocks vertically */
+    bool orthographic;
+    float orthographicHeight;
+
+    /** Creates a perspective camera */
+    static RaytraceCamera perspective(const WorldPosition& position, const glm::vec3& forward, const glm::vec3& up,
+                                      float verticalFov);
+
+    /** Creates an orthographic camera */
+    static RaytraceCamera orthographicView(const WorldPosition& position, const glm::vec3& forward,
+                                           const glm::vec3& up, float height);
+};
+
+/**
+ * The `RaytraceHit` struct describes where a single ray hit a block.
+ */
+struct RaytraceHit {
+    /** The block that was hit */
+    BlockID block;
+
+    /** The absolute coordinate of the block */
+    glm::i64vec3 position;
+
+    /** The face the ray entered through, or FACE_COUNT if it started inside the block */
+    int face;
+
+    /** The distance along the ray, in units of the (normalized) direction */
+    float distance;
+};
+
+/**
+ * The `RaytraceStats` struct reports the cost of one render.
+ */
+struct RaytraceStats {
+    /** The number of primary rays traced */
+    uint64_t rays;
+
+    /** The number of traversal steps, summed over every ray */
+    uint64_t steps;
+
+    /** The wall-clock time of the render */
+    double seconds;
+
+    /** Returns the throughput in millions of rays per second */
+    double getMegaRaysPerSecond() const { return seconds > 0.0 ? double(rays) / seconds * 1e-6 : 0.0; }
+};
+
+/**
+ * The `VoxelRaytracer` class renders loaded chunks straight from their block
+ * storage on the CPU, with no OpenGL: for world previews on machines without
+ * a GPU, and for the impostor images that stand in for distant terrain.
+ *
+ * `build` snapshots a box of chunks into a dense grid with three levels of
+ * occupancy above the blocks: 64-block cells (4x4x4 chunks), chunks, and
+ * 4x4x4-block bricks (one 64-bit mask per chunk). A ray steps through the
+ * coarsest empty cell containing it, so open sky and air inside chunks are
+ * crossed in a few steps instead of one per block.
+ *
+ * Rays are traced in packets of 2x2 (SSE2) or 4x2 (AVX) neighbouring pixels.
+ * The block lookups stay per ray, but the position and cell exit arithmetic
+ * runs for the whole packet at once, and neighbouring rays read the same
+ * cells while they are hot in cache. The image is split into tiles that the
+ * worker threads take in turn.
+ *
+ * The tracer keeps pointers to the chunks, so they must not be changed or
+ * unloaded between `build` and the end of a render.
+ */
+class VoxelRaytracer {
+public:
+    /**
+     * Constructor: Creates a tracer with nothing built.
+     *
+     * @param pool The workers renders are split across; `render` waits for it to go idle.
+     */
+    explicit VoxelRaytracer(ThreadPool& pool);
+
+    /**
+     * Builds the acceleration grid over a box of chunks. Chunks missing from the
+     * map, or holding only air, are treated as empty.
+     *
+     * @param chunks     The loaded chunks (for example `World::getChunks`).
+     * @param minChunk   The lowest chunk coordinate of the box.
+     * @param chunkCount The size of the box, in chunks.
+     * @return False if the box is empty or too large.
+     */
+    bool build(const ChunkMap<Chunk*>& chunks, const glm::i64vec3& minChunk, const glm::ivec3& chunkCount);
+
+    /**
+     * Builds the acceleration grid over the bounding box of every chunk in a map.
+     */
+    bool build(const ChunkMap<Chunk*>& chunks);
+
+    /**
+     * Sets the color a block type is drawn with. Block types without a color get
+     * a stable made-up one, so previews stay readable.
+     */
+    void setBlockColor(BlockID block, const glm::vec3& color);
+
+    /** Sets the color of rays that hit nothing */
+    void setSkyColor(const glm::vec3& color) { skyColor = color; }
+
+    /**
+     * Chooses between packet tracing (the default) and tracing each ray alone.
+     * Both give the same image; single rays exist for comparison.
+     */
+    void setPacketTracing(bool enabled) { packetTracing = enabled; }
+
+    /** Returns the number of rays in a packet: 8 with AVX, otherwise 4 */
+    static int getPacketWidth();
+
+    /**
+     * Renders the built chunks.
+     *
+     * @param camera        The view.
+     * @param width, height The image size in pixels.
+     * @param image         Receives the image.
+     * @param depth         If not null, receives each pixel's hit distance (top row first),
+     *                      or infinity where nothing was hit.
+     * @return The ray count and time.
+     */
+    RaytraceStats render(const RaytraceCamera& camera, int width, int height, Image& image,
+                         std::vector<float>* depth = nullptr);
+
+    /**
+     * Renders an impostor: an orthographic view of the whole built box, looking
+     * at one of its faces from outside. The square image covers the face's
+     * larger side; with `FACE_POS_Y` the depth image is a height map.
+     *
+     * @param face       The side of the box the camera looks at.
+     * @param resolution The image width and height in pixels.
+     * @param image      Receives the image.
+     * @param depth      If not null, receives each pixel's distance from the face.
+     */
+    RaytraceStats renderImpostor(BlockFace face, int resolution, Image& image, std::vector<float>* depth = nullptr);
+
+    /**
+     * Traces a single ray.
+     *
+     * @param origin      The start of the ray.
+     * @param direction   The direction (need not be normalized).
+     * @param maxDistance The furthest distance to look, in blocks.
+     * @param hit         Receives the hit.
+     * @return True if the ray hit a block.
+     */
+    bool traceRay(const WorldPosition& origin, const glm::vec3& direction, float maxDistance, RaytraceHit& hit) const;
+
+private:
+    struct RayPacket;
+
+    /**
+     * The `GridChunk` struct is one chunk of the acceleration grid.
+     */
+    struct GridChunk {
+        /** The chunk, or null if it is missing or all air */
+        const Chunk* chunk;
+
+        /** One bit per 4x4x4-block brick holding anything but air */
+        uint64_t brickMask;
+    };
+
+    /**
+     * Finds the largest empty cell containing a block coordinate, which must be inside the grid.
+     *
+     * @param block Receives the block if the coordinate is solid.
+     * @return The log2 of the empty cell's size (6, 4, 2 or 0), or -1 for a solid block.
+     */
+    int classify(int x, int y, int z, BlockID& block) const;
+
+    /**
+     * Traces one ray in grid space (blocks from the grid's lowest corner).
+     *
+     * @param position Receives the grid coordinate of the block hit.
+     * @param steps    Incremented once per traversal step.
+     * @return True if the ray hit a block.
+     */
+    bool traceGrid(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, BlockID& block, int& face,
+                   float& distance, glm::ivec3& position, uint64_t& steps) const;
+
+    /**
+     * Traces every ray of a packet at once.
+     */
+    void tracePacket(RayPacket& packet, uint64_t& steps) const;
+
+    /**
+     * Clips a ray to the grid's bounds.
+     *
+     * @param enterAxis Receives the axis of the face the ray enters through, or -1 if it starts inside.
+     * @return False if the ray misses the grid.
+     */
+    bool clipToGrid(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, float& start, float& end,
+                    int& enterAxis) const;
+
+    /**
+     * Shades a hit (or a miss, with `face` < 0).
+     */
+    glm::vec3 shade(BlockID block, int face) const;
+
+    /** The workers renders are split across */
+    ThreadPool& pool;
+
+    /** The lowest chunk coordinate of the grid */
+    glm::i64vec3 originChunk;
+
+    /** The grid's size in chunks, in blocks, and in 64-block cells */
+    glm::ivec3 gridChunks;
+    glm::ivec3 gridBlocks;
+    glm::ivec3 gridCells;
+
+    /** The chunks of the grid, laid out like `Chunk::blocks` (X fastest, then Z, then Y) */
+    std::vector<GridChunk> chunks;
+
+    /** 1 for each 64-block cell holding anything but air, laid out the same way */
+    std::vector<uint8_t> cells;
+
+    /** Colors set with `setBlockColor`, indexed by block ID */
+    std::vector<glm::vec3> colors;
+    std::vector<uint8_t> hasColor;
+
+    /** The color of rays that hit nothing */
+    glm::vec3 skyColor;
+
+    /** True to trace packets rather than single rays */
+    bool packetTracing;
+};
+
+#endif  // Ends the conditional inclusion directive
@@ -0,0 +1,404 @@
+// Includes the corresponding header file to access the World class declaration
+#include "World.h"
+
+// Includes std::fill_n, used to clear new chunks
+#include <algorithm>
+
+// Includes std::filesystem::exists, used to tell a missing world header from an unreadable one
+#include <filesystem>
+
+// Includes standard I/O for reporting recovered edits
+#include <iostream>
+
+/**
+ * Constructor: Creates a world stored in a directory (created if missing).
+ *
+ * @param directory The directory holding the region files and edit log.
+ * @param pool      The pool chunk buffers come from.
+ */
+World::World(const std::string& directory, ChunkPool& pool)
+    : directory(directory), loader(directory, pool), opened(false) {}
+
+/**
+ * Destructor: Checkpoints, then returns every loaded chunk to the pool.
+ */
+World::~World() {
+    if (opened) {
+        checkpoint();
+    }
+
+    for (auto& entry : chunks) {
+        loader.unload(entry.second);
+    }
+}
+
+/**
+ * Opens the edit log and replays any edits made after the last checkpoint.
+ *
+ * @return True if the world is ready for use.
+ */
+bool World::open() {
+    // The dictionary must be in place before any chunk is loaded. A header that exists but
+    // can't be read is fatal: without its dictionary every compressed chunk is unreadable,
+    // and training a new one would overwrite it for good
+    std::string headerPath = directory + "/world.dat";
+    if (std::filesystem::exists(headerPath)) {
+        if (!header.load(headerPath)) {
+            std::cout << "ERROR::WORLD::HEADER_UNREADABLE " << headerPath << std::endl;
+            return false;
+        }
+        if (!header.dictionary.empty()) {
+            loader.setDictionary(&header.dictionary);
+        }
+    }
+
+    if (!editLog.open(directory + "/edits.wal")) {
+        return false;
+    }
+
+    // Reapply edits that reached the log but not the region files. An edit to an unreadable
+    // chunk can't be, and truncating would destroy it: the world doesn't open, and the log is
+    // kept until the chunk is repaired
+    size_t lost = 0;
+    size_t recovered = editLog.replay([this, &lost](const ChunkKey& key, int blockIndex, BlockID block) {
+        Chunk* chunk = loadChunk(key.toCoord());
+        if (!chunk) {
+            lost++;
+            return;
+        }
+        chunk->blocks[blockIndex] = block;
+        dirty.insert(key);
+        logged.insert(key);
+    });
+
+    if (lost > 0) {
+        std::cout << "ERROR::WORLD::REPLAY_INCOMPLETE " << lost << " edits to unreadable chunks" << std::endl;
+        return false;
+    }
+    opened = true;
+
+    // Fold the recovered edits into the region files straight away
+    if (recovered > 0) {
+        std::cout << "Recovered " << recovered << " edits from the edit log" << std::endl;
+        return checkpoint();
+    }
+
+    return true;
+}
+
+/**
+ * Trains the world's compression dictionary from the loaded chunks.
+ *
+ * @param maxSamples The most chunks to train on.
+ * @return True if a dictionary was trained and saved.
+ */
+bool World::trainDictionary(size_t maxSamples) {
+    // Before `open`, the header on disk hasn't been read, so it may already hold a dictionary
+    if (!opened || !header.dictionary.empty() || chunks.empty() || maxSamples == 0) {
+        return false;
+    }
+
+    // Take an even spread of loaded chunks, in Morton order so samples cover the whole area
+    std::vector<ChunkKey> keys;
+    keys.reserve(chunks.size());
+    for (const auto& entry : chunks) {
+        keys.push_back(entry.first);
+    }
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<const Chunk*> samples;
+    size_t step = std::max<size_t>(1, keys.size() / maxSamples);
+    for (size_t i = 0; i < keys.size() && samples.size() < maxSamples; i += step) {
+        samples.push_back(chunks.at(keys[i]));
+    }
+
+    WorldHeader trained = header;
+    trained.dictionary = ChunkDictionary::train(samples);
+    if (trained.dictionary.empty() || !trained.save(directory + "/world.dat")) {
+        return false;
+    }
+
+    header = std::move(trained);
+    loader.setDictionary(&header.dictionary);
+    return true;
+}
+
+/**
+ * Returns a loaded chunk, or nullptr if it isn't loaded.
+ */
+Chunk* World::getChunk(const glm::i64vec3& coord) const {
+    auto found = chunks.find(ChunkKey(coord));
+    return found != chunks.end() ? found->second : nullptr;
+}
+
+/**
+ * Returns a chunk, loading it from disk (or creating an empty one) if needed.
+ * Returns nullptr if the chunk is stored but can't be read.
+ */
+Chunk* World::loadChunk(const glm::i64vec3& coord) {
+    ChunkKey key(coord);
+
+    auto found = chunks.find(key);
+    if (found != chunks.end()) {
+        return found->second;
+    }
+    if (unreadable.count(key) > 0) {
+        return nullptr;
+    }
+
+    ChunkLoadStatus status;
+    Chunk* chunk = loader.load(coord, status);
+    if (status == CHUNK_LOAD_FAILED) {
+        // An empty stand-in would be saved over the stored data; leave the chunk unloaded instead
+        std::cout << "ERROR::WORLD::CHUNK_UNREADABLE " << coord.x << " " << coord.y << " " << coord.z << std::endl;
+        unreadable.insert(key);
+        return nullptr;
+    }
+    if (!chunk) {
+        // Nothing stored yet: start from an empty chunk
+        chunk = loader.getPool().acquire();
+        std::fill_n(chunk->blocks, CHUNK_VOLUME, BLOCK_AIR);
+    }
+
+    chunks.emplace(key, chunk);
+    return chunk;
+}
+
+/**
+ * Adds a chunk that was produced elsewhere.
+ *
+ * @param coord The chunk coordinate.
+ * @param chunk A chunk taken from the world's pool.
+ * @param dirty If true, the chunk will be saved at the next checkpoint.
+ */
+void World::insertChunk(const glm::i64vec3& coord, Chunk* chunk, bool dirty) {
+    ChunkKey key(coord);
+
+    Chunk*& slot = chunks[key];
+    if (slot && slot != chunk) {
+        loader.unload(slot);
+    }
+    slot = chunk;
+
+    if (dirty) {
+        this->dirty.insert(key);
+    }
+}
+
+/**
+ * Saves a chunk if it is dirty, then returns it to the pool.
+ *
+ * @return False if the save failed; the chunk then stays loaded and dirty.
+ */
+bool World::unloadChunk(const glm::i64vec3& coord) {
+    ChunkKey key(coord);
+
+    auto found = chunks.find(key);
+    if (found == chunks.end()) {
+        return true;
+    }
+
+    // The chunk's edits may only exist in the log; save it so the log can still be truncated later.
+    // If that fails, the chunk is kept, so the next checkpoint retries instead of truncating past it
+    if (dirty.count(key) > 0) {
+        if (!loader.save(coord, *found->second)) {
+            std::cout << "ERROR::WORLD::UNLOAD_SAVE_FAILED " << coord.x << " " << coord.y << " " << coord.z
+                      << std::endl;
+            return false;
+        }
+        dirty.erase(key);
+    }
+
+    loader.unload(found->second);
+    chunks.erase(found);
+    return true;
+}
+
+/**
+ * Returns the block at an absolute block coordinate, or air if its chunk isn't loaded.
+ */
+BlockID World::getBlock(const glm::i64vec3& block) const {
+    glm::i64vec3 coord;
+    int blockIndex;
+    splitBlock(block, coord, blockIndex);
+
+    const Chunk* chunk = getChunk(coord);
+    return chunk ? chunk->blocks[blockIndex] : BLOCK_AIR;
+}
+
+/**
+ * Changes the block at an absolute block coordinate, loading its chunk if needed.
+ *
+ * @param block The absolute block coordinate.
+ * @param id    The new block ID.
+ */
+void World::setBlock(const glm::i64vec3& block, BlockID id) {
+    glm::i64vec3 coord;
+    int blockIndex;
+    splitBlock(block, coord, blockIndex);
+
+    ChunkKey key(coord);
+    Chunk* chunk = loadChunk(coord);
+    if (!chunk) {
+        return;
+    }
+    chunk->blocks[blockIndex] = id;
+
+    // Log the edit instead of rewriting the chunk; the chunk itself is saved at the next checkpoint
+    if (opened) {
+        editLog.append(key, blockIndex, id);
+        logged.insert(key);
+    }
+    dirty.insert(key);
+}
+
+/**
+ * Copies a box of blocks out of the world, loading chunks as needed.
+ *
+ * @param min  The lowest corner of the box, as an absolute block coordinate.
+ * @param size The size of the box, in blocks.
+ * @return The copied blocks.
+ */
+BlockVolume World::copyVolume(const glm::i64vec3& min, const glm::ivec3& size) {
+    BlockVolume volume(size);
+    glm::ivec3 chunkSize(CHUNK_SIZE);
+
+    visitBox(min, volume.getSize(), [&](const ChunkKey&, Chunk* chunk, const glm::ivec3& chunkMin,
+                                        const glm::ivec3& volumeMin, const glm::ivec3& extent) {
+        BlockVolume::copyRegion(chunk->blocks, chunkSize, chunkMin, volume.getData(), volume.getSize(), volumeMin, extent);
+    });
+
+    return volume;
+}
+
+/**
+ * Writes a box of blocks into the world (air included), loading chunks as needed.
+ * Checkpoints first if the log holds edits to any chunk the box touches.
+ *
+ * @param volume The blocks to paste.
+ * @param min    Where the volume's first corner lands, as an absolute block coordinate.
+ * @return False if that checkpoint failed; nothing is pasted then.
+ */
+bool World::pasteVolume(const BlockVolume& volume, const glm::i64vec3& min) {
+    // Those edits are older than the paste; fold them into the region files before
+    // any pasted chunk can be saved, so replay never applies them on top of it
+    if (hasLoggedEdits(min, volume.getSize()) && !checkpoint()) {
+        std::cout << "ERROR::WORLD::PASTE_CHECKPOINT_FAILED" << std::endl;
+        return false;
+    }
+
+    glm::ivec3 chunkSize(CHUNK_SIZE);
+
+    visitBox(min, volume.getSize(), [&](const ChunkKey& key, Chunk* chunk, const glm::ivec3& chunkMin,
+                                        const glm::ivec3& volumeMin, const glm::ivec3& extent) {
+        BlockVolume::copyRegion(volume.getData(), volume.getSize(), volumeMin, chunk->blocks, chunkSize, chunkMin, extent);
+        dirty.insert(key);
+    });
+    return true;
+}
+
+/**
+ * Returns true if the log holds edits to any chunk a box overlaps.
+ */
+bool World::hasLoggedEdits(const glm::i64vec3& min, const glm::ivec3& size) const {
+    if (logged.empty() || size.x <= 0 || size.y <= 0 || size.z <= 0) {
+        return false;
+    }
+
+    glm::i64vec3 firstChunk = WorldPosition::fromBlock(min).chunk;
+    glm::i64vec3 lastChunk = WorldPosition::fromBlock(min + glm::i64vec3(size) - glm::i64vec3(1)).chunk;
+
+    glm::i64vec3 coord;
+    for (coord.y = firstChunk.y; coord.y <= lastChunk.y; ++coord.y) {
+        for (coord.z = firstChunk.z; coord.z <= lastChunk.z; ++coord.z) {
+            for (coord.x = firstChunk.x; coord.x <= lastChunk.x; ++coord.x) {
+                if (logged.count(ChunkKey(coord)) > 0) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * Calls `visit` for the part of a box inside each chunk it overlaps, loading the chunks as needed.
+ */
+template <typename Visitor>
+void World::visitBox(const glm::i64vec3& min, const glm::ivec3& size, Visitor visit) {
+    if (size.x <= 0 || size.y <= 0 || size.z <= 0) {
+        return;
+    }
+
+    glm::i64vec3 max = min + glm::i64vec3(size) - glm::i64vec3(1);
+    glm::i64vec3 firstChunk = WorldPosition::fromBlock(min).chunk;
+    glm::i64vec3 lastChunk = WorldPosition::fromBlock(max).chunk;
+
+    glm::i64vec3 coord;
+    for (coord.y = firstChunk.y; coord.y <= lastChunk.y; ++coord.y) {
+        for (coord.z = firstChunk.z; coord.z <= lastChunk.z; ++coord.z) {
+            for (coord.x = firstChunk.x; coord.x <= lastChunk.x; ++coord.x) {
+                // Clip the box to this chunk, in absolute block coordinates
+                glm::i64vec3 chunkOrigin = coord * int64_t(CHUNK_SIZE);
+                glm::i64vec3 from = glm::max(min, chunkOrigin);
+                glm::i64vec3 to = glm::min(max, chunkOrigin + glm::i64vec3(CHUNK_SIZE - 1));
+
+                // Unreadable chunks are skipped: copies get air there, and pastes leave them alone
+                Chunk* chunk = loadChunk(coord);
+                if (chunk) {
+                    visit(ChunkKey(coord), chunk, glm::ivec3(from - chunkOrigin),
+                          glm::ivec3(from - min), glm::ivec3(to - from) + glm::ivec3(1));
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Saves every dirty chunk to its region file, syncs the region files, then
+ * empties the edit log.
+ *
+ * @return True if every chunk was saved and synced and the log was truncated.
+ */
+bool World::checkpoint() {
+    // Save in Morton order, so chunks sharing a region are written together
+    std::vector<ChunkKey> keys(dirty.begin(), dirty.end());
+    std::sort(keys.begin(), keys.end());
+
+    // A dirty chunk that isn't loaded can't be saved, so it fails the checkpoint too
+    bool saved = true;
+    for (const ChunkKey& key : keys) {
+        auto found = chunks.find(key);
+        if (found == chunks.end() || !loader.save(key.toCoord(), *found->second)) {
+            saved = false;
+        }
+    }
+
+    // The log may only be emptied once every chunk it covers is safely on disk. Chunks
+    // `unloadChunk` saved since the last checkpoint are synced here too
+    if (!saved || !loader.syncSaved()) {
+        std::cout << "ERROR::WORLD::CHECKPOINT_FAILED the edit log is kept" << std::endl;
+        return false;
+    }
+
+    dirty.clear();
+    if (opened && !editLog.truncate()) {
+        return false;
+    }
+
+    logged.clear();
+    return true;
+}
+
+/**
+ * Splits an absolute block coordinate into a chunk coordinate and a block index inside it.
+ *
+ * @param block      The absolute block coordinate.
+ * @param chunk      Receives the chunk coordinate.
+ * @param blockIndex Receives the index inside the chunk.
+ */
+void World::splitBlock(const glm::i64vec3& block, glm::i64vec3& chunk, int& blockIndex) {
+    WorldPosition position = WorldPosition::fromBlock(block);
+    chunk = position.chunk;
+    blockIndex = Chunk::index(int(position.local.x), int(position.local.y), int(position.local.z));
+}
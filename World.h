@@ -0,0 +1,211 @@
+// Prevents multiple inclusions of this header file, which can cause redefinition errors
+#ifndef WORLD_H
+#define WORLD_H
+
+// Includes the C++ Standard Library string class, used for the world directory
+#include <string>
+
+// Includes the set container used to track dirty chunks
+#include <unordered_set>
+
+#include <glm/glm.hpp>                      // GLM for vector types
+#include <glm/ext/vector_int3_sized.hpp>    // GLM 64-bit integer vectors (glm::i64vec3)
+
+#include "BlockVolume.h"    // Boxes of blocks for copy and paste
+#include "Chunk.h"          // Block storage
+#include "ChunkKey.h"       // Keys for the loaded chunk map
+#include "ChunkLoader.h"    // Reads and writes chunks in region files
+#include "ChunkPool.h"      // Recycled chunk buffers
+#include "EditLog.h"        // Write-ahead log of block edits
+#include "WorldHeader.h"    // World-wide settings, including the compression dictionary
+
+/**
+ * The `World` class owns the loaded chunks of a world and applies block edits.
+ *
+ * Edits are made durable through an `EditLog` rather than by saving the chunk:
+ * `setBlock` changes the loaded chunk, appends a 16-byte record to the log and
+ * marks the chunk dirty. `checkpoint` later saves every dirty chunk to its
+ * region file and empties the log. After a crash, `open` replays whatever the
+ * log holds on top of the region files, so no acknowledged edit is lost.
+ */
+class World {
+public:
+    /**
+     * Constructor: Creates a world stored in a directory (created if missing).
+     *
+     * @param directory The directory holding the region files and edit log.
+     * @param pool      The pool chunk buffers come from.
+     */
+    World(const std::string& directory, ChunkPool& pool);
+
+    /**
+     * Destructor: Checkpoints, then returns every loaded chunk to the pool.
+     */
+    ~World();
+
+    /**
+     * Opens the edit log and replays any edits made after the last checkpoint.
+     *
+     * @return True if the world is ready for use. False if `world.dat` exists but can't be
+     *         read, or if an edit in the log belongs to a chunk that can't be read; the
+     *         header and the log are then left as they are, for repair.
+     */
+    bool open();
+
+    /**
+     * Trains the world's compression dictionary from the loaded chunks and
+     * stores it in the world header. Chunks saved from then on use it.
+     * A world only ever has one dictionary, since stored payloads depend on it.
+     * Requires an opened world, so the header on disk has been read.
+     *
+     * @param maxSamples The most chunks to train on (spread over all loaded chunks).
+     * @return True if a dictionary was trained and saved.
+     */
+    bool trainDictionary(size_t maxSamples = 256);
+
+    /** Returns the world header */
+    const WorldHeader& getHeader() const { return header; }
+
+    /**
+     * Returns a loaded chunk, or nullptr if it isn't loaded.
+     */
+    Chunk* getChunk(const glm::i64vec3& coord) const;
+
+    /**
+     * Returns a chunk, loading it from disk (or creating an empty one) if needed.
+     *
+     * @return The chunk, or nullptr if it is stored but can't be read. Such a
+     *         chunk is never replaced, so its data on disk is kept for repair.
+     */
+    Chunk* loadChunk(const glm::i64vec3& coord);
+
+    /**
+     * Adds a chunk that was produced elsewhere (for example, by the terrain generator).
+     * The world takes ownership; any chunk already loaded at `coord` is released.
+     *
+     * @param coord The chunk coordinate.
+     * @param chunk A chunk taken from the world's pool.
+     * @param dirty If true, the chunk will be saved at the next checkpoint.
+     */
+    void insertChunk(const glm::i64vec3& coord, Chunk* chunk, bool dirty);
+
+    /**
+     * Saves a chunk if it is dirty, then returns it to the pool.
+     *
+     * @return False if the save failed. The chunk then stays loaded and dirty, and
+     *         `checkpoint` fails (keeping the edit log) until it is saved.
+     */
+    bool unloadChunk(const glm::i64vec3& coord);
+
+    /**
+     * Returns the block at an absolute block coordinate, or air if its chunk isn't loaded.
+     */
+    BlockID getBlock(const glm::i64vec3& block) const;
+
+    /**
+     * Changes the block at an absolute block coordinate, loading its chunk if needed.
+     * The edit is logged, and is durable once the log's next group commit completes.
+     * Edits to a chunk that can't be read are dropped.
+     *
+     * @param block The absolute block coordinate.
+     * @param id    The new block ID.
+     */
+    void setBlock(const glm::i64vec3& block, BlockID id);
+
+    /**
+     * Copies a box of blocks out of the world, loading chunks as needed.
+     *
+     * @param min  The lowest corner of the box, as an absolute block coordinate.
+     * @param size The size of the box, in blocks.
+     * @return The copied blocks.
+     */
+    BlockVolume copyVolume(const glm::i64vec3& min, const glm::ivec3& size);
+
+    /**
+     * Writes a box of blocks into the world (air included), loading chunks as needed.
+     *
+     * Unlike `setBlock`, pastes are not logged: one record per block would cost
+     * far more than saving the touched chunks, so they are only marked dirty
+     * and become durable at the next `checkpoint`.
+     *
+     * Replay must never apply a logged edit on top of newer pasted blocks, which
+     * it would once a pasted chunk is saved early (by `unloadChunk`). So if the
+     * log holds edits to any chunk the paste touches, the world checkpoints first.
+     *
+     * @param volume The blocks to paste.
+     * @param min    Where the volume's first corner lands, as an absolute block coordinate.
+     * @return False if that checkpoint failed; nothing is pasted then.
+     */
+    bool pasteVolume(const BlockVolume& volume, const glm::i64vec3& min);
+
+    /**
+     * Saves every dirty chunk to its region file, syncs the region files, then
+     * empties the edit log. Call from the same thread that calls `setBlock`.
+     *
+     * @return True if every chunk was saved and synced and the log was truncated.
+     */
+    bool checkpoint();
+
+    /** Returns the number of chunks waiting for the next checkpoint */
+    size_t getDirtyCount() const { return dirty.size(); }
+
+    /** Returns every loaded chunk, keyed by chunk coordinate */
+    const ChunkMap<Chunk*>& getChunks() const { return chunks; }
+
+    /** Returns the loader used for region files */
+    ChunkLoader& getLoader() { return loader; }
+
+    /** Returns the edit log */
+    EditLog& getEditLog() { return editLog; }
+
+    /**
+     * Splits an absolute block coordinate into a chunk coordinate and a block index inside it.
+     *
+     * @param block      The absolute block coordinate.
+     * @param chunk      Receives the chunk coordinate.
+     * @param blockIndex Receives the index inside the chunk (see `Chunk::index`).
+     */
+    static void splitBlock(const glm::i64vec3& block, glm::i64vec3& chunk, int& blockIndex);
+
+private:
+    /**
+     * Returns true if the log holds edits to any chunk a box overlaps.
+     */
+    bool hasLoggedEdits(const glm::i64vec3& min, const glm::ivec3& size) const;
+
+    /**
+     * Calls `visit(chunkKey, chunk, chunkMin, volumeMin, extent)` for the part of a box
+     * inside each chunk it overlaps, loading the chunks as needed.
+     */
+    template <typename Visitor>
+    void visitBox(const glm::i64vec3& min, const glm::ivec3& size, Visitor visit);
+
+    /** The directory holding the region files and edit log */
+    std::string directory;
+
+    /** World-wide settings, loaded by `open` */
+    WorldHeader header;
+
+    /** Reads and writes chunks in region files */
+    ChunkLoader loader;
+
+    /** The loaded chunks */
+    ChunkMap<Chunk*> chunks;
+
+    /** Chunks changed since the last checkpoint */
+    std::unordered_set<ChunkKey, ChunkKeyHash> dirty;
+
+    /** Chunks with edits in the log, which `checkpoint` empties */
+    std::unordered_set<ChunkKey, ChunkKeyHash> logged;
+
+    /** Chunks whose stored payload failed to load; they are left unloaded */
+    std::unordered_set<ChunkKey, ChunkKeyHash> unreadable;
+
+    /** The write-ahead log of block edits */
+    EditLog editLog;
+
+    /** True once `open` has succeeded */
+    bool opened;
+};
+
+#endif  // Ends the conditional inclusion directive
@@ -0,0 +1,86 @@
+// Includes the corresponding header file to access the WorldHeader declaration
+#include "WorldHeader.h"
+
+// Includes std::filesystem::rename, used to replace the header atomically
+#include <filesystem>
+
+// Includes standard I/O for printing error messages to the console
+#include <iostream>
+
+// Includes the File class used for reading and writing
+#include "File.h"
+
+/**
+ * Reads the header from a file.
+ *
+ * @param path The path of the header file.
+ * @return True if the file exists and is valid.
+ */
+bool WorldHeader::load(const std::string& path) {
+    File file;
+    if (!file.open(path, false)) {
+        return false;
+    }
+
+    uint32_t fields[4] = { 0, 0, 0, 0 };
+    if (!file.readAt(fields, sizeof(fields), 0) || fields[0] != MAGIC || fields[1] != VERSION) {
+        std::cout << "ERROR::WORLD_HEADER::INVALID_HEADER " << path << std::endl;
+        return false;
+    }
+
+    // A corrupt length must not turn into a huge allocation
+    if (fields[3] > file.size() - sizeof(fields)) {
+        std::cout << "ERROR::WORLD_HEADER::TRUNCATED_DICTIONARY " << path << std::endl;
+        return false;
+    }
+
+    ChunkDictionary loaded;
+    loaded.id = fields[2];
+    loaded.content.resize(fields[3]);
+    if (fields[3] > 0 && !file.readAt(loaded.content.data(), loaded.content.size(), sizeof(fields))) {
+        std::cout << "ERROR::WORLD_HEADER::TRUNCATED_DICTIONARY " << path << std::endl;
+        return false;
+    }
+
+    dictionary = std::move(loaded);
+    return true;
+}
+
+/**
+ * Writes the header to a file, atomically replacing any previous version.
+ *
+ * @param path The path of the header file.
+ * @return True on success.
+ */
+bool WorldHeader::save(const std::string& path) const {
+    std::string tempPath = path + ".tmp";
+
+    // Write and sync a complete copy first, so a crash never leaves a half-written header
+    {
+        File file;
+        uint32_t fields[4] = { MAGIC, VERSION, dictionary.id, uint32_t(dictionary.content.size()) };
+        if (!file.open(tempPath, true, true) ||
+            !file.writeAt(fields, sizeof(fields), 0) ||
+            !file.writeAt(dictionary.content.data(), dictionary.content.size(), sizeof(fields)) ||
+            !file.sync()) {
+            std::cout << "ERROR::WORLD_HEADER::WRITE_FAILED " << tempPath << std::endl;
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, path, error);
+    if (error) {
+        std::cout << "ERROR::WORLD_HEADER::RENAME_FAILED " << path << " " << error.message() << std::endl;
+        return false;
+    }
+
+    // Until the directory is synced, a crash could lose the rename while chunks compressed
+    // with the new dictionary are already on disk
+    if (!File::syncDirectoryOf(path)) {
+        std::cout << "ERROR::WORLD_HEADER::SYNC_FAILED " << path << std::endl;
+        return false;
+    }
+
+    return true;
+}
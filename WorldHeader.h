@@ -0,0 +1,48 @@
+// Prevents multiple inclusions of this header file, which can cause redefinition errors
+#ifndef WORLD_HEADER_H
+#define WORLD_HEADER_H
+
+// Includes fixed-width integer types such as uint32_t
+#include <cstdint>
+
+// Includes the C++ Standard Library string class, used for the header path
+#include <string>
+
+// Includes the compression dictionary stored in the header
+#include "ChunkDictionary.h"
+
+/**
+ * The `WorldHeader` struct holds world-wide settings stored once per world,
+ * in `world.dat` next to the region files.
+ *
+ * Layout: magic, version, dictionary ID, dictionary length (all 32-bit native
+ * byte order), then the dictionary bytes.
+ */
+struct WorldHeader {
+    /** Identifies a world header ("KYWD") */
+    static constexpr uint32_t MAGIC = 0x4457594b;
+
+    /** The current file format version */
+    static constexpr uint32_t VERSION = 1;
+
+    /** The dictionary every FORMAT_LZ chunk payload in the world is compressed with */
+    ChunkDictionary dictionary;
+
+    /**
+     * Reads the header from a file.
+     *
+     * @param path The path of the header file.
+     * @return True if the file exists and is valid.
+     */
+    bool load(const std::string& path);
+
+    /**
+     * Writes the header to a file, atomically replacing any previous version.
+     *
+     * @param path The path of the header file.
+     * @return True on success.
+     */
+    bool save(const std::string& path) const;
+};
+
+#endif  // Ends the conditional inclusion directive
@@ -0,0 +1,109 @@
+// Includes the corresponding header file to access the WorldPosition declaration
+#include "WorldPosition.h"
+
+// Includes std::floor for splitting offsets into whole chunks
+#include <cmath>
+
+#include <glm/gtc/matrix_transform.hpp> // GLM for matrix transformations
+
+/**
+ * Constructor: Creates a position at the world origin.
+ */
+WorldPosition::WorldPosition() : chunk(0), local(0.0f) {}
+
+/**
+ * Constructor: Creates a position from a chunk coordinate and an offset inside it.
+ *
+ * @param chunk The chunk coordinate.
+ * @param local The offset from the chunk's minimum corner, in blocks.
+ */
+WorldPosition::WorldPosition(const glm::i64vec3& chunk, const glm::vec3& local)
+    : chunk(chunk), local(local) {
+    normalize();
+}
+
+/**
+ * Creates a position from absolute integer block coordinates.
+ *
+ * @param block The block coordinate.
+ * @return The position of the block's minimum corner.
+ */
+WorldPosition WorldPosition::fromBlock(const glm::i64vec3& block) {
+    WorldPosition position;
+
+    for (int axis = 0; axis < 3; ++axis) {
+        // Floor division, so negative blocks land in the chunk below zero
+        int64_t chunkCoord = block[axis] / CHUNK_SIZE;
+        if (block[axis] % CHUNK_SIZE != 0 && block[axis] < 0) {
+            chunkCoord -= 1;
+        }
+
+        position.chunk[axis] = chunkCoord;
+        position.local[axis] = static_cast<float>(block[axis] - chunkCoord * CHUNK_SIZE);
+    }
+
+    return position;
+}
+
+/**
+ * Moves the position by a small offset.
+ *
+ * @param delta The offset to apply, in blocks.
+ * @return A reference to this position.
+ */
+WorldPosition& WorldPosition::operator+=(const glm::vec3& delta) {
+    local += delta;
+    normalize();
+    return *this;
+}
+
+/**
+ * Computes the offset of this position from another one.
+ *
+ * @param origin The position to measure from.
+ * @return The offset from `origin` to this position, in blocks.
+ */
+glm::vec3 WorldPosition::relativeTo(const WorldPosition& origin) const {
+    // The chunk difference is exact in 64-bit integers; only the (small) result is converted
+    glm::i64vec3 chunkDelta = chunk - origin.chunk;
+    glm::vec3 blockDelta = glm::vec3(chunkDelta * static_cast<int64_t>(CHUNK_SIZE));
+
+    return blockDelta + (local - origin.local);
+}
+
+/**
+ * Converts the position to absolute double precision coordinates.
+ */
+glm::dvec3 WorldPosition::toDouble() const {
+    return glm::dvec3(chunk * static_cast<int64_t>(CHUNK_SIZE)) + glm::dvec3(local);
+}
+
+/**
+ * Moves whole chunks out of `local` and into `chunk`.
+ */
+void WorldPosition::normalize() {
+    for (int axis = 0; axis < 3; ++axis) {
+        float wholeChunks = std::floor(local[axis] / CHUNK_SIZE);
+        if (wholeChunks != 0.0f) {
+            chunk[axis] += static_cast<int64_t>(wholeChunks);
+            local[axis] -= wholeChunks * CHUNK_SIZE;
+        }
+
+        // Rounding can leave a value of exactly CHUNK_SIZE (e.g. -1e-9 + 16); fold it over
+        if (local[axis] >= CHUNK_SIZE) {
+            chunk[axis] += 1;
+            local[axis] -= CHUNK_SIZE;
+        }
+    }
+}
+
+/**
+ * Builds a model matrix that places an object relative to the camera.
+ *
+ * @param object The world position of the object's origin.
+ * @param camera The world position of the camera.
+ * @return A translation matrix from object space to camera-relative space.
+ */
+glm::mat4 cameraRelativeModel(const WorldPosition& object, const WorldPosition& camera) {
+    return glm::translate(glm::mat4(1.0f), object.relativeTo(camera));
+}
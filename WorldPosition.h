@@ -0,0 +1,99 @@
+// Prevents multiple inclusions of this header file, which can cause redefinition errors
+#ifndef WORLD_POSITION_H
+#define WORLD_POSITION_H
+
+// Includes fixed-width integer types such as int64_t
+#include <cstdint>
+
+#include <glm/glm.hpp>                      // GLM for vector and matrix types
+#include <glm/ext/vector_int3_sized.hpp>    // GLM 64-bit integer vectors (glm::i64vec3)
+
+/** The edge length of a chunk, in blocks */
+constexpr int CHUNK_SIZE = 16;
+
+/**
+ * The `WorldPosition` struct stores a location anywhere in the world without
+ * losing precision far from the origin.
+ *
+ * A single `float` only has 24 bits of mantissa, so once a coordinate grows past
+ * roughly 100,000 blocks the spacing between representable values becomes visible
+ * as jitter. Instead, a position is split into:
+ * - A 64-bit integer chunk coordinate (exact at any distance)
+ * - A small float offset inside that chunk (always in [0, CHUNK_SIZE))
+ *
+ * Rendering and physics never use the absolute value directly. They ask for the
+ * offset relative to some nearby origin (the camera, or the physics origin),
+ * which is always small and therefore precise.
+ */
+struct WorldPosition {
+    /** The coordinate of the chunk containing this position */
+    glm::i64vec3 chunk;
+
+    /** The offset inside the chunk, in blocks */
+    glm::vec3 local;
+
+    /**
+     * Constructor: Creates a position at the world origin.
+     */
+    WorldPosition();
+
+    /**
+     * Constructor: Creates a position from a chunk coordinate and an offset inside it.
+     * The offset may lie outside the chunk; it is normalized automatically.
+     *
+     * @param chunk The chunk coordinate.
+     * @param local The offset from the chunk's minimum corner, in blocks.
+     */
+    WorldPosition(const glm::i64vec3& chunk, const glm::vec3& local);
+
+    /**
+     * Creates a position from absolute integer block coordinates.
+     *
+     * @param block The block coordinate (exact, any distance from the origin).
+     * @return The position of the block's minimum corner.
+     */
+    static WorldPosition fromBlock(const glm::i64vec3& block);
+
+    /**
+     * Moves the position by a small offset (for example, one frame of movement).
+     *
+     * @param delta The offset to apply, in blocks.
+     * @return A reference to this position.
+     */
+    WorldPosition& operator+=(const glm::vec3& delta);
+
+    /**
+     * Computes the offset of this position from another one.
+     * The chunk difference is taken in integers before converting to float,
+     * so the result is exact as long as the two positions are close together.
+     *
+     * @param origin The position to measure from (usually the camera).
+     * @return The offset from `origin` to this position, in blocks.
+     */
+    glm::vec3 relativeTo(const WorldPosition& origin) const;
+
+    /**
+     * Converts the position to absolute double precision coordinates.
+     * Useful for display and serialization, not for rendering.
+     */
+    glm::dvec3 toDouble() const;
+
+    /**
+     * Moves whole chunks out of `local` and into `chunk`, so that every
+     * component of `local` ends up in [0, CHUNK_SIZE).
+     */
+    void normalize();
+};
+
+/**
+ * Builds a model matrix that places an object relative to the camera.
+ * Combined with a view matrix whose eye sits at the origin, this keeps every
+ * value sent to the GPU small, no matter how far the camera is from the world origin.
+ *
+ * @param object The world position of the object's origin.
+ * @param camera The world position of the camera.
+ * @return A translation matrix from object space to camera-relative space.
+ */
+glm::mat4 cameraRelativeModel(const WorldPosition& object, const WorldPosition& camera);
+
+#endif  // Ends the conditional inclusion directive
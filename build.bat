@@ -1,6 +1,6 @@
 @echo off
 echo Building Voxel Engine...
-cl /EHsc main.cpp Mesh.cpp Shader.cpp /I "C:\SDL2\include" /I "C:\GLEW\include" /I "C:\Kybus Engine\glm" /link /LIBPATH:"C:\SDL2\lib\x86" /LIBPATH:"C:\GLEW\lib\Release\Win32" SDL2.lib SDL2main.lib shell32.lib glew32.lib opengl32.lib /SUBSYSTEM:CONSOLE
+cl /EHsc main.cpp Mesh.cpp Shader.cpp WorldPosition.cpp FloatingOrigin.cpp File.cpp ChunkPool.cpp ChunkCodec.cpp RegionFile.cpp ChunkLoader.cpp ThreadPool.cpp RegionIO.cpp ThreadPoolIOBackend.cpp RegionCompactor.cpp EditLog.cpp World.cpp LZCodec.cpp ChunkDictionary.cpp WorldHeader.cpp BlockVolume.cpp SchematicWriter.cpp SchematicReader.cpp BlockRegistry.cpp ChunkMesher.cpp ShaderLibrary.cpp ShaderWatcher.cpp GpuProfiler.cpp GLStateCache.cpp DrawList.cpp RenderBackend.cpp GLRenderBackend.cpp RecordingRenderBackend.cpp Image.cpp VoxelRaytracer.cpp TerrainClipmap.cpp ViewDistanceController.cpp ChunkStreamer.cpp LodSelector.cpp ChunkLifecycle.cpp /I "C:\SDL2\include" /I "C:\GLEW\include" /I "C:\Kybus Engine\glm" /link /LIBPATH:"C:\SDL2\lib\x86" /LIBPATH:"C:\GLEW\lib\Release\Win32" SDL2.lib SDL2main.lib shell32.lib glew32.lib opengl32.lib /SUBSYSTEM:CONSOLE
 if %ERRORLEVEL% NEQ 0 (
     echo Build failed!
     pause
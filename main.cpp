@@ -4,11 +4,25 @@
 #include <GL/glew.h>                // GLEW for OpenGL function loading
 #include <iostream>                 // Standard I/O for debugging and messages
 #include <vector>                   // Vector container for storing mesh data
+#include <string>                   // Command line arguments
+#include <chrono>                   // Wall-clock timing of offscreen benchmark runs
+#include <algorithm>                // std::max
+#include <cstdlib>                  // std::atoi for numeric arguments
 #include <glm/glm.hpp>                  // GLM for matrix operations
 #include <glm/gtc/type_ptr.hpp>         // GLM for matrix transformations
 #include <glm/gtc/matrix_transform.hpp> // GLM for matrix transformations
 #include "Shader.h"      // Custom Shader class for handling GLSL shaders
+#include "ShaderLibrary.h" // Loads shader programs and their feature permutations from disk
+#include "GpuProfiler.h" // CPU and GPU time per render pass
+#include "DrawList.h"    // Draws sorted by program and depth, so consecutive draws share binds and hidden fragments are skipped
+#include "GLStateCache.h" // Skips redundant binds and counts GL state changes
+#include "GLRenderBackend.h" // Sends meshes' and shaders' GL calls to the OpenGL context
 #include "Mesh.h"        // Custom Mesh class for handling OpenGL mesh rendering
+#include "WorldPosition.h" // Large-world coordinates for camera-relative rendering
+#include "Image.h"       // Saves and compares rendered frames for visual regression checks
+#ifdef KYBUS_HAVE_EGL
+#include "OffscreenContext.h" // Windowless OpenGL context for CI render benchmarks
+#endif
 
 // Jolt physics headers
 #include "Jolt/Jolt.h"
@@ -28,78 +42,140 @@
 /**
  * Entry point of the application.
  * Initializes SDL, creates an OpenGL context, sets up shaders and a rotating 2D quad.
+ *
+ * With --offscreen, no window is opened: a fixed number of frames is rendered into an
+ * offscreen framebuffer (EGL, so it runs on a software renderer like llvmpipe in CI),
+ * the frame time is printed and the last frame can be saved and compared:
+ *
+ *   KybusEngine --offscreen --frames=300 --output=frame.ppm --compare=reference.ppm
+ *
+ * The exit code is nonzero if the frame differs from the reference.
  */
 int main(int argc, char* argv[]) {
-    // --- Initialize SDL ---
-    if (SDL_Init(SDL_INIT_VIDEO) < 0) { // Initialize only the video subsystem
-        std::cout << "SDL could not initialize! SDL_Error: " << SDL_GetError() << std::endl;
-        return 1;
+    // --- Parse Command Line ---
+    bool offscreen = false;      // Render without a window
+    int benchmarkFrames = 300;   // Frames rendered in offscreen mode
+    std::string outputPath;      // Where the last offscreen frame is saved
+    std::string comparePath;     // Reference image the last offscreen frame must match
+    int compareTolerance = 2;    // Channel difference allowed for driver rounding
+    bool depthPrepass = false;   // Lay down depth in a pass of its own before shading
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--offscreen") {
+            offscreen = true;
+        } else if (arg.rfind("--frames=", 0) == 0) {
+            benchmarkFrames = std::max(1, std::atoi(arg.c_str() + 9));
+        } else if (arg.rfind("--output=", 0) == 0) {
+            outputPath = arg.substr(9);
+        } else if (arg.rfind("--compare=", 0) == 0) {
+            comparePath = arg.substr(10);
+        } else if (arg.rfind("--tolerance=", 0) == 0) {
+            compareTolerance = std::atoi(arg.c_str() + 12);
+        } else if (arg == "--depth-prepass") {
+            depthPrepass = true;
+        } else {
+            std::cout << "Unknown argument: " << arg << std::endl;
+        }
     }
 
-    // --- Set OpenGL Attributes ---
-    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 3);  // Use OpenGL 3.3
-    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 3);
-    SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE); // Use core profile
-
-    // --- Create SDL Window ---
-    SDL_Window* window = SDL_CreateWindow(
-        "Voxel Engine",               // Window title
-        SDL_WINDOWPOS_CENTERED,       // Centered X position
-        SDL_WINDOWPOS_CENTERED,       // Centered Y position
-        800, 600,                     // Width & Height
-        SDL_WINDOW_OPENGL | SDL_WINDOW_SHOWN // Enable OpenGL rendering
-    );
-
-    if (!window) { // Error handling if window creation fails
-        std::cout << "Window could not be created! SDL_Error: " << SDL_GetError() << std::endl;
-        SDL_Quit();
+    SDL_Window* window = nullptr;       // The window, if not offscreen
+    SDL_GLContext glContext = nullptr;  // The window's OpenGL context
+#ifdef KYBUS_HAVE_EGL
+    OffscreenContext offscreenContext;  // The OpenGL context, if offscreen
+#endif
+
+    if (offscreen) {
+#ifdef KYBUS_HAVE_EGL
+        // --- Create Offscreen Context (the same size as the window) ---
+        if (!offscreenContext.create(800, 600)) {
+            return 1;
+        }
+        std::cout << "Rendering offscreen on " << offscreenContext.getRenderer() << std::endl;
+#else
+        std::cout << "ERROR::MAIN::NO_OFFSCREEN built without EGL" << std::endl;
         return 1;
-    }
+#endif
+    } else {
+        // --- Initialize SDL ---
+        if (SDL_Init(SDL_INIT_VIDEO) < 0) { // Initialize only the video subsystem
+            std::cout << "SDL could not initialize! SDL_Error: " << SDL_GetError() << std::endl;
+            return 1;
+        }
 
-    // --- Create OpenGL Context ---
-    SDL_GLContext glContext = SDL_GL_CreateContext(window);
-    if (!glContext) { // Error handling if context creation fails
-        std::cout << "OpenGL context could not be created! SDL_Error: " << SDL_GetError() << std::endl;
-        SDL_DestroyWindow(window);
-        SDL_Quit();
-        return 1;
-    }
+        // --- Set OpenGL Attributes ---
+        SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 3);  // Use OpenGL 3.3
+        SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 3);
+        SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE); // Use core profile
+
+        // --- Create SDL Window ---
+        window = SDL_CreateWindow(
+            "Voxel Engine",               // Window title
+            SDL_WINDOWPOS_CENTERED,       // Centered X position
+            SDL_WINDOWPOS_CENTERED,       // Centered Y position
+            800, 600,                     // Width & Height
+            SDL_WINDOW_OPENGL | SDL_WINDOW_SHOWN // Enable OpenGL rendering
+        );
+
+        if (!window) { // Error handling if window creation fails
+            std::cout << "Window could not be created! SDL_Error: " << SDL_GetError() << std::endl;
+            SDL_Quit();
+            return 1;
+        }
 
-    // --- Initialize GLEW ---
-    glewExperimental = GL_TRUE; // Allow modern OpenGL extensions
-    if (glewInit() != GLEW_OK) { // Check for errors
-        std::cout << "GLEW could not initialize!" << std::endl;
-        SDL_GL_DeleteContext(glContext);
-        SDL_DestroyWindow(window);
-        SDL_Quit();
-        return 1;
-    }
+        // --- Create OpenGL Context ---
+        glContext = SDL_GL_CreateContext(window);
+        if (!glContext) { // Error handling if context creation fails
+            std::cout << "OpenGL context could not be created! SDL_Error: " << SDL_GetError() << std::endl;
+            SDL_DestroyWindow(window);
+            SDL_Quit();
+            return 1;
+        }
 
-    glEnable(GL_DEPTH_TEST);
+        // --- Initialize GLEW ---
+        glewExperimental = GL_TRUE; // Allow modern OpenGL extensions
+        if (glewInit() != GLEW_OK) { // Check for errors
+            std::cout << "GLEW could not initialize!" << std::endl;
+            SDL_GL_DeleteContext(glContext);
+            SDL_DestroyWindow(window);
+            SDL_Quit();
+            return 1;
+        }
+    }
 
-    // --- Define GLSL Shader Sources ---
-    std::string vertexShaderSource = R"(
-        #version 330 core
-        layout(location = 0) in vec3 aPos; // Vertex position input
+    // Closes the window, if there is one
+    auto closeWindow = [&]() {
+        if (window) {
+            SDL_GL_DeleteContext(glContext);
+            SDL_DestroyWindow(window);
+            SDL_Quit();
+        }
+    };
 
-        uniform mat4 mvp; // Rotation angle uniform
+    // Meshes, shaders and the state cache draw through this (tests use RecordingRenderBackend instead)
+    GLRenderBackend renderBackend;
+    RenderBackend::setCurrent(&renderBackend);
 
-        void main() {
-            gl_Position = mvp * vec4(aPos, 1.0); // Apply transformation
-        }
-    )";
+    glEnable(GL_DEPTH_TEST);
 
-    std::string fragmentShaderSource = R"(
-        #version 330 core
-        out vec4 FragColor; // Output fragment color
+    // --- Load Shaders ---
+    // Sources live in shaders/ next to the executable; compiled binaries are cached between runs
+    ShaderLibrary shaders("shaders");
+    shaders.setBinaryCacheDirectory("shadercache");
+    if (!offscreen) {
+        shaders.enableHotReload(); // Edited shader files are recompiled and swapped in while running
+    }
 
-        void main() {
-            FragColor = vec4(1.0, 0.5, 0.2, 1.0); // Set constant color (orange)
-        }
-    )";
+    // Submit every chunk permutation up front so the driver can compile them in parallel
+    for (uint32_t features = 0; features < (1u << SHADER_FEATURE_COUNT); ++features) {
+        shaders.request("chunk", features);
+    }
+    shaders.finishRequests();
 
-    // --- Compile and Link Shaders ---
-    Shader shader(vertexShaderSource, fragmentShaderSource);
+    Shader* shader = shaders.get("basic", 0);
+    if (!shader) { // Error handling if the shader failed to load or compile
+        closeWindow();
+        return 1;
+    }
 
     // --- Define 2D Quad Geometry (Square) ---
     std::vector<float> vertices = {
@@ -134,66 +210,137 @@ int main(int argc, char* argv[]) {
     Mesh cube(vertices, indices);
 
     glm::mat4 projection = glm::perspective(glm::radians(60.0f), 800.0f / 600.0f, 0.01f, 100.0f);
-    glm::mat4 view = glm::lookAt(
-        glm::vec3(2.0f, 2.0f, 2.0f), // Camera position
-        glm::vec3(0.0f, 0.0f, 0.0f), // Look at origin
-        glm::vec3(0.0f, 1.0f, 0.0f)  // Up vector
-    );
+    glm::mat4 view = glm::mat4(1.0f);
     glm::mat4 model = glm::mat4(1.0f);
 
-    // Camera setup
-    float cameraX = 0.0f, cameraY = 0.0f, cameraZ = -5.0f; // Initial position
+    // World positions use 64-bit chunk coordinates, so everything below stays precise
+    // even when placed millions of blocks from the origin
+    WorldPosition cubePosition;
+    WorldPosition camera = cubePosition;
+    camera += glm::vec3(2.0f, 2.0f, 2.0f); // Initial position, offset from the cube
     float moveSpeed = 0.01f; // Movement speed per frame
 
+    // Measures each render pass on the CPU and the GPU (F3 prints the last frame, F4 saves a trace)
+    GpuProfiler profiler;
+    GLCallCounts frameCalls = {}; // GL state changes of the last frame, printed with F3
+
+    // Opaque draws are queued here and issued sorted by program, then nearest first,
+    // so early depth testing skips hidden fragments
+    DrawList drawList;
+    drawList.setOrder(DRAW_ORDER_FRONT_TO_BACK);
+    drawList.setDepthPrepass(depthPrepass);
+
     // --- Main Rendering Loop ---
     bool running = true;
     SDL_Event event;
     float angle = 0.0f; // Angle for rotation animation
-    const Uint8* keyboardState = SDL_GetKeyboardState(NULL);
+    const Uint8* keyboardState = offscreen ? nullptr : SDL_GetKeyboardState(NULL);
+    int frame = 0; // Frames rendered so far
+    auto benchmarkStart = std::chrono::steady_clock::now();
 
     while (running) {
+        // Offscreen runs render a fixed number of frames, so every run draws the same last frame
+        if (offscreen && frame == benchmarkFrames) {
+            break;
+        }
+
+        profiler.beginFrame();
+
+        // Swap in any shaders edited since the last frame (the old program stays if the edit doesn't compile)
+        shaders.update();
+
         // Handle events (polling input events)
-        while (SDL_PollEvent(&event)) {
+        while (window && SDL_PollEvent(&event)) {
             if (event.type == SDL_QUIT) { // If user closes the window
                 running = false;
+            } else if (event.type == SDL_KEYDOWN && event.key.keysym.scancode == SDL_SCANCODE_F3) {
+                profiler.printLatest();
+                frameCalls.print();
+            } else if (event.type == SDL_KEYDOWN && event.key.keysym.scancode == SDL_SCANCODE_F4) {
+                profiler.writeTrace("frame_trace.json"); // Open in chrome://tracing or Perfetto
             }
         }
 
         // Update camera position based on keyboard input
-        if (keyboardState[SDL_SCANCODE_W])      cameraZ += moveSpeed; // Up arrow
-        if (keyboardState[SDL_SCANCODE_S])      cameraZ -= moveSpeed; // Down arrow
-        if (keyboardState[SDL_SCANCODE_D])      cameraX += moveSpeed; // Right arrow
-        if (keyboardState[SDL_SCANCODE_A])      cameraX -= moveSpeed; // Left arrow
-        if (keyboardState[SDL_SCANCODE_SPACE])  cameraY += moveSpeed; // Space (move forward)
-        if (keyboardState[SDL_SCANCODE_LSHIFT]) cameraY -= moveSpeed; // Left Shift (move back)
+        if (keyboardState) {
+            if (keyboardState[SDL_SCANCODE_W])      camera += glm::vec3(0.0f, 0.0f,  moveSpeed); // Up arrow
+            if (keyboardState[SDL_SCANCODE_S])      camera += glm::vec3(0.0f, 0.0f, -moveSpeed); // Down arrow
+            if (keyboardState[SDL_SCANCODE_D])      camera += glm::vec3( moveSpeed, 0.0f, 0.0f); // Right arrow
+            if (keyboardState[SDL_SCANCODE_A])      camera += glm::vec3(-moveSpeed, 0.0f, 0.0f); // Left arrow
+            if (keyboardState[SDL_SCANCODE_SPACE])  camera += glm::vec3(0.0f,  moveSpeed, 0.0f); // Space (move forward)
+            if (keyboardState[SDL_SCANCODE_LSHIFT]) camera += glm::vec3(0.0f, -moveSpeed, 0.0f); // Left Shift (move back)
+        }
 
-        model = glm::rotate(glm::mat4(1.0f), angle, glm::vec3(0.0f, 1.0f, 0.0f));
-        glm::mat4 mvp = projection * view * model;
+        // Camera-relative rendering: the eye sits at the origin and objects are placed
+        // by their (small, precise) offset from the camera
+        view = glm::lookAt(
+            glm::vec3(0.0f, 0.0f, 0.0f),        // Camera position
+            cubePosition.relativeTo(camera),    // Look at the cube
+            glm::vec3(0.0f, 1.0f, 0.0f)         // Up vector
+        );
+        model = cameraRelativeModel(cubePosition, camera) * glm::rotate(glm::mat4(1.0f), angle, glm::vec3(0.0f, 1.0f, 0.0f));
 
         // --- Render Frame ---
+        profiler.beginPass("scene");
         glClearColor(0.2f, 0.3f, 0.3f, 1.0f); // Set background color (dark teal)
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); // Clear the screen
 
-        // Activate shader program
-        shader.use();
-
-        // Pass rotation angle to shader
-        shader.setMat4("mvp", mvp);
+        // Queue the cube, then draw everything queued; the list activates the shader
+        // and sets its "mvp" uniform per draw
+        drawList.submit(*shader, cube, model);
+        drawList.flush(projection * view);
 
-        // Draw the cube (quad)
-        cube.draw();
+        profiler.endFrame();
+        frameCalls = GLStateCache::takeCounts();
 
         // Swap buffers to display the rendered frame
-        SDL_GL_SwapWindow(window);
+        if (window) {
+            SDL_GL_SwapWindow(window);
+        }
+        ++frame;
 
         // Increment angle for animation (rotates over time)
         angle += 0.0025f;
     }
 
+    int exitCode = 0;
+
+#ifdef KYBUS_HAVE_EGL
+    // --- Report Offscreen Benchmark ---
+    if (offscreen) {
+        // Wait for the last frame, so the time covers all the rendering and not just submission
+        Image image;
+        offscreenContext.readPixels(image);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - benchmarkStart).count();
+        std::cout << "Rendered " << frame << " frames in " << seconds * 1000.0 << " ms ("
+                  << seconds * 1000.0 / frame << " ms/frame)" << std::endl;
+        profiler.printLatest();
+        frameCalls.print();
+
+        if (!outputPath.empty()) {
+            image.writePPM(outputPath);
+        }
+        if (!comparePath.empty()) {
+            Image reference;
+            if (!reference.readPPM(comparePath)) {
+                exitCode = 1;
+            } else {
+                ImageDifference difference = Image::compare(image, reference, compareTolerance);
+                if (!difference.sameSize || difference.differingPixels > 0) {
+                    std::cout << "ERROR::MAIN::IMAGE_MISMATCH " << difference.differingPixels
+                              << " pixels differ (largest difference " << difference.maxChannelDifference << ")"
+                              << std::endl;
+                    exitCode = 1;
+                } else {
+                    std::cout << "Frame matches " << comparePath << std::endl;
+                }
+            }
+        }
+    }
+#endif
+
     // --- Cleanup OpenGL and SDL Resources ---
-    SDL_GL_DeleteContext(glContext);
-    SDL_DestroyWindow(window);
-    SDL_Quit();
+    closeWindow();
 
-    return 0;
+    return exitCode;
 }
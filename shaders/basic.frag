@@ -0,0 +1,6 @@
+#version 330 core
+out vec4 FragColor; // Output fragment color
+
+void main() {
+    FragColor = vec4(1.0, 0.5, 0.2, 1.0); // Set constant color (orange)
+}
@@ -0,0 +1,8 @@
+#version 330 core
+layout(location = 0) in vec3 aPos; // Vertex position input
+
+uniform mat4 mvp; // Model-view-projection matrix
+
+void main() {
+    gl_Position = mvp * vec4(aPos, 1.0); // Apply transformation
+}
@@ -0,0 +1,46 @@
+#version 330 core
+#include "include/chunk_vertex.glsl"
+#include "include/lighting.glsl"
+#include "include/fog.glsl"
+
+in vec2 vUV;
+flat in uint vLayer;
+flat in uint vFace;
+in float vAO;
+in float vViewDistance;
+
+uniform sampler2DArray blockTextures; // One layer per block texture, wrapped with GL_REPEAT
+
+out vec4 FragColor;
+
+void main() {
+    // The texture repeats once per block across greedy-merged quads through GL_REPEAT
+    // (GL's default wrap mode), not fract(): fract() jumps at every block edge, and the
+    // jump in its derivatives picks the smallest mip there, a visible seam
+    vec4 color = texture(blockTextures, vec3(vUV, float(vLayer)));
+
+#ifdef FEATURE_TRANSPARENCY
+    // Blended pass: keep the texture's alpha, but skip fully clear texels
+    if (color.a < 0.01) {
+        discard;
+    }
+#else
+    // Opaque pass: alpha is a cutout mask (leaves, grates)
+    if (color.a < 0.5) {
+        discard;
+    }
+    color.a = 1.0;
+#endif
+
+    color.rgb *= vAO;
+
+#ifdef FEATURE_LIGHTING
+    color.rgb *= directionalLight(faceNormal(vFace));
+#endif
+
+#ifdef FEATURE_FOG
+    color.rgb = applyFog(color.rgb, vViewDistance);
+#endif
+
+    FragColor = color;
+}
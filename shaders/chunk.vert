@@ -0,0 +1,34 @@
+#version 330 core
+#include "include/chunk_vertex.glsl"
+
+layout(location = 0) in uint aPacked; // One packed vertex from ChunkMesher
+
+uniform mat4 mvp;       // Chunk-to-clip transform (camera-relative)
+uniform mat4 modelView; // Chunk-to-view transform, used for fog distance
+
+out vec2 vUV;
+flat out uint vLayer;
+flat out uint vFace;
+out float vAO;
+out float vViewDistance;
+
+void main() {
+    ChunkVertex v = unpackChunkVertex(aPacked);
+    gl_Position = mvp * vec4(v.position, 1.0);
+
+    vUV = faceUV(v.position, v.face, v.rotation);
+    vLayer = v.layer;
+    vFace = v.face;
+
+#ifdef FEATURE_AO
+    vAO = aoFactor(v.ao);
+#else
+    vAO = 1.0;
+#endif
+
+#ifdef FEATURE_FOG
+    vViewDistance = length((modelView * vec4(v.position, 1.0)).xyz);
+#else
+    vViewDistance = 0.0;
+#endif
+}
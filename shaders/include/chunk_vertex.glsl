@@ -0,0 +1,47 @@
+// Unpacks the 32-bit chunk vertices built by ChunkMesher (see ChunkMesher.h for the layout)
+
+struct ChunkVertex {
+    vec3 position;  // Corner position inside the chunk, 0-16
+    uint face;      // BlockFace: +X, -X, +Y, -Y, +Z, -Z
+    uint ao;        // Ambient occlusion level, 0 (dark) to 3 (unoccluded)
+    uint layer;     // Texture array layer
+    uint rotation;  // Texture rotation, in quarter turns
+};
+
+ChunkVertex unpackChunkVertex(uint bits) {
+    ChunkVertex v;
+    v.position = vec3(float(bits & 31u), float((bits >> 5u) & 31u), float((bits >> 10u) & 31u));
+    v.face = (bits >> 15u) & 7u;
+    v.ao = (bits >> 18u) & 3u;
+    v.layer = (bits >> 20u) & 1023u;
+    v.rotation = (bits >> 30u) & 3u;
+    return v;
+}
+
+// Texture coordinates come from the position on the face's plane, one texture per block.
+// Side faces use (horizontal, height) so their textures stand upright.
+vec2 faceUV(vec3 position, uint face, uint rotation) {
+    vec2 uv;
+    if (face == 0u)      uv = vec2(-position.z, position.y);
+    else if (face == 1u) uv = vec2( position.z, position.y);
+    else if (face == 2u) uv = vec2( position.x, position.z);
+    else if (face == 3u) uv = vec2( position.x, -position.z);
+    else if (face == 4u) uv = vec2( position.x, position.y);
+    else                 uv = vec2(-position.x, position.y);
+
+    // Each quarter turn maps (u, v) to (v, -u)
+    for (uint i = 0u; i < rotation; ++i) {
+        uv = vec2(uv.y, -uv.x);
+    }
+    return uv;
+}
+
+vec3 faceNormal(uint face) {
+    float direction = (face & 1u) == 0u ? 1.0 : -1.0;
+    uint axis = face >> 1u;
+    return vec3(axis == 0u ? direction : 0.0, axis == 1u ? direction : 0.0, axis == 2u ? direction : 0.0);
+}
+
+float aoFactor(uint ao) {
+    return 0.4 + 0.2 * float(ao);
+}
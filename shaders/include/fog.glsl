@@ -0,0 +1,9 @@
+// Exponential distance fog
+
+uniform vec3 fogColor;
+uniform float fogDensity;
+
+vec3 applyFog(vec3 color, float distance) {
+    float visibility = exp(-fogDensity * distance);
+    return mix(fogColor, color, clamp(visibility, 0.0, 1.0));
+}
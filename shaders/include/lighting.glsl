@@ -0,0 +1,8 @@
+// Simple directional sunlight with a constant ambient term
+
+uniform vec3 sunDirection;  // Normalized direction towards the sun
+uniform float ambientLight; // Light reaching faces turned away from the sun
+
+float directionalLight(vec3 normal) {
+    return ambientLight + (1.0 - ambientLight) * max(dot(normal, sunDirection), 0.0);
+}
@@ -0,0 +1,43 @@
+#version 330 core
+#include "include/lighting.glsl"
+#include "include/fog.glsl"
+
+in vec3 vRelative;
+in vec3 vNormal;
+
+uniform float voxelDistance; // Distance from the camera (along x or z) the voxel chunks reach
+uniform float blendWidth;    // Band inside it where the height field fades in
+
+out vec4 FragColor;
+
+// 4x4 ordered dither threshold, so the fade needs no blending
+float ditherThreshold(vec2 pixel) {
+    ivec2 p = ivec2(pixel) & 3;
+    int index = p.x + p.y * 4;
+    const float bayer[16] = float[16](0.0, 8.0, 2.0, 10.0, 12.0, 4.0, 14.0, 6.0,
+                                      3.0, 11.0, 1.0, 9.0, 15.0, 7.0, 13.0, 5.0);
+    return (bayer[index] + 0.5) / 16.0;
+}
+
+void main() {
+    // The voxel chunks draw the ground near the camera; fade in across the band at their edge
+    float edgeDistance = max(abs(vRelative.x), abs(vRelative.z));
+    float fade = clamp((edgeDistance - (voxelDistance - blendWidth)) / max(blendWidth, 0.001), 0.0, 1.0);
+    if (fade < ditherThreshold(gl_FragCoord.xy)) {
+        discard;
+    }
+
+    // Grass on gentle slopes, rock on steep ones
+    vec3 normal = normalize(vNormal);
+    vec3 color = mix(vec3(0.45, 0.42, 0.38), vec3(0.30, 0.50, 0.22), smoothstep(0.70, 0.85, normal.y));
+
+#ifdef FEATURE_LIGHTING
+    color *= directionalLight(normal);
+#endif
+
+#ifdef FEATURE_FOG
+    color = applyFog(color, length(vRelative));
+#endif
+
+    FragColor = vec4(color, 1.0);
+}
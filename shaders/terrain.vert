@@ -0,0 +1,46 @@
+#version 330 core
+
+layout(location = 0) in vec3 aPos; // Sample coordinates (x, 0, z) within a clipmap level
+
+uniform mat4 viewProjection;  // Camera-relative world to clip transform
+uniform vec3 levelOrigin;     // The level's lowest sample, relative to the camera
+uniform float spacing;        // Blocks between the level's samples
+uniform sampler2D heights;    // The level's heights, wrapped around the texture
+uniform int textureOriginX;   // The texel holding the level's lowest sample
+uniform int textureOriginZ;
+uniform float morphStart;     // Samples from the camera where vertices start blending into the coarser level
+uniform float morphWidth;     // Samples over which they blend fully
+
+out vec3 vRelative; // Position relative to the camera
+out vec3 vNormal;
+
+float heightAt(ivec2 cell) {
+    int size = textureSize(heights, 0).x;
+    ivec2 texel = (cell + ivec2(textureOriginX, textureOriginZ)) % size;
+    return texelFetch(heights, texel, 0).r;
+}
+
+void main() {
+    ivec2 grid = ivec2(aPos.xz);
+    int last = textureSize(heights, 0).x - 1;
+    vec2 horizontal = levelOrigin.xz + aPos.xz * spacing;
+
+    // Near the window's edge, pull odd vertices onto the line between their even neighbours:
+    // the coarser level's surface, so the two levels meet without cracks
+    float edgeDistance = max(abs(horizontal.x), abs(horizontal.y)) / spacing;
+    float morph = clamp((edgeDistance - morphStart) / morphWidth, 0.0, 1.0);
+    ivec2 odd = grid & 1;
+    float height = heightAt(grid);
+    float coarseHeight = 0.5 * (heightAt(grid - odd) + heightAt(grid + odd));
+    height = mix(height, coarseHeight, morph);
+
+    // Central differences, one-sided at the window's edge
+    ivec2 low = max(grid - 1, ivec2(0));
+    ivec2 high = min(grid + 1, ivec2(last));
+    float slopeX = (heightAt(ivec2(high.x, grid.y)) - heightAt(ivec2(low.x, grid.y))) / (float(high.x - low.x) * spacing);
+    float slopeZ = (heightAt(ivec2(grid.x, high.y)) - heightAt(ivec2(grid.x, low.y))) / (float(high.y - low.y) * spacing);
+    vNormal = normalize(vec3(-slopeX, 1.0, -slopeZ));
+
+    vRelative = vec3(horizontal.x, levelOrigin.y + height, horizontal.y);
+    gl_Position = viewProjection * vec4(vRelative, 1.0);
+}
@@ -0,0 +1,151 @@
+// Checks that rays crossing grids thousands of blocks wide always finish, and that
+// packet and single-ray tracing agree there. Run by CTest; the exit code is nonzero
+// if a check fails, and a traversal that never finishes trips the test's timeout.
+
+// Includes std::abs
+#include <cmath>
+
+// Includes standard I/O for reporting failures
+#include <iostream>
+
+// Includes std::unique_ptr, which owns the test chunks
+#include <memory>
+
+// Includes std::mt19937, the seeded generator for rays and solid chunks
+#include <random>
+
+// Includes the vector container holding the test chunks
+#include <vector>
+
+#include <glm/glm.hpp>                   // GLM for vector types
+
+#include "VoxelRaytracer.h" // The tracer under test
+
+// The grid widths checked, in chunks; the largest fills the grid limit (2^20 chunks)
+static const int GRID_WIDTHS[] = { 256, 1024 };
+
+// The number of random rays traced per grid
+static const int RAY_COUNT = 20000;
+
+// The number of solid chunks scattered over each grid
+static const int SOLID_CHUNKS = 400;
+
+// The largest vertical direction component of a ray; shallow rays cross the most cells
+static const float MAX_SLOPE = 0.02f;
+
+// How far a hit point may lie outside the block reported, in blocks
+static const float HIT_TOLERANCE = 0.01f;
+
+// The number of checks that failed
+static int failures = 0;
+
+/**
+ * Counts and prints a failed check.
+ */
+static void check(bool passed, const char* what, float error) {
+    if (!passed) {
+        std::cout << "RAYTRACE::FAIL " << what << " (error " << error << ")" << std::endl;
+        ++failures;
+    }
+}
+
+/**
+ * Returns how far a point lies outside a unit block, or 0 if it is inside.
+ */
+static float distanceOutside(const glm::vec3& point, const glm::vec3& blockMin) {
+    glm::vec3 outside = glm::max(blockMin - point, point - (blockMin + 1.0f));
+    return glm::max(0.0f, glm::max(outside.x, glm::max(outside.y, outside.z)));
+}
+
+int main() {
+    ThreadPool pool;
+
+    for (int width : GRID_WIDTHS) {
+        // --- A flat grid, one chunk tall, with solid chunks scattered over it ---
+        // The grid starts at a negative chunk, so rays cross the origin too
+        const glm::i64vec3 minChunk(-width / 2, 0, -width / 2);
+        std::mt19937 random(static_cast<uint32_t>(width));
+        std::uniform_int_distribution<int> chunkCoord(0, width - 1);
+        std::vector<std::unique_ptr<Chunk>> solids;
+        ChunkMap<Chunk*> chunks;
+        for (int i = 0; i < SOLID_CHUNKS; ++i) {
+            glm::i64vec3 coord = minChunk + glm::i64vec3(chunkCoord(random), 0, chunkCoord(random));
+            if (chunks.count(ChunkKey(coord)) > 0) {
+                continue;
+            }
+            std::unique_ptr<Chunk> chunk(new Chunk());
+            for (int y = 0; y < CHUNK_SIZE; ++y) {
+                for (int z = 0; z < CHUNK_SIZE; ++z) {
+                    for (int x = 0; x < CHUNK_SIZE; ++x) {
+                        chunk->set(x, y, z, 1);
+                    }
+                }
+            }
+            chunks[ChunkKey(coord)] = chunk.get();
+            solids.push_back(std::move(chunk));
+        }
+
+        VoxelRaytracer tracer(pool);
+        check(tracer.build(chunks, minChunk, glm::ivec3(width, 1, width)), "grid builds", 0.0f);
+
+        // --- Shallow rays in every horizontal direction, from anywhere inside the grid ---
+        const float gridBlocks = float(width * CHUNK_SIZE);
+        std::uniform_real_distribution<float> across(0.0f, gridBlocks);
+        std::uniform_real_distribution<float> height(0.0f, float(CHUNK_SIZE));
+        std::uniform_real_distribution<float> heading(-1.0f, 1.0f);
+        std::uniform_real_distribution<float> slope(-MAX_SLOPE, MAX_SLOPE);
+        int hits = 0;
+        for (int ray = 0; ray < RAY_COUNT; ++ray) {
+            glm::vec3 start(across(random), height(random), across(random));
+            glm::vec3 direction(heading(random), slope(random), heading(random));
+            if (std::abs(direction.x) + std::abs(direction.z) < 0.1f) {
+                continue;
+            }
+            direction = glm::normalize(direction);
+
+            // Sampling exactly on a cell boundary is what used to stall a ray; hit it often
+            if (ray % 2 == 0) {
+                start.x = std::floor(start.x);
+            }
+
+            WorldPosition origin(minChunk, start);
+            RaytraceHit hit;
+            if (!tracer.traceRay(origin, direction, 2.0f * gridBlocks, hit)) {
+                continue;
+            }
+            ++hits;
+
+            // The hit block must be solid, and the ray must reach it at the reported distance
+            glm::i64vec3 chunk = glm::i64vec3(glm::floor(glm::dvec3(hit.position) / double(CHUNK_SIZE)));
+            check(chunks.count(ChunkKey(chunk)) > 0, "a hit block is solid", 0.0f);
+            glm::vec3 blockMin = glm::vec3(hit.position - minChunk * int64_t(CHUNK_SIZE));
+            float error = distanceOutside(start + direction * hit.distance, blockMin);
+            check(error <= HIT_TOLERANCE, "a hit lies on its ray", error);
+        }
+        check(hits > 0, "some rays hit a solid chunk", 0.0f);
+
+        // --- A preview from a far corner, skimming the whole grid ---
+        WorldPosition corner(minChunk, glm::vec3(0.5f, 8.0f, 0.5f));
+        RaytraceCamera camera =
+            RaytraceCamera::perspective(corner, glm::vec3(1.0f, -0.01f, 1.0f), glm::vec3(0.0f, 1.0f, 0.0f), 0.3f);
+        Image packets;
+        Image singles;
+        tracer.setPacketTracing(true);
+        RaytraceStats packetStats = tracer.render(camera, 128, 64, packets);
+        tracer.setPacketTracing(false);
+        tracer.render(camera, 128, 64, singles);
+        ImageDifference difference = Image::compare(packets, singles, 0);
+        check(difference.differingPixels == 0, "packet and single rays agree", float(difference.differingPixels));
+
+        // Every step leaves at least one block behind, so a ray takes at most one per block crossed
+        float stepsPerRay = float(packetStats.steps) / float(packetStats.rays);
+        check(stepsPerRay <= 3.0f * gridBlocks, "steps per ray are bounded by the grid", stepsPerRay);
+    }
+
+    if (failures > 0) {
+        std::cout << "RAYTRACE::FAILED " << failures << " checks" << std::endl;
+        return 1;
+    }
+    std::cout << "Rays cross grids up to " << GRID_WIDTHS[1] * CHUNK_SIZE << " blocks wide" << std::endl;
+    return 0;
+}
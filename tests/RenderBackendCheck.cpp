@@ -0,0 +1,147 @@
+// Checks what `DrawList` sends to a render backend, using `RecordingRenderBackend`
+// so no GPU or context is needed: the draws recorded, the binds the state cache
+// skips, and shaders that fail to compile. Run by CTest; the exit code is nonzero
+// if a check fails.
+
+// Includes standard I/O for reporting failures
+#include <iostream>
+
+// Includes std::unique_ptr, which lets the compile failure be checked for leaks
+#include <memory>
+
+// Includes the vector container for mesh data
+#include <vector>
+
+#include <glm/glm.hpp>                   // GLM for matrix types
+
+#include "DrawList.h"               // The draw queue under test
+#include "GLStateCache.h"           // Counts the binds it elided
+#include "RecordingRenderBackend.h" // Records what would have reached the GPU
+
+// Draws of the same shader and mesh queued in a row, to check the binds between them are skipped
+static const int REPEATED_DRAWS = 10;
+
+// The number of checks that failed
+static int failures = 0;
+
+/**
+ * Counts and prints a failed check.
+ */
+static void check(bool passed, const char* what, float error) {
+    if (!passed) {
+        std::cout << "RENDER_BACKEND::FAIL " << what << " (error " << error << ")" << std::endl;
+        ++failures;
+    }
+}
+
+int main() {
+    RecordingRenderBackend backend;
+    RenderBackend::setCurrent(&backend);
+
+    {
+        const std::vector<float> vertices = { -1.0f, -1.0f, 0.0f, 1.0f, -1.0f, 0.0f, 1.0f, 1.0f, 0.0f };
+        const std::vector<unsigned int> triangle = { 0, 1, 2 };
+        const std::vector<unsigned int> twoTriangles = { 0, 1, 2, 2, 1, 0 };
+        Mesh first(vertices, triangle);
+        Mesh second(vertices, twoTriangles);
+        Shader opaque("vertex", "fragment");
+        Shader other("vertex", "fragment");
+        check(opaque.isValid() && other.isValid(), "shaders compile", 0.0f);
+
+        // --- Draws queued with alternating state come out recorded and grouped by program ---
+        DrawList list;
+        list.submit(opaque, first, glm::mat4(1.0f), GL_TEXTURE_2D_ARRAY, 7);
+        list.submit(other, second, glm::mat4(2.0f), GL_TEXTURE_2D_ARRAY, 8);
+        list.submit(opaque, second, glm::mat4(3.0f), GL_TEXTURE_2D_ARRAY, 7);
+        list.submit(other, first, glm::mat4(4.0f), GL_TEXTURE_2D_ARRAY, 8);
+        backend.clearRecording();
+        list.flush(glm::mat4(1.0f));
+
+        const std::vector<RecordedDraw>& draws = backend.getDraws();
+        check(draws.size() == 4, "every queued draw is recorded", float(draws.size()));
+        check(list.size() == 0, "a flush empties the list", float(list.size()));
+        int programChanges = 0;
+        for (size_t i = 0; i < draws.size(); ++i) {
+            const RecordedDraw& draw = draws[i];
+            const Mesh& mesh = draw.vertexArray == first.getVertexArray() ? first : second;
+            check(draw.vertexArray == first.getVertexArray() || draw.vertexArray == second.getVertexArray(),
+                  "a draw uses a submitted mesh", float(draw.vertexArray));
+            check(draw.count == GLsizei(mesh.getIndexCount()), "a draw covers its mesh's indices", float(draw.count));
+            check(draw.mode == GL_TRIANGLES, "a draw draws triangles", float(draw.mode));
+            check(draw.colorWrites && draw.depthWrites && draw.depthFunc == GL_LESS,
+                  "without a prepass, draws keep GL's default write masks and depth test", 0.0f);
+
+            // Each program keeps the texture it was submitted with
+            GLuint expectedTexture = draw.program == opaque.getProgramID() ? 7 : 8;
+            check(draw.texture == expectedTexture, "a draw has its material bound", float(draw.texture));
+
+            const std::vector<uint8_t>* indices = backend.getBufferData(draw.elementBuffer);
+            check(indices && indices->size() == mesh.getIndexCount() * sizeof(unsigned int),
+                  "a draw's element buffer holds the mesh's indices", indices ? float(indices->size()) : -1.0f);
+
+            if (i > 0 && draw.program != draws[i - 1].program) {
+                ++programChanges;
+            }
+        }
+        check(programChanges == 1, "draws are grouped by program", float(programChanges));
+        check(backend.getCallCount(RENDER_CALL_USE_PROGRAM) == 2, "each program is bound once",
+              float(backend.getCallCount(RENDER_CALL_USE_PROGRAM)));
+
+        // The last draw's model matrix reaches its program's "mvp" uniform
+        const std::vector<float>* mvp = backend.getUniform(draws.back().program, "mvp");
+        bool lastOpaque = draws.back().program == opaque.getProgramID();
+        bool lastFirst = draws.back().vertexArray == first.getVertexArray();
+        float lastScale = lastOpaque ? (lastFirst ? 1.0f : 3.0f) : (lastFirst ? 4.0f : 2.0f);
+        check(mvp && mvp->size() == 16 && (*mvp)[0] == lastScale, "the mvp uniform is set per draw",
+              mvp && !mvp->empty() ? (*mvp)[0] : -1.0f);
+
+        // --- Repeated state is bound once; the cache skips every other bind ---
+        for (int i = 0; i < REPEATED_DRAWS; ++i) {
+            list.submit(opaque, first, glm::mat4(1.0f), GL_TEXTURE_2D_ARRAY, 7);
+        }
+        // Setting the backend again forgets the bindings left by the draws above
+        RenderBackend::setCurrent(&backend);
+        GLStateCache::takeCounts();
+        backend.clearRecording();
+        list.flush(glm::mat4(1.0f));
+
+        GLCallCounts counts = GLStateCache::takeCounts();
+        check(backend.getDraws().size() == REPEATED_DRAWS, "repeated draws are all recorded",
+              float(backend.getDraws().size()));
+        check(backend.getCallCount(RENDER_CALL_USE_PROGRAM) == 1, "a repeated program is bound once",
+              float(backend.getCallCount(RENDER_CALL_USE_PROGRAM)));
+        check(backend.getCallCount(RENDER_CALL_BIND_VERTEX_ARRAY) == 1, "a repeated mesh is bound once",
+              float(backend.getCallCount(RENDER_CALL_BIND_VERTEX_ARRAY)));
+        check(backend.getCallCount(RENDER_CALL_BIND_TEXTURE) == 1, "a repeated material is bound once",
+              float(backend.getCallCount(RENDER_CALL_BIND_TEXTURE)));
+        check(counts.elided[GL_CALL_USE_PROGRAM] == REPEATED_DRAWS - 1, "the cache elides repeated program binds",
+              float(counts.elided[GL_CALL_USE_PROGRAM]));
+        check(counts.elided[GL_CALL_BIND_VERTEX_ARRAY] == REPEATED_DRAWS - 1,
+              "the cache elides repeated vertex array binds", float(counts.elided[GL_CALL_BIND_VERTEX_ARRAY]));
+        check(counts.draws == REPEATED_DRAWS, "the cache counts every draw", float(counts.draws));
+
+        // --- A shader that fails to compile is invalid, draws nothing and leaks nothing ---
+        size_t liveBefore = backend.getLiveObjectCount();
+        backend.setCompileFails(true);
+        std::unique_ptr<Shader> broken(new Shader("vertex", "fragment"));
+        backend.setCompileFails(false);
+        check(!broken->isValid(), "a failed compile leaves the shader invalid", 0.0f);
+        broken.reset();
+        check(backend.getLiveObjectCount() == liveBefore, "a failed shader deletes its objects",
+              float(backend.getLiveObjectCount()) - float(liveBefore));
+
+        Shader recovered("vertex", "fragment");
+        check(recovered.isValid(), "shaders compile again once compiles stop failing", 0.0f);
+    }
+
+    // Every mesh and shader deletes what it created
+    check(backend.getLiveObjectCount() == 0, "no objects outlive their owners", float(backend.getLiveObjectCount()));
+    RenderBackend::setCurrent(nullptr);
+
+    if (failures > 0) {
+        std::cout << "RENDER_BACKEND::FAILED " << failures << " checks" << std::endl;
+        return 1;
+    }
+    std::cout << "Draws, elided binds and compile failures reach the backend as expected" << std::endl;
+    return 0;
+}
@@ -0,0 +1,116 @@
+// Checks that positions 10 million blocks from the origin render and simulate as precisely
+// as positions at the origin. Run by CTest; the exit code is nonzero if a check fails.
+
+// Includes std::abs
+#include <cmath>
+
+// Includes standard I/O for reporting failures
+#include <iostream>
+
+#include <glm/glm.hpp>                   // GLM for vector and matrix types
+
+#include "FloatingOrigin.h" // The physics origin, rebased near the focus
+#include "WorldPosition.h"  // Large-world positions and camera-relative model matrices
+
+// The distance from the origin the checks run at, in blocks
+static const int64_t FAR_DISTANCE = 10000000;
+
+// The error allowed in a camera-relative offset, in blocks (a float near 100 is exact to about 1e-5)
+static const float OFFSET_TOLERANCE = 1e-4f;
+
+// The number of checks that failed
+static int failures = 0;
+
+/**
+ * Counts and prints a failed check.
+ */
+static void check(bool passed, const char* what, float error) {
+    if (!passed) {
+        std::cout << "PRECISION::FAIL " << what << " (error " << error << ")" << std::endl;
+        ++failures;
+    }
+}
+
+/**
+ * Returns the largest component of the difference between two vectors.
+ */
+static float maxDifference(const glm::vec3& a, const glm::vec3& b) {
+    glm::vec3 difference = glm::abs(a - b);
+    return glm::max(difference.x, glm::max(difference.y, difference.z));
+}
+
+int main() {
+    const glm::i64vec3 farBlocks[] = {
+        glm::i64vec3(FAR_DISTANCE, 64, FAR_DISTANCE),
+        glm::i64vec3(-FAR_DISTANCE, -FAR_DISTANCE, 3),
+        glm::i64vec3(FAR_DISTANCE + 7, FAR_DISTANCE - 5, -FAR_DISTANCE - 11)
+    };
+    const glm::vec3 offsets[] = {
+        glm::vec3(0.001f, -0.002f, 0.003f),
+        glm::vec3(0.5f, 0.25f, -0.125f),
+        glm::vec3(15.999f, -16.001f, 31.5f),
+        glm::vec3(-97.3f, 45.61f, 88.02f)
+    };
+
+    for (const glm::i64vec3& block : farBlocks) {
+        WorldPosition camera = WorldPosition::fromBlock(block);
+        camera += glm::vec3(0.37f, 0.81f, 0.13f);
+
+        // --- Camera-relative offsets and model matrices ---
+        for (const glm::vec3& offset : offsets) {
+            WorldPosition object = camera;
+            object += offset;
+
+            float error = maxDifference(object.relativeTo(camera), offset);
+            check(error <= OFFSET_TOLERANCE, "relativeTo at 1e7 blocks", error);
+
+            glm::mat4 model = cameraRelativeModel(object, camera);
+            glm::vec3 corner = glm::vec3(model * glm::vec4(0.5f, 0.5f, 0.5f, 1.0f));
+            error = maxDifference(corner, offset + glm::vec3(0.5f));
+            check(error <= OFFSET_TOLERANCE, "cameraRelativeModel at 1e7 blocks", error);
+        }
+
+        // --- Movement: far away, small steps add up exactly as they do at the origin ---
+        // (from the same offset inside a chunk, the float arithmetic is the same)
+        WorldPosition far = camera;
+        WorldPosition nearStart(glm::i64vec3(0), camera.local);
+        WorldPosition near = nearStart;
+        for (int step = 0; step < 10000; ++step) {
+            glm::vec3 delta(0.0137f, -0.0071f, 0.0029f);
+            far += delta;
+            near += delta;
+        }
+        float error = maxDifference(far.relativeTo(camera), near.relativeTo(nearStart));
+        check(error == 0.0f, "movement at 1e7 blocks matches movement at the origin", error);
+
+        // --- Physics origin rebasing ---
+        FloatingOrigin physicsOrigin(256.0f);
+        glm::vec3 shift;
+        check(physicsOrigin.update(camera, shift), "FloatingOrigin rebases to a far focus", 0.0f);
+        WorldPosition body = camera;
+        body += glm::vec3(3.25f, -1.5f, 0.75f);
+        glm::vec3 physicsPosition = physicsOrigin.toPhysics(body);
+        check(glm::length(physicsPosition) < 64.0f, "physics positions stay small", glm::length(physicsPosition));
+
+        // Walk the focus away until it rebases again; the body must not move in world space
+        WorldPosition focus = camera;
+        for (int step = 0; step < 100; ++step) {
+            focus += glm::vec3(5.0f, 0.0f, -3.0f);
+            if (physicsOrigin.update(focus, shift)) {
+                error = maxDifference(shift, glm::round(shift));
+                check(error == 0.0f, "rebase shift is whole blocks", error);
+                physicsPosition += shift;
+            }
+        }
+        WorldPosition roundTrip = physicsOrigin.fromPhysics(physicsPosition);
+        error = maxDifference(roundTrip.relativeTo(body), glm::vec3(0.0f));
+        check(roundTrip.chunk == body.chunk && error <= OFFSET_TOLERANCE, "body position survives rebasing", error);
+    }
+
+    if (failures > 0) {
+        std::cout << "PRECISION::FAILED " << failures << " checks" << std::endl;
+        return 1;
+    }
+    std::cout << "World precision holds at " << FAR_DISTANCE << " blocks" << std::endl;
+    return 0;
+}